@@ -54,12 +54,12 @@ syn keyword questSpecial version project
 syn keyword questMacro include 
 syn match questNA /N\/A/ contained
 syn keyword questStatus ACTIVE INACTIVE DONE UNREACHABLE PARENT
-syn keyword questHeuristic SIMPLE HSP
-syn keyword questStrategy ASTAR DFS
+syn keyword questHeuristic SIMPLE HSP HADD HMAX FF LANDMARKS PDB
+syn keyword questStrategy ASTAR DFS HDASTAR PORTFOLIO INCREMENTAL BACKWARD BIDIRECTIONAL ANYTIME IDA GBFS EHC GRAPHPLAN SAT BEAM IW BFWS
 syn keyword questKeywordQuest quest
 syn keyword questQuestParam preconditions goal actions objects subquests 
 syn keyword questQuestParam options searchLimit spaceLimit omega status 
-syn keyword questQuestParam heuristic use_atree strategy
+syn keyword questQuestParam heuristic use_atree strategy threads fingerprint_only concurrent_goals pdbMemoryLimit heuristicCacheSize searchGraphSize repairLimit anytimeWeight timeLimitUs idaTableSize beamWidth
 syn keyword questActionBlock pre add rem
 
 
@@ -90,8 +90,7 @@ Result Action::evaluateActionApplicability(
     }
 
     if(doNotCheckPreconditions == false) {
-        const StatementVec preconditions = _pre.substitute(arguments);
-        if(state->hasSubstate(preconditions) == false) {
+        if(_pre.isSubstateOf(*state, arguments) == false) {
             actionError = MOZOK_AE_PRECONDITIONS_ERROR;
             return errorActionPreconditionsFailed(Str("???"), _name);
         }
@@ -111,8 +110,8 @@ Result Action::applyAction(
     if(res.isError())
         return res;
 
-    state->removeStatements(_rem.substitute(arguments));
-    state->addStatements(_add.substitute(arguments));
+    _rem.removeFrom(*state, arguments);
+    _add.addTo(*state, arguments);
     return res;
 }
 
@@ -120,19 +119,15 @@ void Action::applyActionUnsafe(
             const ObjectVec& arguments, 
             StatePtr& state
             ) const noexcept {
-    state->removeStatements(_rem.substitute(arguments));
-    state->addStatements(_add.substitute(arguments));
+    _rem.removeFrom(*state, arguments);
+    _add.addTo(*state, arguments);
 }
 
 bool Action::checkActionPreconditions(
         const ObjectVec& arguments, 
-        const StatePtr& state,
-        StatementVec& preBuffer
+        const StatePtr& state
         ) const noexcept {
-    _pre.substituteFast(preBuffer, arguments);
-    if(state->hasSubstate(preBuffer) == false)
-        return false;
-    return true;
+    return _pre.isSubstateOf(*state, arguments);
 }
 
 }
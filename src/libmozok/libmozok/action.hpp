@@ -134,13 +134,10 @@ public:
     /// may break the quest universe.
     /// @param arguments Argument objects that are fully compatible with the action.
     /// @param state State undergoing the check.
-    /// @param preBuffer A `StatementVec` containing identical relations and 
-    /// constant arguments as those specified in the action's preconditions.
     /// @return Returns `true` when the given state includes the preconditions.
     bool checkActionPreconditions(
             const ObjectVec& arguments, 
-            const StatePtr& state,
-            StatementVec& preBuffer
+            const StatePtr& state
             ) const noexcept;
 
 };
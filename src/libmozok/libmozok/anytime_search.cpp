@@ -0,0 +1,257 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/anytime_search.hpp>
+#include <libmozok/incremental_search.hpp>
+
+#include <algorithm>
+
+namespace mozok {
+
+namespace {
+
+/// @brief The weights of the `ANYTIME` strategy are kept in tenths.
+const int ANYTIME_WEIGHT_SCALE = 10;
+
+/// @brief The weight decrease after every improved plan (in tenths).
+const int ANYTIME_WEIGHT_STEP = 5;
+
+} // namespace
+
+int AnytimeSearchImpl::priority(const SIZE_T nodeIndx) const noexcept {
+    const SearchGraph::Node& node = _graph[nodeIndx];
+    return node.g * ANYTIME_WEIGHT_SCALE + _weight * node.h;
+}
+
+bool AnytimeSearchImpl::isGoal(const SIZE_T nodeIndx) const noexcept {
+    return _graph[nodeIndx].state->hasSubstate(
+            _quest->getGoalMask(SIZE_T(_goalIndx)));
+}
+
+void AnytimeSearchImpl::dropOutdated() noexcept {
+    while(_openSet.size() > 0) {
+        const OpenNode& openNode = _openSet.top();
+        const SearchGraph::Node& node = _graph[openNode.nodeIndx];
+        if(node.isClosed == false && openNode.gScore == node.g)
+            break;
+        _openSet.pop();
+    }
+}
+
+void AnytimeSearchImpl::expand(const SIZE_T nodeIndx) noexcept {
+    // The successors of a node are generated only once.
+    if(_graph[nodeIndx].firstEdge < 0) {
+        const BitStatePtr state = _graph[nodeIndx].state;
+        SearchGraphActionsIterator it(
+                *_quest, _graph, nodeIndx, _heuristic);
+        _quest->iterateOverApplicableActions(*state, it);
+        _graph.setExpanded(nodeIndx);
+    }
+
+    const int gScore = _graph[nodeIndx].g + 1;
+    const int firstEdge = _graph[nodeIndx].firstEdge;
+    const int lastEdge = firstEdge + _graph[nodeIndx].edgeCount;
+    for(int e = firstEdge; e < lastEdge; ++e) {
+        const SearchGraph::Edge& edge = _graph.getEdges()[SIZE_T(e)];
+        const SIZE_T nextIndx = SIZE_T(edge.node);
+        const SearchGraph::Node& next = _graph[nextIndx];
+        if(next.h == HeuristicCalculator::INF)
+            // Goal is unreachable from this state.
+            continue;
+        if(_graph.isReached(nextIndx) && next.g <= gScore)
+            continue;
+        const bool wasClosed = 
+                _graph.isReached(nextIndx) && next.isClosed;
+        _graph.reach(nextIndx, gScore, int(nodeIndx), edge.actionIndx);
+        if(isGoal(nextIndx) && (_bestNode < 0 
+                || gScore < _graph[SIZE_T(_bestNode)].g))
+            _bestNode = int(nextIndx);
+        if(wasClosed)
+            _inconsNodes.push_back(nextIndx);
+        else
+            push(nextIndx);
+    }
+}
+
+void AnytimeSearchImpl::startNextIteration() noexcept {
+    if(_bestNode < 0 || _weight <= ANYTIME_WEIGHT_SCALE) {
+        // Goal is unreachable, or the plan of the unweighted A*.
+        _isFinished = true;
+        return;
+    }
+    _weight = std::max(
+            ANYTIME_WEIGHT_SCALE, _weight - ANYTIME_WEIGHT_STEP);
+
+    Vector<SIZE_T> nodes;
+    nodes.swap(_inconsNodes);
+    for(dropOutdated(); _openSet.size() > 0; dropOutdated()) {
+        nodes.push_back(_openSet.top().nodeIndx);
+        _openSet.pop();
+    }
+    for(const SIZE_T nodeIndx : _closedNodes)
+        _graph[nodeIndx].isClosed = false;
+    _closedNodes.clear();
+
+    // With an admissible heuristic, the optimal plan is not shorter than 
+    // the lowest `g + h` of the open and inconsistent nodes.
+    int lowerBound = HeuristicCalculator::INF;
+    for(const SIZE_T nodeIndx : nodes) {
+        const SearchGraph::Node& node = _graph[nodeIndx];
+        lowerBound = std::min(lowerBound, node.g + node.h);
+        push(nodeIndx);
+    }
+    const bool isAdmissible = 
+            _settings.heuristic == QuestHeuristic::HMAX
+            || _settings.heuristic == QuestHeuristic::PDB;
+    if(isAdmissible && _graph[SIZE_T(_bestNode)].g <= lowerBound)
+        _isFinished = true;
+    _isIterationDone = false;
+}
+
+QuestPlanPtr AnytimeSearchImpl::makePlan() const noexcept {
+    Vector<int> actionIndices;
+    for(int nodeIndx = _bestNode; _graph[SIZE_T(nodeIndx)].parent >= 0; 
+            nodeIndx = _graph[SIZE_T(nodeIndx)].parent)
+        actionIndices.push_back(_graph[SIZE_T(nodeIndx)].actionIndx);
+    std::reverse(actionIndices.begin(), actionIndices.end());
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest, _goalIndx, 
+            MOZOK_QUEST_STATUS_REACHABLE, 
+            makePlanActions(*_quest, actionIndices), actionIndices);
+}
+
+AnytimeSearchImpl::AnytimeSearchImpl(
+        const ID givenSubstateId,
+        const StatePtr& givenState,
+        const BitStatePtr& givenBitState,
+        const QuestManagerPtr& questManager,
+        const ID goalIndx,
+        const QuestSettings& settings
+        ) noexcept :
+    _givenSubstateId(givenSubstateId),
+    _givenState(givenState),
+    _quest(questManager->getQuest()),
+    _goalIndx(goalIndx),
+    _settings(settings),
+    _heuristic(
+            _quest, goalIndx, _settings, 
+            questManager->getLandmarks(goalIndx),
+            questManager->getPatternDatabase(goalIndx),
+            nullptr),
+    _graph(settings.fingerprintOnly),
+    _cmpObj(&openNodeCmp_AStar),
+    _openSet(_cmpObj),
+    _weight(std::max(1, settings.anytimeWeight) * ANYTIME_WEIGHT_SCALE),
+    _bestNode(-1),
+    _publishedLength(HeuristicCalculator::INF),
+    _isIterationDone(false),
+    _isFinished(false),
+    _isSpaceLimitReached(false),
+    _isTimeLimitReached(false) {
+    const SIZE_T startIndx = SIZE_T(_graph.add(
+            givenBitState, _heuristic.calculate(givenBitState)));
+    _graph.startSearch();
+    _graph.reach(startIndx, 0, -1, -1);
+    if(_graph[startIndx].h != HeuristicCalculator::INF)
+        push(startIndx);
+}
+
+QuestPlanPtr AnytimeSearchImpl::improvePlan(
+        const int stepLimit, 
+        const PlanningDeadline& deadline
+        ) noexcept {
+    _isTimeLimitReached = false;
+    int searchStep = 0;
+    while(_isFinished == false) {
+        if(_isIterationDone) {
+            startNextIteration();
+            continue;
+        }
+        dropOutdated();
+        // The iteration ends when no open node can lead to a shorter 
+        // plan under the current weight.
+        if(_openSet.size() == 0 || (_bestNode >= 0 
+                && _graph[SIZE_T(_bestNode)].g * ANYTIME_WEIGHT_SCALE 
+                    <= _openSet.top().fScore)) {
+            _isIterationDone = true;
+            if(_bestNode >= 0 
+                    && _graph[SIZE_T(_bestNode)].g < _publishedLength) {
+                _publishedLength = _graph[SIZE_T(_bestNode)].g;
+                // The plan of the unweighted A* is optimal.
+                if(_weight <= ANYTIME_WEIGHT_SCALE)
+                    _isFinished = true;
+                return makePlan();
+            }
+            continue;
+        }
+
+        ++searchStep;
+        if(searchStep > stepLimit)
+            // Continued by the next call.
+            return nullptr;
+        if(deadline.isReached(searchStep)) {
+            _isTimeLimitReached = true;
+            return nullptr;
+        }
+        if(int(_openSet.size()) > _settings.spaceLimit) {
+            _isSpaceLimitReached = true;
+            _isFinished = true;
+            return nullptr;
+        }
+
+        const SIZE_T nodeIndx = _openSet.top().nodeIndx;
+        _openSet.pop();
+        _graph[nodeIndx].isClosed = true;
+        _closedNodes.push_back(nodeIndx);
+        if(isGoal(nodeIndx) == false)
+            expand(nodeIndx);
+    }
+    return nullptr;
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_Anytime(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const SharedPtr<AnytimeSearchImpl> search = makeShared<AnytimeSearchImpl>(
+            _givenSubstateId, _givenState, _givenBitState, _quest, goalIndx, 
+            settings);
+
+    // The goals of the `ANYTIME` strategy are never searched concurrently 
+    // (see `findQuestPlan()`), so the flag is checked only once.
+    if(cancelFlag != nullptr && cancelFlag->isCancelled())
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+    const QuestPlanPtr plan = 
+            search->improvePlan(settings.searchLimit, _deadline);
+
+    if(plan != nullptr) {
+        // The next planning calls will improve the plan.
+        if(search->isFinished() == false)
+            _quest->setAnytimeSearch(search);
+        return plan;
+    }
+    if(search->isFinished() && search->isSpaceLimitReached() == false)
+        // Goal is unreachable.
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+
+    if(search->isSpaceLimitReached())
+        messageProcessor.onSpaceLimitReached(
+                worldName, _quest->getQuest()->getName(), settings.spaceLimit);
+    else if(search->isTimeLimitReached())
+        messageProcessor.onTimeLimitReached(
+                worldName, _quest->getQuest()->getName(), settings.timeLimitUs);
+    else
+        messageProcessor.onSearchLimitReached(
+                worldName, _quest->getQuest()->getName(), settings.searchLimit);
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+}
+
+}
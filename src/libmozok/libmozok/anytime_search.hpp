@@ -0,0 +1,113 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/state.hpp>
+#include <libmozok/bit_state.hpp>
+#include <libmozok/quest_manager.hpp>
+#include <libmozok/quest_planner.hpp>
+#include <libmozok/search_graph.hpp>
+#include <libmozok/search_node.hpp>
+#include <libmozok/heuristic_calculator.hpp>
+
+namespace mozok {
+
+/// @brief Anytime repairing A* (ARA*) over the state graph of a quest goal.
+/// Every iteration is a weighted A* with `f = g + weight * h`, that expands 
+/// each state at most once. States that get a cheaper path after they were 
+/// expanded are kept in the inconsistent list, and when the iteration ends, 
+/// the next one starts with a lower weight from the open and inconsistent 
+/// states, instead of searching from scratch. The plan of an iteration is 
+/// at most `weight` times longer than the optimal one.
+/// The open list is lazy: an entry is outdated if its node was expanded or 
+/// has a cheaper path since the entry was pushed.
+class AnytimeSearchImpl : public AnytimeSearch {
+    const ID _givenSubstateId;
+    const StatePtr _givenState;
+    const QuestPtr _quest;
+    const ID _goalIndx;
+    const QuestSettings _settings;
+    HeuristicCalculator _heuristic;
+
+    /// @brief All the states visited by the search. A single graph search 
+    ///        is used by all the iterations.
+    SearchGraph _graph;
+    OpenNodeCmp _cmpObj;
+    OpenNodeQueue _openSet;
+
+    /// @brief Expanded nodes of the current iteration.
+    Vector<SIZE_T> _closedNodes;
+
+    /// @brief Expanded nodes of the current iteration that got a cheaper 
+    ///        path after their expansion.
+    Vector<SIZE_T> _inconsNodes;
+
+    /// @brief The weight of the current iteration (in tenths).
+    int _weight;
+
+    /// @brief The goal node with the shortest known path, or `-1`.
+    int _bestNode;
+
+    /// @brief The length of the last returned plan.
+    int _publishedLength;
+
+    bool _isIterationDone;
+    bool _isFinished;
+    bool _isSpaceLimitReached;
+
+    /// @brief `true` if the last `improvePlan()` call was paused by the 
+    ///        deadline.
+    bool _isTimeLimitReached;
+
+    int priority(const SIZE_T nodeIndx) const noexcept;
+
+    void push(const SIZE_T nodeIndx) noexcept {
+        _openSet.push({priority(nodeIndx), _graph[nodeIndx].g, nodeIndx});
+    }
+
+    bool isGoal(const SIZE_T nodeIndx) const noexcept;
+
+    /// @brief Pops the outdated entries from the top of the open list.
+    void dropOutdated() noexcept;
+
+    void expand(const SIZE_T nodeIndx) noexcept;
+
+    /// @brief Lowers the weight and moves the inconsistent nodes into the 
+    ///        open list. Finishes the search if the best plan is optimal.
+    void startNextIteration() noexcept;
+
+    QuestPlanPtr makePlan() const noexcept;
+
+public:
+    AnytimeSearchImpl(
+            const ID givenSubstateId,
+            const StatePtr& givenState,
+            const BitStatePtr& givenBitState,
+            const QuestManagerPtr& questManager,
+            const ID goalIndx,
+            const QuestSettings& settings
+            ) noexcept;
+
+    QuestPlanPtr improvePlan(
+            const int stepLimit, 
+            const PlanningDeadline& deadline
+            ) noexcept override;
+
+    bool isFinished() const noexcept override {
+        return _isFinished;
+    }
+
+    bool isSpaceLimitReached() const noexcept {
+        return _isSpaceLimitReached;
+    }
+
+    bool isTimeLimitReached() const noexcept {
+        return _isTimeLimitReached;
+    }
+};
+
+}
@@ -0,0 +1,189 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/beam_search.hpp>
+#include <libmozok/quest_planner.hpp>
+
+#include <algorithm>
+
+namespace mozok {
+
+BeamActionsIterator::BeamActionsIterator(
+        const Quest& quest,
+        const BitStatePtr& state,
+        const int parent,
+        const QuestSettings& settings,
+        HeuristicCalculator& heuristic,
+        KnownStates& keptStates,
+        KnownStates& layerStates,
+        Vector<BeamCandidate>& candidates
+        ) noexcept :
+    _quest(quest),
+    _state(state),
+    _parent(parent),
+    _settings(settings),
+    _heuristic(heuristic),
+    _keptStates(keptStates),
+    _layerStates(layerStates),
+    _candidates(candidates)
+{ /* empty */ }
+
+bool BeamActionsIterator::possibleActionCallback(
+        const SIZE_T possibleActionIndx) noexcept {
+    const BitState::Word* remMask = 
+            _quest.getActionRemMask(possibleActionIndx);
+    const BitState::Word* addMask = 
+            _quest.getActionAddMask(possibleActionIndx);
+    const Fingerprint fingerprint = _state->getAppliedFingerprint(
+            remMask, addMask, _quest.getStatementKeys());
+    if(_keptStates.findApplied(
+            *_state, remMask, addMask, fingerprint) != nullptr)
+        return true;
+    if(_layerStates.findApplied(
+            *_state, remMask, addMask, fingerprint) != nullptr)
+        return true;
+
+    BitStatePtr newState = makeShared<BitState>(*_state);
+    newState->apply(remMask, addMask, _quest.getStatementKeys());
+    _layerStates.insert(newState, true);
+
+    // The landmark sets of the dropped successors would be kept by the 
+    // LANDMARKS heuristic, so only the landmarks of the state are used.
+    int landmarks = -1;
+    const int h_value = _settings.heuristic == QuestHeuristic::LANDMARKS
+            ? _heuristic.calculate(newState)
+            : _heuristic.calculate(newState, -1, landmarks);
+    if(h_value == HeuristicCalculator::INF)
+        return true;
+
+    _candidates.push_back(
+            {h_value, _parent, int(possibleActionIndx), newState});
+    return true;
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_Beam(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const BitState& goalMask = quest.getGoalMask(SIZE_T(goalIndx));
+    const SIZE_T beamWidth = SIZE_T(std::max(settings.beamWidth, 1));
+
+    HeuristicCalculator heuristic(
+            _quest->getQuest(), goalIndx, settings, 
+            _quest->getLandmarks(goalIndx), 
+            _quest->getPatternDatabase(goalIndx),
+            _quest->getHeuristicCache(goalIndx));
+    if(heuristic.calculate(_givenBitState) == HeuristicCalculator::INF)
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+
+    // `layers[d]` are the nodes kept at the depth `d`, and `beam` are the 
+    // states of the last depth.
+    Vector<Vector<BeamLink>> layers;
+    layers.push_back({{-1, -1}});
+    Vector<BitStatePtr> beam = {_givenBitState};
+    KnownStates keptStates(settings.fingerprintOnly);
+    keptStates.insert(_givenBitState, true);
+
+    Vector<BeamCandidate> candidates;
+    int finalCandidate = -1;
+    bool isPruned = false;
+    int searchStep = 0;
+
+    while(beam.empty() == false) {
+        // Generate the next depth from all the nodes of the beam.
+        KnownStates layerStates(settings.fingerprintOnly);
+        candidates.clear();
+        for(SIZE_T nodeIndx = 0; nodeIndx < beam.size(); ++nodeIndx) {
+            if(cancelFlag != nullptr && cancelFlag->isCancelled())
+                // The result of this search is no longer needed.
+                return makeShared<QuestPlan>(
+                        _givenSubstateId, _givenState, _quest->getQuest(), 
+                        goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+
+            ++searchStep;
+            const bool isSearchLimitReached = 
+                    searchStep > settings.searchLimit;
+            const bool isTimeLimitReached = _deadline.isReached(searchStep);
+            if(isSearchLimitReached || isTimeLimitReached) {
+                if(isSearchLimitReached)
+                    messageProcessor.onSearchLimitReached(
+                        worldName, _quest->getQuest()->getName(), 
+                        settings.searchLimit);
+                if(isTimeLimitReached)
+                    messageProcessor.onTimeLimitReached(
+                        worldName, _quest->getQuest()->getName(), 
+                        settings.timeLimitUs);
+                return makeShared<QuestPlan>(
+                        _givenSubstateId, _givenState, _quest->getQuest(), 
+                        goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+            }
+
+            const SIZE_T firstCandidate = candidates.size();
+            BeamActionsIterator it(
+                    quest, beam[nodeIndx], int(nodeIndx), settings, heuristic, 
+                    keptStates, layerStates, candidates);
+            quest.iterateOverApplicableActions(*beam[nodeIndx], it);
+            for(SIZE_T i = firstCandidate; i < candidates.size(); ++i)
+                if(candidates[i].state->hasSubstate(goalMask)) {
+                    finalCandidate = int(i);
+                    break;
+                }
+            if(finalCandidate >= 0)
+                break;
+        }
+        if(finalCandidate >= 0)
+            break;
+
+        // Keep the best successors. Equal `h()` values keep the order of the 
+        // generation, so the search is deterministic.
+        if(candidates.size() > beamWidth) {
+            isPruned = true;
+            std::stable_sort(candidates.begin(), candidates.end(), 
+                    [](const BeamCandidate& a, const BeamCandidate& b) {
+                return a.hScore < b.hScore;
+            });
+            candidates.resize(beamWidth);
+        }
+        layers.emplace_back();
+        beam.clear();
+        for(const BeamCandidate& candidate : candidates) {
+            layers.back().push_back({candidate.parent, candidate.actionIndx});
+            beam.push_back(candidate.state);
+            keptStates.insert(candidate.state, true);
+        }
+    }
+
+    if(finalCandidate < 0) {
+        if(isPruned)
+            // The dropped successors might lead to the goal.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+        // Nothing was dropped, so all the reachable states were visited.
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+    }
+
+    // Follow the parents back to the initial node.
+    Vector<int> actionIndices(layers.size(), -1);
+    const BeamCandidate& last = candidates[SIZE_T(finalCandidate)];
+    actionIndices.back() = last.actionIndx;
+    int parent = last.parent;
+    for(SIZE_T depth = layers.size() - 1; depth > 0; --depth) {
+        const BeamLink& link = layers[depth][SIZE_T(parent)];
+        actionIndices[depth - 1] = link.actionIndx;
+        parent = link.parent;
+    }
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_REACHABLE, 
+            makePlanActions(quest, actionIndices), actionIndices);
+}
+
+}
@@ -0,0 +1,77 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+#include <libmozok/quest_manager.hpp>
+#include <libmozok/search_node.hpp>
+#include <libmozok/heuristic_calculator.hpp>
+
+namespace mozok {
+
+/// @brief A node kept by the `BEAM` search. The nodes of the previous depths 
+///        keep only the link to their parents, which is enough to rebuild 
+///        the plan. Their states are not freed: all the kept states of all 
+///        depths (`O(k * depth)`) stay in the set of the known states, used 
+///        to detect the duplicates.
+struct BeamLink {
+    /// @brief Index of the parent node at the previous depth (`-1` for the 
+    ///     initial node).
+    int parent;
+
+    /// @brief Index of the possible action that leads to this node 
+    ///     (`-1` for the initial node).
+    int actionIndx;
+};
+
+/// @brief A successor generated at the next depth of the `BEAM` search.
+struct BeamCandidate {
+    /// @brief The `h()` value of the successor.
+    int hScore;
+
+    /// @brief Index of the parent node at the current depth.
+    int parent;
+
+    /// @brief Index of the possible action that leads to the successor.
+    int actionIndx;
+
+    /// @brief The state of the successor.
+    BitStatePtr state;
+};
+
+/// @brief A callback class for the `Quest::iterateOverApplicableActions(...)`.
+/// Generates the successors of a node of the `BEAM` search. Successors whose 
+/// states are already kept, or already generated at the next depth, are 
+/// skipped.
+class BeamActionsIterator : public QuestPossibleActionsIterator {
+    const Quest& _quest;
+    const BitStatePtr _state;
+    const int _parent;
+    const QuestSettings& _settings;
+    HeuristicCalculator& _heuristic;
+    /// @brief The states kept by the search so far.
+    KnownStates& _keptStates;
+    /// @brief The states of the candidates of the next depth.
+    KnownStates& _layerStates;
+    Vector<BeamCandidate>& _candidates;
+
+public:
+    BeamActionsIterator(
+            const Quest& quest,
+            const BitStatePtr& state,
+            const int parent,
+            const QuestSettings& settings,
+            HeuristicCalculator& heuristic,
+            KnownStates& keptStates,
+            KnownStates& layerStates,
+            Vector<BeamCandidate>& candidates
+            ) noexcept;
+
+    bool possibleActionCallback(const SIZE_T possibleActionIndx) noexcept;
+};
+
+}
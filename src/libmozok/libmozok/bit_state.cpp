@@ -0,0 +1,198 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/bit_state.hpp>
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace mozok {
+
+SIZE_T BitState::getWordCount(const SIZE_T bitCount) noexcept {
+    return (bitCount + WORD_BITS - 1) / WORD_BITS;
+}
+
+int BitState::countTrailingZeros(Word word) noexcept {
+    #if defined(_MSC_VER)
+    unsigned long indx;
+    _BitScanForward64(&indx, word);
+    return int(indx);
+    #else
+    return __builtin_ctzll(word);
+    #endif
+}
+
+bool BitState::isSubset(
+        const Word* a,
+        const Word* b,
+        const SIZE_T wordCount
+        ) noexcept {
+    SIZE_T w = 0;
+    #if defined(__AVX2__)
+    for(; w + 4 <= wordCount; w += 4) {
+        const __m256i va = _mm256_loadu_si256((const __m256i*)(a + w));
+        const __m256i vb = _mm256_loadu_si256((const __m256i*)(b + w));
+        // testc(vb, va) == 1 <=> (~vb & va) == 0
+        if(_mm256_testc_si256(vb, va) == 0)
+            return false;
+    }
+    #endif
+    for(; w < wordCount; ++w)
+        if((a[w] & ~b[w]) != 0)
+            return false;
+    return true;
+}
+
+BitState::BitState(const SIZE_T bitCount) noexcept :
+    _words(getWordCount(bitCount), Word(0)),
+    _fingerprint({0, 0})
+{ /* empty */ }
+
+const BitState::Word* BitState::getWords() const noexcept {
+    return _words.data();
+}
+
+SIZE_T BitState::getWordCount() const noexcept {
+    return _words.size();
+}
+
+std::size_t BitState::getHash() const noexcept {
+    return std::size_t(_fingerprint.lo);
+}
+
+const Fingerprint& BitState::getFingerprint() const noexcept {
+    return _fingerprint;
+}
+
+bool BitState::hasBit(const SIZE_T bitIndx) const noexcept {
+    return (_words[bitIndx / WORD_BITS] >> (bitIndx % WORD_BITS)) & Word(1);
+}
+
+void BitState::setBit(
+        const SIZE_T bitIndx,
+        const Vector<Fingerprint>& bitKeys
+        ) noexcept {
+    if(hasBit(bitIndx))
+        return;
+    _words[bitIndx / WORD_BITS] |= Word(1) << (bitIndx % WORD_BITS);
+    _fingerprint ^= bitKeys[bitIndx];
+}
+
+bool BitState::hasSubstate(const Word* mask) const noexcept {
+    return isSubset(mask, _words.data(), _words.size());
+}
+
+bool BitState::hasSubstate(const BitState& mask) const noexcept {
+    return isSubset(mask._words.data(), _words.data(), _words.size());
+}
+
+Fingerprint BitState::updateFingerprint(
+        Fingerprint fingerprint,
+        const Word* changed,
+        const SIZE_T firstWord,
+        const SIZE_T wordCount,
+        const Vector<Fingerprint>& bitKeys
+        ) noexcept {
+    for(SIZE_T w = 0; w < wordCount; ++w)
+        for(Word word = changed[w]; word != 0; word &= word - 1)
+            fingerprint ^= bitKeys[(firstWord + w) * WORD_BITS
+                    + SIZE_T(countTrailingZeros(word))];
+    return fingerprint;
+}
+
+void BitState::apply(
+        const Word* remMask,
+        const Word* addMask,
+        const Vector<Fingerprint>& bitKeys
+        ) noexcept {
+    Word* words = _words.data();
+    const SIZE_T wordCount = _words.size();
+    SIZE_T w = 0;
+    #if defined(__AVX2__)
+    for(; w + 4 <= wordCount; w += 4) {
+        const __m256i vs = _mm256_loadu_si256((const __m256i*)(words + w));
+        const __m256i vr = _mm256_loadu_si256((const __m256i*)(remMask + w));
+        const __m256i va = _mm256_loadu_si256((const __m256i*)(addMask + w));
+        const __m256i vn = _mm256_or_si256(_mm256_andnot_si256(vr, vs), va);
+        const __m256i vc = _mm256_xor_si256(vs, vn);
+        if(_mm256_testz_si256(vc, vc))
+            continue;
+        Word changed[4];
+        _mm256_storeu_si256((__m256i*)changed, vc);
+        _mm256_storeu_si256((__m256i*)(words + w), vn);
+        _fingerprint = updateFingerprint(_fingerprint, changed, w, 4, bitKeys);
+    }
+    #endif
+    for(; w < wordCount; ++w) {
+        const Word newWord = (words[w] & ~remMask[w]) | addMask[w];
+        const Word changed = words[w] ^ newWord;
+        if(changed == 0)
+            continue;
+        words[w] = newWord;
+        _fingerprint = updateFingerprint(_fingerprint, &changed, w, 1, bitKeys);
+    }
+}
+
+Fingerprint BitState::getAppliedFingerprint(
+        const Word* remMask,
+        const Word* addMask,
+        const Vector<Fingerprint>& bitKeys
+        ) const noexcept {
+    const Word* words = _words.data();
+    const SIZE_T wordCount = _words.size();
+    Fingerprint fingerprint = _fingerprint;
+    for(SIZE_T w = 0; w < wordCount; ++w) {
+        if((remMask[w] | addMask[w]) == 0)
+            continue;
+        const Word changed = words[w] ^ ((words[w] & ~remMask[w]) | addMask[w]);
+        if(changed != 0)
+            fingerprint = updateFingerprint(
+                    fingerprint, &changed, w, 1, bitKeys);
+    }
+    return fingerprint;
+}
+
+bool BitState::isEqualApplied(
+        const BitState& other,
+        const Word* remMask,
+        const Word* addMask
+        ) const noexcept {
+    const Word* words = _words.data();
+    const Word* otherWords = other._words.data();
+    const SIZE_T wordCount = _words.size();
+    for(SIZE_T w = 0; w < wordCount; ++w)
+        if(((words[w] & ~remMask[w]) | addMask[w]) != otherWords[w])
+            return false;
+    return true;
+}
+
+void BitState::addUnhashed(const Word* mask) noexcept {
+    Word* words = _words.data();
+    const SIZE_T wordCount = _words.size();
+    SIZE_T w = 0;
+    #if defined(__AVX2__)
+    for(; w + 4 <= wordCount; w += 4) {
+        const __m256i vs = _mm256_loadu_si256((const __m256i*)(words + w));
+        const __m256i vm = _mm256_loadu_si256((const __m256i*)(mask + w));
+        _mm256_storeu_si256((__m256i*)(words + w), _mm256_or_si256(vs, vm));
+    }
+    #endif
+    for(; w < wordCount; ++w)
+        words[w] |= mask[w];
+}
+
+bool BitState::isEqual(const BitState& other) const noexcept {
+    if(_words.size() != other._words.size())
+        return false;
+    return std::memcmp(
+            _words.data(), other._words.data(),
+            _words.size() * sizeof(Word)) == 0;
+}
+
+}
@@ -0,0 +1,276 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+#include <libmozok/statement_table.hpp>
+
+#include <cstdint>
+#include <utility>
+
+#ifdef MOZOK_OUTPUT_HASH_COLLISIONS_INFO
+#include <cstdio>
+#endif
+
+namespace mozok {
+
+class BitState;
+using BitStatePtr = SharedPtr<BitState>;
+
+
+/// @brief A dense representation of a quest state, used during planning.
+/// Every statement relevant to the quest has a dense index (see
+/// `Quest::getStatementIndx()`), and the state is a fixed-width bitset where
+/// the i-th bit is set if the i-th statement is present. All the masks
+/// (preconditions, goals, etc.) are bitsets of the same width, so the subset
+/// tests and the action applications are word-wise operations. If the
+/// library is compiled with AVX2 support, 256-bit instructions are used.
+class BitState {
+public:
+    using Word = std::uint64_t;
+    static const SIZE_T WORD_BITS = 64;
+
+    /// @brief Returns the number of words required to store `bitCount` bits.
+    static SIZE_T getWordCount(const SIZE_T bitCount) noexcept;
+
+    /// @brief Checks if `a` is a subset of `b` (`(a & ~b) == 0`).
+    /// @param a The first mask.
+    /// @param b The second mask.
+    /// @param wordCount The number of words in both masks.
+    static bool isSubset(
+            const Word* a, const Word* b, const SIZE_T wordCount) noexcept;
+
+    /// @brief Calls `f(bitIndx)` for every set bit of the mask.
+    template<typename F>
+    static void forEachBit(
+            const Word* mask, const SIZE_T wordCount, F f) noexcept {
+        for(SIZE_T w = 0; w < wordCount; ++w)
+            for(Word word = mask[w]; word != 0; word &= word - 1)
+                f(w * WORD_BITS + SIZE_T(countTrailingZeros(word)));
+    }
+
+    /// @brief Returns the index of the lowest set bit (`word` must not be 0).
+    static int countTrailingZeros(Word word) noexcept;
+
+private:
+    /// @brief State bits.
+    Vector<Word> _words;
+
+    /// @brief State's fingerprint. The same "XOR-linear" hash as in `State`:
+    ///        XOR of the Zobrist keys of all present statements.
+    Fingerprint _fingerprint;
+
+    /// @brief Returns `fingerprint` updated for all the bits that are set 
+    ///        in `changed`.
+    static Fingerprint updateFingerprint(
+            Fingerprint fingerprint,
+            const Word* changed,
+            const SIZE_T firstWord,
+            const SIZE_T wordCount,
+            const Vector<Fingerprint>& bitKeys
+            ) noexcept;
+
+public:
+    /// @brief Creates an empty state with the given number of bits.
+    BitState(const SIZE_T bitCount) noexcept;
+
+    const Word* getWords() const noexcept;
+    SIZE_T getWordCount() const noexcept;
+    std::size_t getHash() const noexcept;
+    const Fingerprint& getFingerprint() const noexcept;
+
+    /// @brief Checks if the given bit is set.
+    bool hasBit(const SIZE_T bitIndx) const noexcept;
+
+    /// @brief Sets the given bit and updates the fingerprint.
+    /// @param bitIndx Bit (statement) index.
+    /// @param bitKeys Zobrist keys of the statements.
+    void setBit(
+            const SIZE_T bitIndx,
+            const Vector<Fingerprint>& bitKeys) noexcept;
+
+    /// @brief Checks if this state contains all the bits from the mask.
+    /// @param mask A mask of the same width.
+    bool hasSubstate(const Word* mask) const noexcept;
+
+    /// @brief Checks if this state contains all the bits from the mask.
+    /// @param mask A mask of the same width.
+    bool hasSubstate(const BitState& mask) const noexcept;
+
+    /// @brief Applies an action: `state = (state & ~remMask) | addMask`.
+    /// Automatically calculates the new fingerprint.
+    /// @param remMask The mask of the removed statements.
+    /// @param addMask The mask of the added statements.
+    /// @param bitKeys Zobrist keys of the statements.
+    void apply(
+            const Word* remMask,
+            const Word* addMask,
+            const Vector<Fingerprint>& bitKeys
+            ) noexcept;
+
+    /// @brief Returns the fingerprint of the state that `apply()` would 
+    ///        produce, without modifying or copying this state.
+    /// @param remMask The mask of the removed statements.
+    /// @param addMask The mask of the added statements.
+    /// @param bitKeys Zobrist keys of the statements.
+    Fingerprint getAppliedFingerprint(
+            const Word* remMask,
+            const Word* addMask,
+            const Vector<Fingerprint>& bitKeys
+            ) const noexcept;
+
+    /// @brief Checks if `other` is equal to the state that `apply()` would 
+    ///        produce, without modifying or copying this state.
+    bool isEqualApplied(
+            const BitState& other,
+            const Word* remMask,
+            const Word* addMask
+            ) const noexcept;
+
+    /// @brief Adds all the bits from the mask (`state |= mask`).
+    /// Doesn't update the fingerprint (used for relaxed states).
+    void addUnhashed(const Word* mask) noexcept;
+
+    /// @brief Checks if both states have identical bits.
+    bool isEqual(const BitState& other) const noexcept;
+};
+
+
+/// @brief A hash map with `BitState` keys, used as the closed list by the 
+/// searches. A successor state can be looked up by its parent state and the 
+/// action masks (see `findApplied`), so the duplicate successors are detected 
+/// before they are materialized.
+/// States are compared by their 128-bit fingerprints first. In the 
+/// fingerprint-only mode, states with equal fingerprints are considered equal 
+/// without comparing their bits.
+template<typename T>
+class BitStateMap {
+    struct Slot {
+        Fingerprint fingerprint;
+        BitStatePtr state; // `nullptr` for empty slots
+        T value;
+    };
+
+    /// @brief Open-addressing table. The size is always a power of two.
+    Vector<Slot> _slots;
+    SIZE_T _size;
+    const bool _fingerprintOnly;
+
+    #ifdef MOZOK_OUTPUT_HASH_COLLISIONS_INFO
+    /// @brief Collision statistics.
+    SIZE_T _lookups = 0;
+    SIZE_T _hashCollisions = 0;
+    SIZE_T _fingerprintCollisions = 0;
+    #endif
+
+    /// @brief Returns the value of the slot with the given fingerprint 
+    ///        whose state satisfies `isEqual`, or `nullptr`.
+    template<typename F>
+    T* findSlot(const Fingerprint& fingerprint, F isEqual) noexcept {
+        #ifdef MOZOK_OUTPUT_HASH_COLLISIONS_INFO
+        ++_lookups;
+        #endif
+        const SIZE_T mask = _slots.size() - 1;
+        for(SIZE_T i = SIZE_T(fingerprint.lo) & mask; ; i = (i + 1) & mask) {
+            Slot& slot = _slots[i];
+            if(slot.state.get() == nullptr)
+                return nullptr;
+            if(slot.fingerprint.lo != fingerprint.lo)
+                continue;
+            #ifdef MOZOK_OUTPUT_HASH_COLLISIONS_INFO
+            // Always compare the bits to measure the collision rates.
+            if(isEqual(*slot.state) == false) {
+                ++_hashCollisions;
+                if(slot.fingerprint.hi == fingerprint.hi)
+                    ++_fingerprintCollisions;
+                continue;
+            }
+            return &slot.value;
+            #else
+            if(slot.fingerprint.hi != fingerprint.hi)
+                continue;
+            if(_fingerprintOnly || isEqual(*slot.state))
+                return &slot.value;
+            #endif
+        }
+    }
+
+    T& insertSlot(Slot&& newSlot) noexcept {
+        const SIZE_T mask = _slots.size() - 1;
+        SIZE_T i = SIZE_T(newSlot.fingerprint.lo) & mask;
+        while(_slots[i].state.get() != nullptr)
+            i = (i + 1) & mask;
+        _slots[i] = std::move(newSlot);
+        return _slots[i].value;
+    }
+
+public:
+    /// @param fingerprintOnly If `true`, states with equal fingerprints are 
+    ///        considered equal.
+    BitStateMap(const bool fingerprintOnly = false) noexcept : 
+        _slots(16), 
+        _size(0), 
+        _fingerprintOnly(fingerprintOnly)
+    { /* empty */ }
+
+    #ifdef MOZOK_OUTPUT_HASH_COLLISIONS_INFO
+    ~BitStateMap() noexcept {
+        if(_lookups == 0)
+            return;
+        printf("BitStateMap: %zu states, %zu lookups, "
+                "64-bit collisions %zu (%.3g%%), "
+                "128-bit collisions %zu (%.3g%%)\n", 
+                _size, _lookups, 
+                _hashCollisions, 100.0 * double(_hashCollisions) / _lookups,
+                _fingerprintCollisions, 
+                100.0 * double(_fingerprintCollisions) / _lookups);
+    }
+    #endif
+
+    SIZE_T size() const noexcept {
+        return _size;
+    }
+
+    /// @brief Returns the value of the state, or `nullptr` if not present.
+    T* find(const BitState& state) noexcept {
+        return findSlot(state.getFingerprint(), [&](const BitState& other) {
+            return other.isEqual(state);
+        });
+    }
+
+    /// @brief Returns the value of the state that `parent.apply(...)` would 
+    ///        produce, or `nullptr` if not present.
+    /// @param parent The parent state.
+    /// @param remMask The mask of the removed statements.
+    /// @param addMask The mask of the added statements.
+    /// @param fingerprint The fingerprint of the successor (see 
+    ///        `getAppliedFingerprint`).
+    T* findApplied(
+            const BitState& parent,
+            const BitState::Word* remMask,
+            const BitState::Word* addMask,
+            const Fingerprint& fingerprint
+            ) noexcept {
+        return findSlot(fingerprint, [&](const BitState& other) {
+            return parent.isEqualApplied(other, remMask, addMask);
+        });
+    }
+
+    /// @brief Inserts a new state (it must not be present yet).
+    /// @return Returns the reference to the inserted value.
+    T& insert(const BitStatePtr& state, const T& value) noexcept {
+        // Keep the load factor below 1/2.
+        if((_size + 1) * 2 > _slots.size()) {
+            Vector<Slot> old(_slots.size() * 2);
+            old.swap(_slots);
+            for(Slot& slot : old)
+                if(slot.state.get() != nullptr)
+                    insertSlot(std::move(slot));
+        }
+        ++_size;
+        return insertSlot({state->getFingerprint(), state, value});
+    }
+};
+
+}
@@ -0,0 +1,408 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/forward_search.hpp>
+#include <libmozok/quest_planner.hpp>
+#include <libmozok/message_queue.hpp>
+
+#include <cstdint>
+
+namespace mozok {
+
+namespace {
+
+/// @brief The priority boost of the preferred open list, given every time the 
+///        heuristic value improves (the same as in LAMA).
+const int PREFERRED_BOOST = 1000;
+
+}
+
+QuestPlannerActionsIterator::QuestPlannerActionsIterator(
+        const Quest& quest,
+        SearchArena& arena,
+        const SIZE_T nodeIndx,
+        KnownStates& knownStates,
+        OpenNodeQueue& openSet,
+        const QuestSettings& settings,
+        HeuristicCalculator& heuristic,
+        OpenNodeQueue* preferredSet,
+        const Vector<char>* isPreferred,
+        Vector<Vector<int>>* preferredActions
+        ) noexcept :
+    _quest(quest),
+    _arena(arena),
+    _nodeIndx(nodeIndx),
+    _state(arena[nodeIndx].state),
+    _gScore(arena[nodeIndx].gScore),
+    _landmarks(arena[nodeIndx].landmarks),
+    _knownStates(knownStates),
+    _openSet(openSet),
+    _settings(settings),
+    _heuristic(heuristic),
+    _preferredSet(preferredSet),
+    _isPreferred(isPreferred),
+    _preferredActions(preferredActions)
+{ /* empty */ }
+
+bool QuestPlannerActionsIterator::possibleActionCallback(
+        const SIZE_T possibleActionIndx) noexcept {
+    if(_openSet.size() > OpenNodeQueue::size_type(_settings.spaceLimit))
+        return false;
+    
+    // The action is applicable, so the successor is the current state 
+    // with the action's masks applied. Its hash value is computed from 
+    // the masks, and the duplicates are rejected before the successor 
+    // is materialized.
+    const BitState::Word* remMask = 
+            _quest.getActionRemMask(possibleActionIndx);
+    const BitState::Word* addMask = 
+            _quest.getActionAddMask(possibleActionIndx);
+    const Fingerprint fingerprint = _state->getAppliedFingerprint(
+            remMask, addMask, _quest.getStatementKeys());
+    if(_knownStates.findApplied(
+            *_state, remMask, addMask, fingerprint) != nullptr)
+        // A node with such a state already present in the tree.
+        return true;
+
+    BitStatePtr newState = makeShared<BitState>(*_state);
+    newState->apply(remMask, addMask, _quest.getStatementKeys());
+
+    int landmarks = -1;
+    const int h_value = 
+            _heuristic.calculate(newState, _landmarks, landmarks);
+
+    // Goal is unreachable from this state.
+    if(h_value == HeuristicCalculator::INF)
+        return true;
+
+    // Save the resulting state into a new node.
+    const int gScore = _gScore + 1;
+    const SearchNode newNode = {
+            newState, makeNodeRef(0, _nodeIndx), int(possibleActionIndx), 
+            gScore, gScore + h_value, landmarks};
+    
+    // Insert the new node into the graph and into the open set.
+    _knownStates.insert(newState, true);
+    if(_openSet.size() <= OpenNodeQueue::size_type(_settings.spaceLimit)) {
+        const OpenNode openNode = 
+                {newNode.fScore, newNode.gScore, _arena.add(newNode)};
+        _openSet.push(openNode);
+        if(_preferredSet != nullptr && (*_isPreferred)[possibleActionIndx])
+            _preferredSet->push(openNode);
+        if(_preferredActions != nullptr) {
+            // The relaxed plan is known only now, when the node is 
+            // evaluated, so the preferred actions are kept until the node 
+            // is expanded.
+            _preferredActions->resize(openNode.nodeIndx + 1);
+            _heuristic.collectPreferredActions(
+                    *newState, (*_preferredActions)[openNode.nodeIndx]);
+        }
+    }
+    
+    return true;
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_Search(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const BitState& goalMask = quest.getGoalMask(SIZE_T(goalIndx));
+
+    // All the nodes of this search.
+    SearchArena arena;
+    const SIZE_T initialNodeIndx = 
+            arena.add({_givenBitState, NO_NODE, -1, 0, 0, -1});
+    
+    // All discovered states so far.
+    KnownStates knownStates(settings.fingerprintOnly);
+
+    // States that must be investigated next.
+    // Nodes with lower f-score have higher priority.
+    const OpenNodeCmp_Base* cmpFunc = &openNodeCmp_AStar;
+    switch(settings.strategy) {
+        case QuestSearchStrategy::ASTAR: 
+        case QuestSearchStrategy::HDASTAR: // single thread HDA* is A*
+        case QuestSearchStrategy::PORTFOLIO:
+        case QuestSearchStrategy::INCREMENTAL:
+        case QuestSearchStrategy::BACKWARD:
+        case QuestSearchStrategy::BIDIRECTIONAL:
+        case QuestSearchStrategy::ANYTIME:
+        case QuestSearchStrategy::IDA:
+        case QuestSearchStrategy::GRAPHPLAN:
+        case QuestSearchStrategy::SAT:
+        case QuestSearchStrategy::BEAM:
+        case QuestSearchStrategy::IW:
+        case QuestSearchStrategy::BFWS:
+            cmpFunc = &openNodeCmp_AStar;
+            break;
+        case QuestSearchStrategy::DFS: 
+            cmpFunc = &openNodeCmp_DFS;
+            break;
+        case QuestSearchStrategy::GBFS:
+        case QuestSearchStrategy::EHC: // EHC falls back to GBFS
+            cmpFunc = &openNodeCmp_GBFS;
+            break;
+    }
+    OpenNodeCmp cmpObj(cmpFunc);
+    OpenNodeQueue openSet(cmpObj);
+    openSet.push({0, 0, initialNodeIndx});
+
+    // With the FF heuristic, the nodes generated by the preferred operators 
+    // (the relaxed plan actions applicable in the expanded state) are also 
+    // added into the preferred open list. The lists are alternated, and the 
+    // preferred list is boosted every time the heuristic value improves. 
+    // The preferred operators of a node are collected when the node is 
+    // evaluated.
+    const bool usePreferred = (settings.heuristic == QuestHeuristic::FF);
+    OpenNodeQueue preferredSet(cmpObj);
+    Vector<char> isPreferred;
+    Vector<Vector<int>> preferredActions;
+    Vector<char> isExpanded;
+    int preferredPriority = 0;
+    int regularPriority = 0;
+    int bestHScore = HeuristicCalculator::INF;
+    if(usePreferred) {
+        preferredSet.push({0, 0, initialNodeIndx});
+        isPreferred.assign(quest.getPossibleActions().size(), 0);
+    }
+
+    NodeRef finalNode = NO_NODE;
+    int searchStep = 0;
+
+    HeuristicCache* const cache = _quest->getHeuristicCache(goalIndx);
+    HeuristicCalculator heuristic(
+            _quest->getQuest(), goalIndx, settings, 
+            _quest->getLandmarks(goalIndx), 
+            _quest->getPatternDatabase(goalIndx),
+            cache);
+    const int initialHScore = heuristic.calculate(
+            _givenBitState, -1, arena[initialNodeIndx].landmarks);
+    arena[initialNodeIndx].fScore = initialHScore;
+    if(usePreferred) {
+        preferredActions.resize(initialNodeIndx + 1);
+        heuristic.collectPreferredActions(
+                *_givenBitState, preferredActions[initialNodeIndx]);
+    }
+
+    while(openSet.size() > 0) {
+        if(cancelFlag != nullptr && cancelFlag->isCancelled())
+            // The result of this search is no longer needed.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+
+        ++searchStep;
+        const bool isSearchLimitReached = 
+                searchStep > settings.searchLimit;
+        const bool isSpaceLimitReached = 
+                int(openSet.size()) > settings.spaceLimit;
+        const bool isTimeLimitReached = _deadline.isReached(searchStep);
+        if(isSearchLimitReached || isSpaceLimitReached 
+                || isTimeLimitReached) {
+            if(isSearchLimitReached)
+                messageProcessor.onSearchLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.searchLimit);
+            if(isSpaceLimitReached)
+                messageProcessor.onSpaceLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.spaceLimit);
+            if(isTimeLimitReached)
+                messageProcessor.onTimeLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.timeLimitUs);
+            // We reach the search limit.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+        }
+        
+        // Pop next open node with the smallest f-score.
+        OpenNodeQueue* selectedSet = &openSet;
+        if(usePreferred) {
+            if(preferredSet.empty() == false 
+                    && preferredPriority <= regularPriority) {
+                selectedSet = &preferredSet;
+                ++preferredPriority;
+            } else
+                ++regularPriority;
+        }
+        const SIZE_T nodeIndx = selectedSet->top().nodeIndx;
+        selectedSet->pop();
+        if(usePreferred) {
+            // A node can be present in both open lists. The second copy 
+            // isn't counted as a search step.
+            if(isExpanded.size() <= nodeIndx)
+                isExpanded.resize(nodeIndx + 1, 0);
+            if(isExpanded[nodeIndx]) {
+                --searchStep;
+                continue;
+            }
+            isExpanded[nodeIndx] = 1;
+        }
+        // The iterator can grow the arena, so the state is copied.
+        const BitStatePtr state = arena[nodeIndx].state;
+
+        // Check if node contains all the conditions from the goal.
+        if(state->hasSubstate(goalMask)) {
+            // We have found the optimal plan.
+            finalNode = makeNodeRef(0, nodeIndx);
+            break;
+        }
+
+        if(usePreferred) {
+            const int hScore = arena[nodeIndx].fScore - arena[nodeIndx].gScore;
+            if(hScore < bestHScore) {
+                bestHScore = hScore;
+                preferredPriority -= PREFERRED_BOOST;
+            }
+            for(const int actionIndx : preferredActions[nodeIndx])
+                isPreferred[actionIndx] = 1;
+        }
+
+        // Get all neighboring states using an actions iterator.
+        QuestPlannerActionsIterator it(
+                quest, arena, nodeIndx, knownStates, openSet, settings, 
+                heuristic, 
+                usePreferred ? &preferredSet : nullptr, 
+                usePreferred ? &isPreferred : nullptr,
+                usePreferred ? &preferredActions : nullptr);
+        quest.iterateOverApplicableActions(*state, it);
+
+        if(usePreferred)
+            for(const int actionIndx : preferredActions[nodeIndx])
+                isPreferred[actionIndx] = 0;
+    }
+
+    if(finalNode == NO_NODE)
+        // Goal is unreachable.
+        return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+    
+    // At this point quest goal is reachable.
+    const Vector<int> actionIndices = buildPlan({&arena}, finalNode);
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_REACHABLE, 
+            makePlanActions(quest, actionIndices), actionIndices);
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_EHC(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const BitState& goalMask = quest.getGoalMask(SIZE_T(goalIndx));
+
+    SearchArena arena;
+    SIZE_T bestNodeIndx = 
+            arena.add({_givenBitState, NO_NODE, -1, 0, 0, -1});
+    HeuristicCalculator heuristic(
+            _quest->getQuest(), goalIndx, settings, 
+            _quest->getLandmarks(goalIndx), 
+            _quest->getPatternDatabase(goalIndx),
+            _quest->getHeuristicCache(goalIndx));
+    int bestHScore = heuristic.calculate(
+            _givenBitState, -1, arena[bestNodeIndx].landmarks);
+    if(bestHScore == HeuristicCalculator::INF)
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+    arena[bestNodeIndx].fScore = bestHScore;
+
+    OpenNodeCmp cmpObj(&openNodeCmp_BFS);
+    NodeRef finalNode = NO_NODE;
+    bool isImproved = true;
+    bool isLimitReached = false;
+    int searchStep = 0;
+
+    // Every phase is a breadth-first search from the best node so far, that 
+    // ends at the first node with a lower `h()`.
+    while(finalNode == NO_NODE && isImproved && isLimitReached == false) {
+        isImproved = false;
+        // The states of the path to the best node are known, so the plan 
+        // has no loops.
+        KnownStates knownStates(settings.fingerprintOnly);
+        for(NodeRef ref = makeNodeRef(0, bestNodeIndx); ref != NO_NODE; ) {
+            const SearchNode& node = arena[SIZE_T(std::uint32_t(ref))];
+            knownStates.insert(node.state, true);
+            ref = node.preceding;
+        }
+        OpenNodeQueue openSet(cmpObj);
+        openSet.push({
+                arena[bestNodeIndx].fScore, arena[bestNodeIndx].gScore, 
+                bestNodeIndx});
+
+        while(openSet.size() > 0) {
+            if(cancelFlag != nullptr && cancelFlag->isCancelled())
+                // The result of this search is no longer needed.
+                return makeShared<QuestPlan>(
+                        _givenSubstateId, _givenState, _quest->getQuest(), 
+                        goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+
+            ++searchStep;
+            if(_deadline.isReached(searchStep)) {
+                messageProcessor.onTimeLimitReached(
+                        worldName, _quest->getQuest()->getName(), 
+                        settings.timeLimitUs);
+                return makeShared<QuestPlan>(
+                        _givenSubstateId, _givenState, _quest->getQuest(), 
+                        goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+            }
+            if(searchStep > settings.searchLimit 
+                    || int(openSet.size()) > settings.spaceLimit) {
+                // Large plateaus are better left to the greedy search.
+                isLimitReached = true;
+                break;
+            }
+
+            const SIZE_T nodeIndx = openSet.top().nodeIndx;
+            openSet.pop();
+            const BitStatePtr state = arena[nodeIndx].state;
+            if(state->hasSubstate(goalMask)) {
+                finalNode = makeNodeRef(0, nodeIndx);
+                break;
+            }
+            const int hScore = 
+                    arena[nodeIndx].fScore - arena[nodeIndx].gScore;
+            if(hScore < bestHScore) {
+                // Commit to the better node.
+                bestHScore = hScore;
+                bestNodeIndx = nodeIndx;
+                isImproved = true;
+                break;
+            }
+            QuestPlannerActionsIterator it(
+                    quest, arena, nodeIndx, knownStates, openSet, settings, 
+                    heuristic);
+            quest.iterateOverApplicableActions(*state, it);
+        }
+    }
+
+    if(finalNode == NO_NODE) {
+        // The last phase has visited all the states reachable from the best 
+        // node without finding a better one (a dead end), or has reached the
+        // search or the space limit. The greedy best-first search starts 
+        // over from the given state, with the same limits.
+        QuestSettings gbfsSettings = settings;
+        gbfsSettings.strategy = QuestSearchStrategy::GBFS;
+        return findGoalPlan_Search(
+                goalIndx, worldName, messageProcessor, gbfsSettings, 
+                cancelFlag);
+    }
+
+    const Vector<int> actionIndices = buildPlan({&arena}, finalNode);
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_REACHABLE, 
+            makePlanActions(quest, actionIndices), actionIndices);
+}
+
+}
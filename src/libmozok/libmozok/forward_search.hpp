@@ -0,0 +1,58 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/quest_manager.hpp>
+#include <libmozok/search_node.hpp>
+#include <libmozok/heuristic_calculator.hpp>
+
+namespace mozok {
+
+/// @brief A callback class for the `Quest::iterateOverApplicableActions(...)`.
+/// This one is the main iterator, used to find a plan for the initial
+/// planning problem by the forward best-first searches (`ASTAR`, `DFS`,
+/// `GBFS`, `EHC`), by the plan repair and by the forward half of the
+/// `BIDIRECTIONAL` search.
+class QuestPlannerActionsIterator :
+        public QuestPossibleActionsIterator {
+    const Quest& _quest;
+    SearchArena& _arena;
+    /// @brief A node from which we iterate trough the possible substitutions.
+    const SIZE_T _nodeIndx;
+    // Copied, because new nodes can grow the arena.
+    const BitStatePtr _state;
+    const int _gScore;
+    const int _landmarks;
+    KnownStates& _knownStates;
+    OpenNodeQueue& _openSet;
+    const QuestSettings& _settings;
+    HeuristicCalculator& _heuristic;
+    /// @brief The preferred open list, the marks of the preferred actions of
+    ///        the expanded node, and the preferred actions of every node
+    ///        (`nullptr` if the preferred operators are not used).
+    OpenNodeQueue* const _preferredSet;
+    const Vector<char>* const _isPreferred;
+    Vector<Vector<int>>* const _preferredActions;
+
+public:
+    QuestPlannerActionsIterator(
+            const Quest& quest,
+            SearchArena& arena,
+            const SIZE_T nodeIndx,
+            KnownStates& knownStates,
+            OpenNodeQueue& openSet,
+            const QuestSettings& settings,
+            HeuristicCalculator& heuristic,
+            OpenNodeQueue* preferredSet = nullptr,
+            const Vector<char>* isPreferred = nullptr,
+            Vector<Vector<int>>* preferredActions = nullptr
+            ) noexcept;
+
+    bool possibleActionCallback(const SIZE_T possibleActionIndx) noexcept;
+};
+
+}
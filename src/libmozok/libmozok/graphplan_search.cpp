@@ -0,0 +1,110 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/graphplan_search.hpp>
+#include <libmozok/search_node.hpp>
+
+namespace mozok {
+
+GraphPlanMonitor::GraphPlanMonitor(
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag,
+        const PlanningDeadline& deadline
+        ) noexcept :
+    _settings(settings),
+    _cancelFlag(cancelFlag),
+    _deadline(deadline),
+    searchStep(0),
+    isCancelled(false),
+    isSearchLimitReached(false),
+    isSpaceLimitReached(false),
+    isTimeLimitReached(false)
+{ /* empty */ }
+
+bool GraphPlanMonitor::onExtractionStep(const SIZE_T nogoodCount) noexcept {
+    if(_cancelFlag != nullptr && _cancelFlag->isCancelled()) {
+        isCancelled = true;
+        return false;
+    }
+    ++searchStep;
+    isSearchLimitReached = searchStep > _settings.searchLimit;
+    isSpaceLimitReached = int(nogoodCount) > _settings.spaceLimit;
+    isTimeLimitReached = _deadline.isReached(searchStep);
+    return !(isSearchLimitReached || isSpaceLimitReached 
+            || isTimeLimitReached);
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_GraphPlan(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const BitState& goalMask = quest.getGoalMask(SIZE_T(goalIndx));
+
+    PlanningGraph graph(quest, *_givenBitState);
+    GraphPlanMonitor monitor(settings, cancelFlag, _deadline);
+    Vector<int> actionIndices;
+    // The number of the nogoods at the level where the graph has leveled 
+    // off, after the last failed extraction.
+    SIZE_T lastNogoodCount = 0;
+    bool hasFailedAfterLevelOff = false;
+
+    while(true) {
+        if(graph.hasGoal(goalMask)) {
+            const PlanningGraph::ExtractionResult result = 
+                    graph.extractPlan(goalMask, monitor, actionIndices);
+            if(result == PlanningGraph::EXTRACTION_FOUND)
+                break;
+            if(result == PlanningGraph::EXTRACTION_STOPPED) {
+                if(monitor.isSearchLimitReached)
+                    messageProcessor.onSearchLimitReached(
+                        worldName, _quest->getQuest()->getName(), 
+                        settings.searchLimit);
+                if(monitor.isSpaceLimitReached)
+                    messageProcessor.onSpaceLimitReached(
+                        worldName, _quest->getQuest()->getName(), 
+                        settings.spaceLimit);
+                if(monitor.isTimeLimitReached)
+                    messageProcessor.onTimeLimitReached(
+                        worldName, _quest->getQuest()->getName(), 
+                        settings.timeLimitUs);
+                return makeShared<QuestPlan>(
+                        _givenSubstateId, _givenState, _quest->getQuest(), 
+                        goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+            }
+            if(graph.isLeveledOff()) {
+                // If a failed extraction after the graph has leveled off 
+                // adds no nogoods at the leveled off level, no later one will.
+                const SIZE_T nogoodCount = graph.getNogoodCount(
+                        graph.getDistinctLevelCount() - 1);
+                if(hasFailedAfterLevelOff && nogoodCount == lastNogoodCount)
+                    return makeShared<QuestPlan>(
+                            _givenSubstateId, _givenState, 
+                            _quest->getQuest(), goalIndx, 
+                            MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+                hasFailedAfterLevelOff = true;
+                lastNogoodCount = nogoodCount;
+            }
+        } else if(graph.isLeveledOff())
+            // The goal is missing or mutex at all the next levels.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+
+        if(cancelFlag != nullptr && cancelFlag->isCancelled())
+            // The result of this search is no longer needed.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+        graph.expand();
+    }
+
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_REACHABLE, 
+            makePlanActions(quest, actionIndices), actionIndices);
+}
+
+}
@@ -0,0 +1,38 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest_manager.hpp>
+#include <libmozok/quest_planner.hpp>
+#include <libmozok/planning_graph.hpp>
+
+namespace mozok {
+
+/// @brief Checks the limits of the `GRAPHPLAN` plan extraction. Every 
+/// extraction step is a search step, and the memoized nogoods are the 
+/// stored states.
+class GraphPlanMonitor : public PlanExtractionMonitor {
+    const QuestSettings& _settings;
+    const SearchCancelFlag* const _cancelFlag;
+    const PlanningDeadline& _deadline;
+
+public:
+    int searchStep;
+    bool isCancelled;
+    bool isSearchLimitReached;
+    bool isSpaceLimitReached;
+    bool isTimeLimitReached;
+
+    GraphPlanMonitor(
+            const QuestSettings& settings,
+            const SearchCancelFlag* cancelFlag,
+            const PlanningDeadline& deadline
+            ) noexcept;
+
+    bool onExtractionStep(const SIZE_T nogoodCount) noexcept override;
+};
+
+}
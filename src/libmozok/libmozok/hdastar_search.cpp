@@ -0,0 +1,306 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/hdastar_search.hpp>
+#include <libmozok/message_queue.hpp>
+
+namespace mozok {
+
+namespace {
+
+/// @brief The longest time an idle worker waits before it checks the 
+///        cancellation flag again.
+constexpr auto IDLE_WAIT_TIME = std::chrono::milliseconds(1);
+
+}
+
+HDAStarSearch::Worker::Worker(
+        const QuestPtr& quest,
+        const ID goalIndx,
+        const QuestSettings& settings,
+        const LandmarkGraphPtr& landmarks,
+        const PatternDatabasePtr& patternDatabase
+        ) noexcept :
+    heuristic(quest, goalIndx, settings, landmarks, patternDatabase,
+            nullptr),
+    openSet(OpenNodeCmp(&openNodeCmp_AStar)),
+    closed(settings.fingerprintOnly)
+{ /* empty */ }
+
+HDAStarSearch::HDAStarSearch(
+        const QuestPtr& quest,
+        const ID goalIndx,
+        const QuestSettings& settings,
+        const LandmarkGraphPtr& landmarks,
+        const PatternDatabasePtr& patternDatabase,
+        const SearchCancelFlag* cancelFlag,
+        const PlanningDeadline& deadline
+        ) noexcept :
+    _quest(quest),
+    _goalMask(quest->getGoalMask(SIZE_T(goalIndx))),
+    _settings(settings),
+    _cancelFlag(cancelFlag),
+    _deadline(deadline),
+    _work(0),
+    _expanded(0),
+    _openSize(0),
+    _stop(false),
+    _searchLimitReached(false),
+    _spaceLimitReached(false),
+    _timeLimitReached(false),
+    _incumbent(NO_NODE),
+    _incumbentCost(HeuristicCalculator::INF) {
+    for(int i = 0; i < settings.threads; ++i)
+        _workers.push_back(makeUnique<Worker>(
+                quest, goalIndx, settings, landmarks, patternDatabase));
+}
+
+void HDAStarSearch::receive(Worker& worker, SearchNode node) noexcept {
+    Pair<int,int>* closed = worker.closed.find(*node.state);
+    int h_value = 0;
+    if(closed != nullptr) {
+        if(closed->first <= node.gScore)
+            // A node with such a state was already reached with a
+            // shorter path.
+            return;
+        closed->first = node.gScore;
+        h_value = closed->second;
+    } else {
+        h_value = worker.heuristic.calculate(node.state);
+        worker.closed.insert(
+                node.state, Pair<int,int>(node.gScore, h_value));
+    }
+
+    // Goal is unreachable from this state.
+    if(h_value == HeuristicCalculator::INF)
+        return;
+
+    node.fScore = node.gScore + h_value;
+    if(node.fScore >= _incumbentCost.load())
+        return;
+
+    worker.openSet.push(
+            {node.fScore, node.gScore, worker.arena.add(node)});
+    if(++_openSize > _settings.spaceLimit) {
+        _spaceLimitReached.store(true);
+        _stop.store(true);
+    }
+}
+
+bool HDAStarSearch::checkGoal(
+        const SIZE_T workerIndx, const SIZE_T nodeIndx) noexcept {
+    const SearchNode& node = _workers[workerIndx]->arena[nodeIndx];
+    if(node.state->hasSubstate(_goalMask) == false)
+        return false;
+    LockGuard lock(_incumbentMutex);
+    if(node.gScore < _incumbentCost.load()) {
+        _incumbent = makeNodeRef(workerIndx, nodeIndx);
+        _incumbentCost.store(node.gScore);
+    }
+    return true;
+}
+
+void HDAStarSearch::wakeAll() noexcept {
+    for(UniquePtr<Worker>& worker : _workers) {
+        LockGuard lock(worker->inboxMutex);
+        worker->inboxCondition.notify_one();
+    }
+}
+
+void HDAStarSearch::send(
+        const SIZE_T fromWorker, const SearchNode& node) noexcept {
+    const SIZE_T owner = ownerOf(node.state);
+    if(owner == fromWorker) {
+        receive(*_workers[owner], node);
+        return;
+    }
+    ++_work;
+    LockGuard lock(_workers[owner]->inboxMutex);
+    _workers[owner]->inbox.push_back(node);
+    _workers[owner]->inboxCondition.notify_one();
+}
+
+NodeRef HDAStarSearch::run(const BitStatePtr& initialState) noexcept {
+    receive(*_workers[ownerOf(initialState)],
+            {initialState, NO_NODE, -1, 0, 0, -1});
+
+    _work.store(int(_workers.size()));
+    Vector<Thread> threads;
+    for(SIZE_T i = 1; i < _workers.size(); ++i)
+        threads.push_back(Thread(&HDAStarSearch::workerFunc, this, i));
+    workerFunc(0);
+    for(Thread& thread : threads)
+        thread.join();
+    return _incumbent;
+}
+
+Vector<int> HDAStarSearch::buildPlan(const NodeRef finalNode) const noexcept {
+    Vector<const SearchArena*> arenas;
+    for(const UniquePtr<Worker>& worker : _workers)
+        arenas.push_back(&worker->arena);
+    return ::mozok::buildPlan(arenas, finalNode);
+}
+
+HDAStarActionsIterator::HDAStarActionsIterator(
+        HDAStarSearch& search,
+        const SIZE_T workerIndx,
+        const SIZE_T nodeIndx
+        ) noexcept :
+    _search(search),
+    _workerIndx(workerIndx),
+    _nodeRef(makeNodeRef(workerIndx, nodeIndx)),
+    _state(search.getNode(workerIndx, nodeIndx).state),
+    _gScore(search.getNode(workerIndx, nodeIndx).gScore)
+{ /* empty */ }
+
+bool HDAStarActionsIterator::possibleActionCallback(
+        const SIZE_T possibleActionIndx) noexcept {
+    if(_search.isStopped())
+        return false;
+    const Quest& quest = _search.getQuest();
+    BitStatePtr newState = makeShared<BitState>(*_state);
+    newState->apply(
+            quest.getActionRemMask(possibleActionIndx),
+            quest.getActionAddMask(possibleActionIndx),
+            quest.getStatementKeys());
+    _search.send(_workerIndx,
+            {newState, _nodeRef, int(possibleActionIndx), _gScore + 1, 0, -1});
+    return true;
+}
+
+void HDAStarSearch::workerFunc(const SIZE_T workerIndx) noexcept {
+    Worker& worker = *_workers[workerIndx];
+    bool isActive = true;
+    Vector<SearchNode> received;
+
+    while(isStopped() == false) {
+        // Receive the nodes sent by the other workers.
+        {
+            LockGuard lock(worker.inboxMutex);
+            received.swap(worker.inbox);
+        }
+        if(received.empty() == false) {
+            if(isActive == false) {
+                // Must be done before the nodes are marked as received.
+                ++_work;
+                isActive = true;
+            }
+            for(const SearchNode& node : received) {
+                receive(worker, node);
+                --_work;
+            }
+            received.clear();
+        }
+
+        // Expand the best open node.
+        if(worker.openSet.empty() == false 
+                && worker.openSet.top().fScore < _incumbentCost.load()) {
+            const SIZE_T nodeIndx = worker.openSet.top().nodeIndx;
+            worker.openSet.pop();
+            --_openSize;
+
+            // Skip the outdated nodes (the state was later reached by 
+            // a shorter path).
+            const SearchNode& node = worker.arena[nodeIndx];
+            if(worker.closed.find(*node.state)->first < node.gScore)
+                continue;
+
+            const int expanded = ++_expanded;
+            if(expanded > _settings.searchLimit) {
+                _searchLimitReached.store(true);
+                _stop.store(true);
+                break;
+            }
+            if(_deadline.isReached(expanded)) {
+                _timeLimitReached.store(true);
+                _stop.store(true);
+                break;
+            }
+
+            if(checkGoal(workerIndx, nodeIndx))
+                continue;
+
+            HDAStarActionsIterator it(*this, workerIndx, nodeIndx);
+            const BitStatePtr state = node.state;
+            _quest->iterateOverApplicableActions(*state, it);
+            continue;
+        }
+
+        // Nothing to do.
+        if(isActive) {
+            isActive = false;
+            if(--_work == 0) {
+                wakeAll();
+                break;
+            }
+        }
+        // Wait for new nodes. The timeout is needed only to notice the 
+        // cancellation, which isn't signaled by the condition variable.
+        UniqueLock lock(worker.inboxMutex);
+        worker.inboxCondition.wait_for(lock, IDLE_WAIT_TIME, [&]{
+            return worker.inbox.empty() == false
+                    || _work.load() == 0 || isStopped();
+        });
+        if(worker.inbox.empty() && _work.load() == 0)
+            break;
+    }
+
+    // Wake up the idle workers, if this one was stopped by a limit.
+    if(isStopped())
+        wakeAll();
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_HDAStar(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    HDAStarSearch search(
+            _quest->getQuest(), goalIndx, settings, 
+            _quest->getLandmarks(goalIndx), 
+            _quest->getPatternDatabase(goalIndx), cancelFlag, _deadline);
+    const NodeRef finalNode = search.run(_givenBitState);
+
+    if(search.isCancelled())
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+
+    if(finalNode != NO_NODE) {
+        // The best plan found so far is returned even if a limit was 
+        // reached before it was proven to be the best one.
+        const Vector<int> actionIndices = search.buildPlan(finalNode);
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_REACHABLE, 
+                makePlanActions(*_quest->getQuest(), actionIndices), 
+                actionIndices);
+    }
+
+    if(search.isSearchLimitReached() || search.isSpaceLimitReached()
+            || search.isTimeLimitReached()) {
+        if(search.isSearchLimitReached())
+            messageProcessor.onSearchLimitReached(
+                worldName, _quest->getQuest()->getName(), 
+                settings.searchLimit);
+        if(search.isSpaceLimitReached())
+            messageProcessor.onSpaceLimitReached(
+                worldName, _quest->getQuest()->getName(), 
+                settings.spaceLimit);
+        if(search.isTimeLimitReached())
+            messageProcessor.onTimeLimitReached(
+                worldName, _quest->getQuest()->getName(), 
+                settings.timeLimitUs);
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+    }
+
+    // Goal is unreachable.
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+}
+
+}
@@ -0,0 +1,178 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+#include <libmozok/quest_manager.hpp>
+#include <libmozok/quest_planner.hpp>
+#include <libmozok/search_node.hpp>
+#include <libmozok/heuristic_calculator.hpp>
+
+#include <cstdint>
+
+namespace mozok {
+
+/// @brief Hash-distributed A* (HDA*) search.
+/// Each state has an owner thread, selected by the state's hash value. Every
+/// thread has its own open list and its own closed list and expands only the
+/// states it owns. Newly generated states are asynchronously sent into the
+/// inbox of their owners. The search is finished when no thread has an open
+/// node better than the best plan found so far, and no node is in transit.
+/// With an admissible heuristic the found plan is optimal, so its length
+/// doesn't depend on the thread scheduling. With an inadmissible heuristic
+/// the search still continues until no open node promises a shorter plan,
+/// but the found plan isn't optimal and may differ between the runs.
+class HDAStarSearch {
+    /// @brief Closed list value: (best known g-score, h-score).
+    using ClosedMap = BitStateMap<Pair<int,int>>;
+
+    /// @brief Search thread data.
+    struct Worker {
+        HeuristicCalculator heuristic;
+        OpenNodeQueue openSet;
+        ClosedMap closed;
+
+        /// @brief Nodes owned by this worker. Only the worker itself adds
+        ///        the nodes.
+        SearchArena arena;
+
+        /// @brief Nodes sent to this worker by the other workers.
+        Vector<SearchNode> inbox;
+        Mutex inboxMutex;
+
+        /// @brief Notified when a node is sent to this worker, or when the
+        ///        search is over. Idle workers wait on it.
+        ConditionVariable inboxCondition;
+
+        Worker(
+                const QuestPtr& quest,
+                const ID goalIndx,
+                const QuestSettings& settings,
+                const LandmarkGraphPtr& landmarks,
+                const PatternDatabasePtr& patternDatabase
+                ) noexcept;
+    };
+
+    const QuestPtr _quest;
+    const BitState& _goalMask;
+    const QuestSettings& _settings;
+    const SearchCancelFlag* const _cancelFlag;
+    const PlanningDeadline& _deadline;
+    Vector<UniquePtr<Worker>> _workers;
+
+    /// @brief The number of workers that are not idle plus the number of
+    ///        nodes in transit. The search is over when it reaches zero.
+    Atomic<int> _work;
+
+    /// @brief The number of expanded nodes (across all workers).
+    Atomic<int> _expanded;
+
+    /// @brief The total size of all open lists.
+    Atomic<int> _openSize;
+
+    Atomic<bool> _stop;
+    Atomic<bool> _searchLimitReached;
+    Atomic<bool> _spaceLimitReached;
+    Atomic<bool> _timeLimitReached;
+
+    /// @brief The best goal node found so far and its cost.
+    NodeRef _incumbent;
+    Atomic<int> _incumbentCost;
+    Mutex _incumbentMutex;
+
+    SIZE_T ownerOf(const BitStatePtr& state) const noexcept {
+        return SIZE_T(state->getFingerprint().lo
+                % std::uint64_t(_workers.size()));
+    }
+
+    /// @brief Inserts a node, owned by the worker, into its arena and its
+    ///        open list.
+    void receive(Worker& worker, SearchNode node) noexcept;
+
+    /// @brief Checks whether the node is a goal node and, if it's better
+    ///        than the current incumbent, replaces the incumbent.
+    bool checkGoal(const SIZE_T workerIndx, const SIZE_T nodeIndx) noexcept;
+
+    /// @brief Wakes up all idle workers (when the search is over).
+    void wakeAll() noexcept;
+
+    void workerFunc(const SIZE_T workerIndx) noexcept;
+
+public:
+    HDAStarSearch(
+            const QuestPtr& quest,
+            const ID goalIndx,
+            const QuestSettings& settings,
+            const LandmarkGraphPtr& landmarks,
+            const PatternDatabasePtr& patternDatabase,
+            const SearchCancelFlag* cancelFlag,
+            const PlanningDeadline& deadline
+            ) noexcept;
+
+    /// @brief Sends a node to its owner.
+    void send(const SIZE_T fromWorker, const SearchNode& node) noexcept;
+
+    bool isStopped() const noexcept {
+        return _stop.load() || isCancelled();
+    }
+
+    bool isCancelled() const noexcept {
+        return _cancelFlag != nullptr && _cancelFlag->isCancelled();
+    }
+
+    /// @brief Performs the search.
+    /// @return Returns the best found goal node, or `NO_NODE`. If a limit
+    ///         was reached, the node isn't proven to be the best one.
+    NodeRef run(const BitStatePtr& initialState) noexcept;
+
+    const Quest& getQuest() const noexcept {
+        return *_quest;
+    }
+
+    const SearchNode& getNode(
+            const SIZE_T workerIndx, const SIZE_T nodeIndx) const noexcept {
+        return _workers[workerIndx]->arena[nodeIndx];
+    }
+
+    /// @brief Builds the plan of a goal node (must be called after `run`).
+    /// @return Returns the indices of the possible actions of the plan.
+    Vector<int> buildPlan(const NodeRef finalNode) const noexcept;
+
+    bool isSearchLimitReached() const noexcept {
+        return _searchLimitReached.load();
+    }
+
+    bool isSpaceLimitReached() const noexcept {
+        return _spaceLimitReached.load();
+    }
+
+    bool isTimeLimitReached() const noexcept {
+        return _timeLimitReached.load();
+    }
+};
+
+/// @brief A callback class for the `Quest::iterateOverApplicableActions(...)`.
+/// Used by HDA* search. Sends new nodes to their owners.
+class HDAStarActionsIterator : public QuestPossibleActionsIterator {
+    HDAStarSearch& _search;
+    const SIZE_T _workerIndx;
+    const NodeRef _nodeRef;
+    // Copied, because sending a node can grow the worker's arena.
+    const BitStatePtr _state;
+    const int _gScore;
+
+public:
+    HDAStarActionsIterator(
+            HDAStarSearch& search,
+            const SIZE_T workerIndx,
+            const SIZE_T nodeIndx
+            ) noexcept;
+
+    bool possibleActionCallback(const SIZE_T possibleActionIndx) noexcept;
+};
+
+}
@@ -0,0 +1,92 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/heuristic_cache.hpp>
+
+namespace mozok {
+
+HeuristicCache::HeuristicCache(const SIZE_T capacity) noexcept :
+    _capacity(capacity),
+    _hand(0),
+    _hits(0),
+    _misses(0) {
+    _entries.reserve(_capacity);
+    _indices.reserve(_capacity);
+}
+
+SIZE_T HeuristicCache::allocate() noexcept {
+    if(_entries.size() < _capacity) {
+        _entries.push_back(Entry());
+        return _entries.size() - 1;
+    }
+    while(_entries[_hand].isReferenced) {
+        _entries[_hand].isReferenced = false;
+        _hand = (_hand + 1) % _capacity;
+    }
+    const SIZE_T indx = _hand;
+    _hand = (_hand + 1) % _capacity;
+    _indices.erase(_entries[indx].fingerprint);
+    return indx;
+}
+
+bool HeuristicCache::find(const Fingerprint& fingerprint, int& h) noexcept {
+    const auto it = _indices.find(fingerprint);
+    if(it == _indices.end()) {
+        ++_misses;
+        return false;
+    }
+    ++_hits;
+    Entry& entry = _entries[it->second];
+    entry.isReferenced = true;
+    h = entry.h;
+    return true;
+}
+
+void HeuristicCache::insert(const Fingerprint& fingerprint, const int h) noexcept {
+    const auto it = _indices.find(fingerprint);
+    if(it != _indices.end()) {
+        Entry& entry = _entries[it->second];
+        if(entry.isExact == false)
+            entry.h = h;
+        entry.isReferenced = true;
+        return;
+    }
+    const SIZE_T indx = allocate();
+    _entries[indx] = {fingerprint, h, false, false};
+    _indices[fingerprint] = indx;
+}
+
+void HeuristicCache::insertExact(
+        const Fingerprint& fingerprint, const int h) noexcept {
+    const auto it = _indices.find(fingerprint);
+    if(it != _indices.end()) {
+        _entries[it->second] = {fingerprint, h, true, true};
+        return;
+    }
+    const SIZE_T indx = allocate();
+    // Plan states are likely to be visited again by the next planning.
+    _entries[indx] = {fingerprint, h, true, true};
+    _indices[fingerprint] = indx;
+}
+
+SIZE_T HeuristicCache::size() const noexcept {
+    return _entries.size();
+}
+
+SIZE_T HeuristicCache::getCapacity() const noexcept {
+    return _capacity;
+}
+
+SIZE_T HeuristicCache::getHits() const noexcept {
+    return _hits;
+}
+
+SIZE_T HeuristicCache::getMisses() const noexcept {
+    return _misses;
+}
+
+void HeuristicCache::resetStats() noexcept {
+    _hits = 0;
+    _misses = 0;
+}
+
+}
@@ -0,0 +1,90 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/bit_state.hpp>
+
+namespace mozok {
+
+class HeuristicCache;
+using HeuristicCachePtr = SharedPtr<HeuristicCache>;
+
+/// @brief A bounded cache of the `h()` values of a quest goal, that survives
+/// across the planning calls. States are identified by their 128-bit
+/// fingerprints (see `BitState`). When the cache is full, an entry is evicted
+/// by the CLOCK algorithm: the hand sweeps over the entries, clearing their
+/// reference bits, and replaces the first entry that wasn't used since the
+/// last sweep.
+/// Besides the heuristic values, the cache stores the goal distances learned
+/// from the plans proven to be optimal: every state on a plan gets the 
+/// remaining length of the plan. Such values are never overwritten by the 
+/// heuristic values.
+class HeuristicCache {
+    struct Entry {
+        Fingerprint fingerprint;
+        int h;
+        /// @brief `true` if the value is a goal distance from a plan.
+        bool isExact;
+        /// @brief CLOCK reference bit.
+        bool isReferenced;
+    };
+
+    struct FingerprintHash {
+        std::size_t operator()(const Fingerprint& fingerprint) const noexcept {
+            return std::size_t(fingerprint.lo);
+        }
+    };
+
+    /// @brief The entries in the CLOCK order.
+    Vector<Entry> _entries;
+
+    /// @brief Fingerprint to `_entries` index.
+    HashMap<Fingerprint, SIZE_T, FingerprintHash> _indices;
+
+    const SIZE_T _capacity;
+
+    /// @brief The CLOCK hand.
+    SIZE_T _hand;
+
+    SIZE_T _hits;
+    SIZE_T _misses;
+
+    /// @brief Returns the index of a free entry for a new fingerprint.
+    ///        Evicts an entry if the cache is full.
+    SIZE_T allocate() noexcept;
+
+public:
+    /// @brief Creates an empty cache.
+    /// @param capacity The maximum number of entries (must be positive).
+    HeuristicCache(const SIZE_T capacity) noexcept;
+
+    /// @brief Looks up the value of a state. Counts a hit or a miss.
+    /// @param fingerprint The fingerprint of the state.
+    /// @param h Receives the value, if found.
+    /// @return Returns `true` if the value was found.
+    bool find(const Fingerprint& fingerprint, int& h) noexcept;
+
+    /// @brief Stores the heuristic value of a state.
+    void insert(const Fingerprint& fingerprint, const int h) noexcept;
+
+    /// @brief Stores the goal distance of a state, learned from a plan that 
+    ///        is proven to be optimal.
+    void insertExact(const Fingerprint& fingerprint, const int h) noexcept;
+
+    SIZE_T size() const noexcept;
+    SIZE_T getCapacity() const noexcept;
+
+    /// @brief Returns the number of the hits since the last `resetStats()`.
+    SIZE_T getHits() const noexcept;
+
+    /// @brief Returns the number of the misses since the last `resetStats()`.
+    SIZE_T getMisses() const noexcept;
+
+    /// @brief Resets the numbers of the hits and the misses.
+    void resetStats() noexcept;
+};
+
+}
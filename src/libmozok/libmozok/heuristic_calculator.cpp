@@ -0,0 +1,296 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/heuristic_calculator.hpp>
+#include <libmozok/statement.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace mozok {
+
+const int HeuristicCalculator::INF;
+
+HeuristicCalculator::HeuristicCalculator(
+        const QuestPtr& quest,
+        const ID goalIndx,
+        const QuestSettings& settings,
+        const LandmarkGraphPtr& landmarks,
+        const PatternDatabasePtr& patternDatabase,
+        HeuristicCache* const cache
+        ) noexcept :
+    _quest(quest),
+    _settings(settings),
+    _goalCount(0),
+    _mark(0),
+    _landmarks(landmarks),
+    _landmarkWords(0),
+    _patternDatabase(patternDatabase),
+    _cache(cache) {
+    if(_landmarks != nullptr)
+        _landmarkWords = BitState::getWordCount(_landmarks->size());
+    for(const StatementPtr& goalStatement :
+            _quest->getGoals().at(goalIndx))
+        _goalWeights.push_back(Pair<SIZE_T, int>(
+                SIZE_T(_quest->getStatementIndx(goalStatement)),
+                int(goalStatement->getArguments().size())
+                    + _settings.omega));
+    if(_settings.heuristic == QuestHeuristic::HSP
+            || _settings.heuristic == QuestHeuristic::HADD
+            || _settings.heuristic == QuestHeuristic::HMAX
+            || _settings.heuristic == QuestHeuristic::FF) {
+        const SIZE_T actionCount = _quest->getPossibleActions().size();
+        _costs.resize(_quest->getStatementCount());
+        _supporters.resize(_costs.size());
+        _statementMarks.assign(_costs.size(), 0);
+        _actionMarks.assign(actionCount, 0);
+        for(SIZE_T i=0; i<actionCount; ++i) {
+            const int preCount = int(_quest->getActionPreList(i).size());
+            _initialCounters.push_back({0, preCount});
+            if(preCount == 0)
+                _actionsWithoutPre.push_back(int(i));
+        }
+        _isGoal.assign(_costs.size(), 0);
+        for(const Pair<SIZE_T, int>& goalWeight : _goalWeights) {
+            if(_isGoal[goalWeight.first] == 0)
+                ++_goalCount;
+            _isGoal[goalWeight.first] = 1;
+        }
+    }
+}
+
+int HeuristicCalculator::calcSimpleHeuristic(
+        const BitState& state) const noexcept {
+    int h_simp = 0;
+    for(const Pair<SIZE_T, int>& goalWeight : _goalWeights)
+        if(state.hasBit(goalWeight.first) == false)
+            h_simp += goalWeight.second;
+    return h_simp;
+}
+
+void HeuristicCalculator::reach(
+        const int indx, const int cost, const int supporter) noexcept {
+    if(_costs[indx] <= cost)
+        return;
+    _costs[indx] = cost;
+    _supporters[indx] = supporter;
+    _queue.push_back((std::uint64_t(cost) << 32) | std::uint64_t(indx));
+    std::push_heap(_queue.begin(), _queue.end(),
+            std::greater<std::uint64_t>());
+}
+
+void HeuristicCalculator::fire(
+        const int actionIndx, const int cost) noexcept {
+    for(const int indx : _quest->getActionAddList(SIZE_T(actionIndx)))
+        reach(indx, cost, actionIndx);
+}
+
+template<bool MAX>
+int HeuristicCalculator::calcRelaxedHeuristic(const BitState& state) noexcept {
+    const Quest& quest = *_quest;
+    _costs.assign(_costs.size(), int(INF));
+    _counters = _initialCounters;
+    _queue.clear();
+
+    // The statements of the state are reached with zero cost. They don't
+    // change the action costs, so only the counters are updated.
+    SIZE_T goalsLeft = _goalCount;
+    BitState::forEachBit(state.getWords(), state.getWordCount(),
+            [&](const SIZE_T indx) {
+        _costs[indx] = 0;
+        _supporters[indx] = -1;
+        if(_isGoal[indx])
+            --goalsLeft;
+    });
+    BitState::forEachBit(state.getWords(), state.getWordCount(),
+            [&](const SIZE_T indx) {
+        for(const int actionIndx : quest.getStatementPreActions(indx))
+            if(--_counters[actionIndx].unsatisfied == 0)
+                fire(actionIndx, 1);
+    });
+    for(const int actionIndx : _actionsWithoutPre)
+        fire(actionIndx, 1);
+
+    while(_queue.empty() == false && goalsLeft > 0) {
+        std::pop_heap(_queue.begin(), _queue.end(),
+                std::greater<std::uint64_t>());
+        const int cost = int(_queue.back() >> 32);
+        const int indx = int(_queue.back() & 0xffffffffu);
+        _queue.pop_back();
+        if(cost > _costs[indx])
+            continue; // outdated entry
+        if(_isGoal[indx] && --goalsLeft == 0)
+            break; // the costs of all goal statements are final
+        for(const int actionIndx :
+                quest.getStatementPreActions(SIZE_T(indx))) {
+            ActionCounter& counter = _counters[actionIndx];
+            counter.cost = MAX ? std::max(counter.cost, cost)
+                    : counter.cost + cost;
+            if(--counter.unsatisfied == 0)
+                fire(actionIndx, counter.cost + 1);
+        }
+    }
+
+    // Get goal cost
+    int h = 0;
+    for(const Pair<SIZE_T, int>& goalWeight : _goalWeights) {
+        const int cost = _costs[goalWeight.first];
+        if(cost == INF)
+            return INF;
+        h = MAX ? std::max(h, cost) : h + cost;
+    }
+    return h;
+}
+
+int HeuristicCalculator::calcFFHeuristic(const BitState& state) noexcept {
+    _relaxedPlan.clear();
+    if(calcRelaxedHeuristic<false>(state) == INF)
+        return INF;
+    if(++_mark == 0) {
+        // Overflow, reset all the marks.
+        _statementMarks.assign(_statementMarks.size(), 0);
+        _actionMarks.assign(_actionMarks.size(), 0);
+        _mark = 1;
+    }
+    const Quest& quest = *_quest;
+    _subgoals.clear();
+    for(const Pair<SIZE_T, int>& goalWeight : _goalWeights)
+        _subgoals.push_back(int(goalWeight.first));
+    while(_subgoals.empty() == false) {
+        const int indx = _subgoals.back();
+        _subgoals.pop_back();
+        if(_statementMarks[indx] == _mark)
+            continue;
+        _statementMarks[indx] = _mark;
+        const int actionIndx = _supporters[indx];
+        if(_costs[indx] == 0 || _actionMarks[actionIndx] == _mark)
+            continue;
+        _actionMarks[actionIndx] = _mark;
+        _relaxedPlan.push_back(actionIndx);
+        for(const int preIndx : quest.getActionPreList(SIZE_T(actionIndx)))
+            if(_statementMarks[preIndx] != _mark)
+                _subgoals.push_back(preIndx);
+    }
+    return int(_relaxedPlan.size());
+}
+
+int HeuristicCalculator::calcLandmarkHeuristic(
+        const BitState& state,
+        const int parentSet,
+        int& acceptedSet
+        ) noexcept {
+    const LandmarkGraph& graph = *_landmarks;
+    const SIZE_T offset = _acceptedSets.size();
+    acceptedSet = int(offset / _landmarkWords);
+    _acceptedSets.resize(offset + _landmarkWords, 0);
+    const BitState::Word* parent = parentSet < 0 ? nullptr
+            : &_acceptedSets[SIZE_T(parentSet) * _landmarkWords];
+    BitState::Word* accepted = &_acceptedSets[offset];
+    const auto isAccepted = [](
+            const BitState::Word* words, const SIZE_T landmark) {
+        return (words[landmark / BitState::WORD_BITS]
+                >> (landmark % BitState::WORD_BITS)) & 1;
+    };
+
+    for(SIZE_T i = 0; i < graph.size(); ++i) {
+        bool isNew = false;
+        if(parent != nullptr && isAccepted(parent, i))
+            isNew = true;
+        else if(state.hasBit(SIZE_T(graph.getStatementIndx(i)))) {
+            isNew = true;
+            if(parent != nullptr)
+                for(const int pred : graph.getPredecessors(i))
+                    if(isAccepted(parent, SIZE_T(pred)) == false) {
+                        isNew = false;
+                        break;
+                    }
+        }
+        if(isNew)
+            accepted[i / BitState::WORD_BITS] |=
+                    BitState::Word(1) << (i % BitState::WORD_BITS);
+    }
+
+    int h = 0;
+    for(SIZE_T i = 0; i < graph.size(); ++i) {
+        if(isAccepted(accepted, i) == false) {
+            ++h;
+            continue;
+        }
+        if(state.hasBit(SIZE_T(graph.getStatementIndx(i))))
+            continue;
+        bool isRequired = graph.isGoal(i);
+        for(const int succ : graph.getSuccessors(i))
+            if(isAccepted(accepted, SIZE_T(succ)) == false) {
+                isRequired = true;
+                break;
+            }
+        if(isRequired)
+            ++h;
+    }
+    return h;
+}
+
+int HeuristicCalculator::calculate(const BitStatePtr& state) noexcept {
+    switch(_settings.heuristic) {
+        case QuestHeuristic::SIMPLE:
+            return calcSimpleHeuristic(*state);
+        case QuestHeuristic::HSP:
+            // `HSP` is an alias of `HADD`: the additive heuristic of
+            // the HSP planner.
+        case QuestHeuristic::HADD:
+            return calcRelaxedHeuristic<false>(*state);
+        case QuestHeuristic::HMAX:
+            return calcRelaxedHeuristic<true>(*state);
+        case QuestHeuristic::FF:
+            return calcFFHeuristic(*state);
+        case QuestHeuristic::LANDMARKS: {
+            // Without the path, only the landmarks of the state are
+            // accepted.
+            int acceptedSet = -1;
+            const int h = calculate(state, -1, acceptedSet);
+            _acceptedSets.clear();
+            return h;
+        }
+        case QuestHeuristic::PDB:
+            if(_patternDatabase == nullptr)
+                return 0;
+            return _patternDatabase->lookup(*state);
+        default:
+            return 0;
+    }
+}
+
+int HeuristicCalculator::calculate(
+        const BitStatePtr& state,
+        const int parentLandmarks,
+        int& landmarks
+        ) noexcept {
+    landmarks = -1;
+    if(_settings.heuristic != QuestHeuristic::LANDMARKS) {
+        if(_cache == nullptr)
+            return calculate(state);
+        int h = 0;
+        if(_cache->find(state->getFingerprint(), h)) {
+            // The relaxed plan of the state is unknown.
+            _relaxedPlan.clear();
+            return h;
+        }
+        h = calculate(state);
+        _cache->insert(state->getFingerprint(), h);
+        return h;
+    }
+    if(_landmarkWords == 0)
+        return 0;
+    return calcLandmarkHeuristic(*state, parentLandmarks, landmarks);
+}
+
+void HeuristicCalculator::collectPreferredActions(
+        const BitState& state,
+        Vector<int>& preferredActions
+        ) const noexcept {
+    preferredActions.clear();
+    for(const int actionIndx : _relaxedPlan)
+        if(state.hasSubstate(_quest->getActionPreMask(SIZE_T(actionIndx))))
+            preferredActions.push_back(actionIndx);
+}
+
+}
@@ -0,0 +1,164 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+#include <libmozok/quest_manager.hpp>
+#include <libmozok/landmarks.hpp>
+#include <libmozok/pattern_database.hpp>
+#include <libmozok/heuristic_cache.hpp>
+
+#include <cstdint>
+#include <limits>
+
+namespace mozok {
+
+/// @brief The state of an action during the relaxed heuristic calculation.
+struct ActionCounter {
+    /// @brief The sum (or the maximum) of the costs of the reached
+    ///        preconditions.
+    int cost;
+
+    /// @brief The number of the preconditions that are not reached yet.
+    int unsatisfied;
+};
+
+/// @brief Calculates the heuristic values (`h()`) for a given goal.
+/// The calculator holds the working tables of the heuristic functions, so a
+/// calculator must never be shared between several threads.
+class HeuristicCalculator {
+    const QuestPtr _quest;
+    const QuestSettings& _settings;
+
+    /// @brief (statement index, weight) pairs of the goal statements. The
+    ///        weights are used only by the SIMPLE heuristic.
+    Vector<Pair<SIZE_T, int>> _goalWeights;
+
+    /// @brief Data tables for the relaxed heuristics (HSP, HADD, HMAX and FF).
+    /// `_costs[i]` is the cost of the i-th statement, `_supporters[i]` is the
+    /// action that reached it with this cost (or `-1`), and `_counters[i]` is
+    /// the counter of the i-th action (see `ActionCounter`).
+    Vector<int> _costs;
+    Vector<int> _supporters;
+    Vector<ActionCounter> _counters;
+    Vector<ActionCounter> _initialCounters;
+    Vector<int> _actionsWithoutPre;
+    Vector<char> _isGoal;
+    SIZE_T _goalCount;
+
+    /// @brief Min-heap of the reached statements, as `cost << 32 | indx`.
+    Vector<std::uint64_t> _queue;
+
+    /// @brief The actions of the last relaxed plan (FF).
+    Vector<int> _relaxedPlan;
+
+    /// @brief Statements that wait for their supporters during the relaxed
+    ///        plan extraction.
+    Vector<int> _subgoals;
+
+    /// @brief Marks of the statements and actions visited during the relaxed
+    ///        plan extraction. An item is marked if its mark equals `_mark`.
+    Vector<unsigned> _statementMarks;
+    Vector<unsigned> _actionMarks;
+    unsigned _mark;
+
+    /// @brief The landmark graph of the goal (LANDMARKS).
+    const LandmarkGraphPtr _landmarks;
+
+    /// @brief The accepted landmark sets, as bit sets of `_landmarkWords`
+    ///        words, stored one after another. The nodes refer to their sets
+    ///        by index.
+    SIZE_T _landmarkWords;
+    Vector<BitState::Word> _acceptedSets;
+
+    /// @brief The pattern database of the goal (PDB).
+    const PatternDatabasePtr _patternDatabase;
+
+    /// @brief The cross-planning cache of the goal, or `nullptr`.
+    HeuristicCache* const _cache;
+
+    /// @brief Calculates simple but surprisingly effective `h()` value.
+    int calcSimpleHeuristic(const BitState& state) const noexcept;
+
+    /// @brief Lowers the cost of a statement and queues it.
+    void reach(const int indx, const int cost, const int supporter) noexcept;
+
+    /// @brief Reaches the statements added by an action.
+    void fire(const int actionIndx, const int cost) noexcept;
+
+    /// @brief Calculates the cost of the goal in the delete relaxation of the
+    ///        problem, using the generalized Dijkstra algorithm. Statements
+    ///        are reached in the order of their costs, and an action fires
+    ///        when the counter of its unreached preconditions drops to zero.
+    /// @tparam MAX If `true`, the costs are combined by `max` (h_max,
+    ///         admissible), otherwise by `+` (h_add).
+    template<bool MAX>
+    int calcRelaxedHeuristic(const BitState& state) noexcept;
+
+    /// @brief Calculates the FF heuristic: the number of actions in a relaxed
+    ///        plan, extracted backwards from the goal statements along the
+    ///        best supporters of the h_add pass.
+    int calcFFHeuristic(const BitState& state) noexcept;
+
+    /// @brief Calculates the landmark-count heuristic. A landmark is accepted
+    ///        when it is true and all the landmarks ordered before it were
+    ///        accepted in the parent node. Accepted landmarks remain accepted.
+    ///        The heuristic value is the number of the landmarks that are not
+    ///        accepted, plus the number of the accepted landmarks that are
+    ///        false and required again (goals, or ordered before a landmark
+    ///        that isn't accepted yet).
+    /// @param state The state.
+    /// @param parentSet The accepted set of the parent node, or `-1` for the
+    ///        initial node.
+    /// @param acceptedSet Receives the accepted set of the node.
+    int calcLandmarkHeuristic(
+            const BitState& state,
+            const int parentSet,
+            int& acceptedSet
+            ) noexcept;
+
+public:
+    static const int INF = std::numeric_limits<int>::max();
+
+    HeuristicCalculator(
+            const QuestPtr& quest,
+            const ID goalIndx,
+            const QuestSettings& settings,
+            const LandmarkGraphPtr& landmarks,
+            const PatternDatabasePtr& patternDatabase,
+            HeuristicCache* const cache
+            ) noexcept;
+
+    /// @brief Calculates the `h()` value of a given state.
+    /// @return Returns `INF` if the goal is unreachable from the state.
+    int calculate(const BitStatePtr& state) noexcept;
+
+    /// @brief Calculates the `h()` value of a given state, reached from the
+    ///        parent node. Path-dependent heuristics (LANDMARKS) use the
+    ///        parent's landmarks, other heuristics ignore them and use the
+    ///        heuristic cache, if any.
+    /// @param state The state.
+    /// @param parentLandmarks The `landmarks` field of the parent node, or
+    ///        `-1` for the initial node.
+    /// @param landmarks Receives the `landmarks` field of the node.
+    /// @return Returns `INF` if the goal is unreachable from the state.
+    int calculate(
+            const BitStatePtr& state,
+            const int parentLandmarks,
+            int& landmarks
+            ) noexcept;
+
+    /// @brief Collects the preferred operators of a state: the actions of
+    ///        the relaxed plan of the last FF calculation (of this state)
+    ///        that are applicable in the state.
+    void collectPreferredActions(
+            const BitState& state,
+            Vector<int>& preferredActions
+            ) const noexcept;
+};
+
+}
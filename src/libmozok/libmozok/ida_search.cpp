@@ -0,0 +1,228 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/ida_search.hpp>
+#include <libmozok/quest_planner.hpp>
+#include <libmozok/search_node.hpp>
+
+namespace mozok {
+
+bool IDAActionsIterator::isOnPath(
+        const BitState::Word* remMask,
+        const BitState::Word* addMask,
+        const Fingerprint& fingerprint
+        ) const noexcept {
+    for(const IDAFrame& frame : _path)
+        if(frame.state->getFingerprint() == fingerprint 
+                && (_settings.fingerprintOnly || _state->isEqualApplied(
+                    *frame.state, remMask, addMask)))
+            return true;
+    return false;
+}
+
+IDAActionsIterator::IDAActionsIterator(
+        const Quest& quest,
+        const Vector<IDAFrame>& path,
+        const QuestSettings& settings,
+        HeuristicCalculator& heuristic,
+        BitStateMap<int>* table,
+        Vector<IDAChild>& children
+        ) noexcept :
+    _quest(quest),
+    _path(path),
+    _state(path.back().state),
+    _gScore(path.back().gScore),
+    _settings(settings),
+    _heuristic(heuristic),
+    _table(table),
+    _children(children)
+{ /* empty */ }
+
+bool IDAActionsIterator::possibleActionCallback(
+        const SIZE_T possibleActionIndx) noexcept {
+    const BitState::Word* remMask = 
+            _quest.getActionRemMask(possibleActionIndx);
+    const BitState::Word* addMask = 
+            _quest.getActionAddMask(possibleActionIndx);
+    const Fingerprint fingerprint = _state->getAppliedFingerprint(
+            remMask, addMask, _quest.getStatementKeys());
+    if(isOnPath(remMask, addMask, fingerprint))
+        return true;
+    const int gScore = _gScore + 1;
+    int* const tableScore = _table == nullptr ? nullptr 
+            : _table->findApplied(*_state, remMask, addMask, fingerprint);
+    if(tableScore != nullptr) {
+        if(*tableScore <= gScore)
+            return true;
+        *tableScore = gScore;
+    }
+
+    BitStatePtr newState = makeShared<BitState>(*_state);
+    newState->apply(remMask, addMask, _quest.getStatementKeys());
+
+    // The accepted landmark sets of the path-dependent LANDMARKS 
+    // heuristic grow with every calculation, so only the landmarks of 
+    // the state are used.
+    int landmarks = -1;
+    const int h_value = _settings.heuristic == QuestHeuristic::LANDMARKS
+            ? _heuristic.calculate(newState)
+            : _heuristic.calculate(newState, -1, landmarks);
+    if(h_value == HeuristicCalculator::INF)
+        return true;
+
+    if(_table != nullptr && tableScore == nullptr 
+            && _table->size() < SIZE_T(_settings.idaTableSize))
+        _table->insert(newState, gScore);
+    _children.push_back({h_value, int(possibleActionIndx), newState});
+    return true;
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_IDA(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const BitState& goalMask = quest.getGoalMask(SIZE_T(goalIndx));
+
+    HeuristicCache* const cache = _quest->getHeuristicCache(goalIndx);
+    HeuristicCalculator heuristic(
+            _quest->getQuest(), goalIndx, settings, 
+            _quest->getLandmarks(goalIndx), 
+            _quest->getPatternDatabase(goalIndx),
+            cache);
+    int bound = heuristic.calculate(_givenBitState);
+    if(bound == HeuristicCalculator::INF)
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+
+    // The nodes of the current path. The successors of a node are generated 
+    // when the node is pushed, so `storedStates` is the number of the states 
+    // kept in memory.
+    Vector<IDAFrame> path;
+    SIZE_T storedStates = 0;
+    int searchStep = 0;
+
+    // Every iteration is a depth-first search that visits the nodes with 
+    // `f = g + h <= bound`. The next bound is the lowest `f` that exceeded 
+    // the current one.
+    while(true) {
+        BitStateMap<int> table(settings.fingerprintOnly);
+        BitStateMap<int>* const tablePtr = 
+                settings.idaTableSize > 0 ? &table : nullptr;
+        int nextBound = HeuristicCalculator::INF;
+        path.clear();
+        storedStates = 0;
+        path.push_back({_givenBitState, 0, -1, Vector<IDAChild>(), 0});
+        if(tablePtr != nullptr)
+            table.insert(_givenBitState, 0);
+        bool isExpanded = false;
+
+        while(path.empty() == false) {
+            if(isExpanded == false) {
+                // Generate the successors of the last node of the path.
+                if(cancelFlag != nullptr && cancelFlag->isCancelled())
+                    // The result of this search is no longer needed.
+                    return makeShared<QuestPlan>(
+                            _givenSubstateId, _givenState, 
+                            _quest->getQuest(), goalIndx, 
+                            MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+
+                ++searchStep;
+                const bool isSearchLimitReached = 
+                        searchStep > settings.searchLimit;
+                const bool isSpaceLimitReached = 
+                        int(storedStates) > settings.spaceLimit;
+                const bool isTimeLimitReached = 
+                        _deadline.isReached(searchStep);
+                if(isSearchLimitReached || isSpaceLimitReached 
+                        || isTimeLimitReached) {
+                    if(isSearchLimitReached)
+                        messageProcessor.onSearchLimitReached(
+                            worldName, _quest->getQuest()->getName(), 
+                            settings.searchLimit);
+                    if(isSpaceLimitReached)
+                        messageProcessor.onSpaceLimitReached(
+                            worldName, _quest->getQuest()->getName(), 
+                            settings.spaceLimit);
+                    if(isTimeLimitReached)
+                        messageProcessor.onTimeLimitReached(
+                            worldName, _quest->getQuest()->getName(), 
+                            settings.timeLimitUs);
+                    return makeShared<QuestPlan>(
+                            _givenSubstateId, _givenState, 
+                            _quest->getQuest(), goalIndx, 
+                            MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+                }
+
+                IDAFrame& frame = path.back();
+                IDAActionsIterator it(
+                        quest, path, settings, heuristic, tablePtr, 
+                        frame.children);
+                quest.iterateOverApplicableActions(*frame.state, it);
+                std::stable_sort(frame.children.begin(), frame.children.end(), 
+                        [](const IDAChild& a, const IDAChild& b) {
+                    return a.hScore < b.hScore;
+                });
+                storedStates += frame.children.size();
+                isExpanded = true;
+            }
+
+            IDAFrame& frame = path.back();
+            if(frame.nextChild == frame.children.size()) {
+                // All the successors are visited, backtrack.
+                storedStates -= frame.children.size();
+                path.pop_back();
+                continue;
+            }
+            const IDAChild& child = frame.children[frame.nextChild++];
+            const int fScore = frame.gScore + 1 + child.hScore;
+            if(fScore > bound) {
+                // The successors are ordered by `h()`, so the rest of them 
+                // exceed the bound too.
+                nextBound = std::min(nextBound, fScore);
+                frame.nextChild = frame.children.size();
+                continue;
+            }
+            path.push_back({
+                    child.state, frame.gScore + 1, child.actionIndx, 
+                    Vector<IDAChild>(), 0});
+            if(path.back().state->hasSubstate(goalMask))
+                break;
+            isExpanded = false;
+        }
+
+        if(path.empty() == false)
+            // The goal is found.
+            break;
+        if(nextBound == HeuristicCalculator::INF)
+            // No node exceeded the bound: the whole graph has been visited.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+        bound = nextBound;
+    }
+
+    const int planLength = path.back().gScore;
+    const bool isExact = isOptimalSearch(settings);
+    Vector<int> actionIndices;
+    actionIndices.reserve(SIZE_T(planLength));
+    for(const IDAFrame& frame : path) {
+        if(frame.actionIndx >= 0)
+            actionIndices.push_back(frame.actionIndx);
+        if(cache != nullptr && isExact)
+            // Every state on the plan gets the remaining length of the plan.
+            // The lengths of other plans are not on the scale of the 
+            // heuristic, so the cached `h()` values are left alone.
+            cache->insertExact(
+                    frame.state->getFingerprint(), planLength - frame.gScore);
+    }
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_REACHABLE, 
+            makePlanActions(quest, actionIndices), actionIndices);
+}
+
+}
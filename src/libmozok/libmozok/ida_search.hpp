@@ -0,0 +1,84 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+#include <libmozok/quest_manager.hpp>
+#include <libmozok/heuristic_calculator.hpp>
+
+namespace mozok {
+
+/// @brief A successor of a node on the path of the `IDA` search.
+struct IDAChild {
+    /// @brief The `h()` value of the successor.
+    int hScore;
+
+    /// @brief Index of the possible action that leads to the successor.
+    int actionIndx;
+
+    /// @brief The state of the successor.
+    BitStatePtr state;
+};
+
+/// @brief A node on the path of the `IDA` search. Only the nodes of the 
+///        current path and their successors are kept in memory.
+struct IDAFrame {
+    /// @brief Node state.
+    BitStatePtr state;
+
+    /// @brief Length of the path to this node.
+    int gScore;
+
+    /// @brief Index of the possible action that leads to this node 
+    ///     (`-1` for the initial node).
+    int actionIndx;
+
+    /// @brief Successors of the node, in the order of their `h()` values.
+    Vector<IDAChild> children;
+
+    /// @brief The next successor to visit.
+    SIZE_T nextChild;
+};
+
+/// @brief A callback class for the `Quest::iterateOverApplicableActions(...)`.
+/// Generates the successors of the last node on the path of the `IDA` 
+/// search. Successors whose states are already on the path, or were reached 
+/// by a path that isn't longer (the transposition table), are skipped.
+class IDAActionsIterator : public QuestPossibleActionsIterator {
+    const Quest& _quest;
+    const Vector<IDAFrame>& _path;
+    const BitStatePtr _state;
+    const int _gScore;
+    const QuestSettings& _settings;
+    HeuristicCalculator& _heuristic;
+    /// @brief The transposition table (`nullptr` if it isn't used). Maps the 
+    ///        states to the length of the shortest path found so far.
+    BitStateMap<int>* const _table;
+    Vector<IDAChild>& _children;
+
+    /// @brief Checks if the state that `_state.apply(...)` would produce is 
+    ///        already on the path.
+    bool isOnPath(
+            const BitState::Word* remMask,
+            const BitState::Word* addMask,
+            const Fingerprint& fingerprint
+            ) const noexcept;
+
+public:
+    IDAActionsIterator(
+            const Quest& quest,
+            const Vector<IDAFrame>& path,
+            const QuestSettings& settings,
+            HeuristicCalculator& heuristic,
+            BitStateMap<int>* table,
+            Vector<IDAChild>& children
+            ) noexcept;
+
+    bool possibleActionCallback(const SIZE_T possibleActionIndx) noexcept;
+};
+
+}
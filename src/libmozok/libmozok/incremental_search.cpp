@@ -0,0 +1,176 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/incremental_search.hpp>
+#include <libmozok/quest_planner.hpp>
+#include <libmozok/search_node.hpp>
+
+namespace mozok {
+
+SearchGraphActionsIterator::SearchGraphActionsIterator(
+        const Quest& quest,
+        SearchGraph& graph,
+        const SIZE_T nodeIndx,
+        HeuristicCalculator& heuristic
+        ) noexcept :
+    _quest(quest),
+    _graph(graph),
+    _nodeIndx(nodeIndx),
+    _state(graph[nodeIndx].state),
+    _heuristic(heuristic)
+{ /* empty */ }
+
+bool SearchGraphActionsIterator::possibleActionCallback(
+        const SIZE_T possibleActionIndx) noexcept {
+    const BitState::Word* remMask = 
+            _quest.getActionRemMask(possibleActionIndx);
+    const BitState::Word* addMask = 
+            _quest.getActionAddMask(possibleActionIndx);
+    const Fingerprint fingerprint = _state->getAppliedFingerprint(
+            remMask, addMask, _quest.getStatementKeys());
+    int nextIndx = _graph.findApplied(
+            *_state, remMask, addMask, fingerprint);
+    if(nextIndx < 0) {
+        BitStatePtr newState = makeShared<BitState>(*_state);
+        newState->apply(remMask, addMask, _quest.getStatementKeys());
+        // The states with the infinite `h()` are kept too, so they are 
+        // not evaluated again.
+        nextIndx = _graph.add(newState, _heuristic.calculate(newState));
+    }
+    _graph.addEdge(_nodeIndx, {int(possibleActionIndx), nextIndx});
+    return true;
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_Incremental(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const BitState& goalMask = quest.getGoalMask(SIZE_T(goalIndx));
+    SearchGraph& graph = *_quest->getSearchGraph(goalIndx);
+    HeuristicCalculator heuristic(
+            _quest->getQuest(), goalIndx, settings, 
+            _quest->getLandmarks(goalIndx), 
+            _quest->getPatternDatabase(goalIndx),
+            nullptr);
+
+    // The start state is usually known from the previous searches.
+    int startIndx = graph.find(*_givenBitState);
+    if(startIndx < 0)
+        startIndx = graph.add(
+                _givenBitState, heuristic.calculate(_givenBitState));
+
+    graph.startSearch();
+    graph.reach(SIZE_T(startIndx), 0, -1, -1);
+    OpenNodeCmp cmpObj(&openNodeCmp_AStar);
+    OpenNodeQueue openSet(cmpObj);
+    if(graph[SIZE_T(startIndx)].h != HeuristicCalculator::INF)
+        openSet.push({graph[SIZE_T(startIndx)].h, 0, SIZE_T(startIndx)});
+
+    // Expanded nodes of this search.
+    Vector<SIZE_T> closedNodes;
+    int finalNode = -1;
+    int searchStep = 0;
+
+    while(openSet.size() > 0) {
+        if(cancelFlag != nullptr && cancelFlag->isCancelled())
+            // The result of this search is no longer needed.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+
+        const OpenNode openNode = openSet.top();
+        openSet.pop();
+        const SIZE_T nodeIndx = openNode.nodeIndx;
+        if(graph[nodeIndx].isClosed || openNode.gScore > graph[nodeIndx].g)
+            continue; // outdated entry
+
+        ++searchStep;
+        const bool isSearchLimitReached = 
+                searchStep > settings.searchLimit;
+        const bool isSpaceLimitReached = 
+                int(openSet.size()) > settings.spaceLimit;
+        const bool isTimeLimitReached = _deadline.isReached(searchStep);
+        if(isSearchLimitReached || isSpaceLimitReached 
+                || isTimeLimitReached) {
+            // The expanded part of the graph is kept for the next search.
+            if(isSearchLimitReached)
+                messageProcessor.onSearchLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.searchLimit);
+            if(isSpaceLimitReached)
+                messageProcessor.onSpaceLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.spaceLimit);
+            if(isTimeLimitReached)
+                messageProcessor.onTimeLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.timeLimitUs);
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+        }
+
+        graph[nodeIndx].isClosed = true;
+        closedNodes.push_back(nodeIndx);
+        if(graph[nodeIndx].state->hasSubstate(goalMask)) {
+            finalNode = int(nodeIndx);
+            break;
+        }
+
+        // The successors of a node are generated only once.
+        if(graph[nodeIndx].firstEdge < 0) {
+            const BitStatePtr state = graph[nodeIndx].state;
+            SearchGraphActionsIterator it(quest, graph, nodeIndx, heuristic);
+            quest.iterateOverApplicableActions(*state, it);
+            graph.setExpanded(nodeIndx);
+        }
+
+        const int gScore = graph[nodeIndx].g + 1;
+        const int firstEdge = graph[nodeIndx].firstEdge;
+        const int lastEdge = firstEdge + graph[nodeIndx].edgeCount;
+        for(int e = firstEdge; e < lastEdge; ++e) {
+            const SearchGraph::Edge& edge = graph.getEdges()[SIZE_T(e)];
+            const SIZE_T nextIndx = SIZE_T(edge.node);
+            const SearchGraph::Node& next = graph[nextIndx];
+            if(next.h == HeuristicCalculator::INF)
+                // Goal is unreachable from this state.
+                continue;
+            if(graph.isReached(nextIndx) 
+                    && (next.isClosed || next.g <= gScore))
+                continue;
+            graph.reach(nextIndx, gScore, int(nodeIndx), edge.actionIndx);
+            openSet.push({gScore + next.h, gScore, nextIndx});
+        }
+    }
+
+    if(finalNode < 0)
+        // Goal is unreachable.
+        return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+
+    // Adaptive A*: the goal distance of an expanded node is at least 
+    // `g(goal) - g(node)`. The raised values keep the heuristic consistent 
+    // (if it was consistent), and focus the next searches on the plan.
+    const int planLength = graph[SIZE_T(finalNode)].g;
+    for(const SIZE_T nodeIndx : closedNodes) {
+        SearchGraph::Node& node = graph[nodeIndx];
+        node.h = std::max(node.h, planLength - node.g);
+    }
+
+    Vector<int> actionIndices(SIZE_T(planLength), -1);
+    for(int nodeIndx = finalNode; graph[SIZE_T(nodeIndx)].parent >= 0; 
+            nodeIndx = graph[SIZE_T(nodeIndx)].parent) {
+        const SearchGraph::Node& node = graph[SIZE_T(nodeIndx)];
+        actionIndices[SIZE_T(node.g - 1)] = node.actionIndx;
+    }
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_REACHABLE, 
+            makePlanActions(quest, actionIndices), actionIndices);
+}
+
+}
@@ -0,0 +1,38 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+#include <libmozok/search_graph.hpp>
+#include <libmozok/heuristic_calculator.hpp>
+
+namespace mozok {
+
+/// @brief A callback class for the `Quest::iterateOverApplicableActions(...)`.
+/// Expands a node of the incremental search graph: adds the edges of the 
+/// node and the nodes of the new successor states.
+class SearchGraphActionsIterator : 
+        public QuestPossibleActionsIterator {
+    const Quest& _quest;
+    SearchGraph& _graph;
+    const SIZE_T _nodeIndx;
+    // Copied, because new nodes can grow the graph.
+    const BitStatePtr _state;
+    HeuristicCalculator& _heuristic;
+
+public:
+    SearchGraphActionsIterator(
+            const Quest& quest,
+            SearchGraph& graph,
+            const SIZE_T nodeIndx,
+            HeuristicCalculator& heuristic
+            ) noexcept;
+
+    bool possibleActionCallback(const SIZE_T possibleActionIndx) noexcept;
+};
+
+}
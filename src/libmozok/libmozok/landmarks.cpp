@@ -0,0 +1,179 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/landmarks.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace mozok {
+
+namespace {
+
+/// @brief Marks the statements that are reachable from the initial state in
+///        the delete relaxation of the quest, without using the actions that
+///        add the `excluded` statement.
+/// @param quest The quest.
+/// @param initialState The initial state.
+/// @param excluded Dense index of the excluded statement.
+/// @param reachable Receives `1` for every reachable statement.
+void markReachable(
+        const Quest& quest,
+        const BitState& initialState,
+        const int excluded,
+        Vector<char>& reachable
+        ) noexcept {
+    const SIZE_T actionCount = quest.getPossibleActions().size();
+    Vector<int> unsatisfied(actionCount);
+    Vector<int> open;
+    reachable.assign(quest.getStatementCount(), 0);
+
+    const auto fire = [&](const SIZE_T actionIndx) {
+        const IndxRange addList = quest.getActionAddList(actionIndx);
+        if(std::find(addList.begin(), addList.end(), excluded)
+                != addList.end())
+            return;
+        for(const int indx : addList)
+            if(reachable[indx] == 0) {
+                reachable[indx] = 1;
+                open.push_back(indx);
+            }
+    };
+
+    BitState::forEachBit(
+            initialState.getWords(), initialState.getWordCount(),
+            [&](const SIZE_T indx) {
+        reachable[indx] = 1;
+        open.push_back(int(indx));
+    });
+    for(SIZE_T i = 0; i < actionCount; ++i) {
+        unsatisfied[i] = int(quest.getActionPreList(i).size());
+        if(unsatisfied[i] == 0)
+            fire(i);
+    }
+    while(open.empty() == false) {
+        const int indx = open.back();
+        open.pop_back();
+        for(const int actionIndx : quest.getStatementPreActions(SIZE_T(indx)))
+            if(--unsatisfied[actionIndx] == 0)
+                fire(SIZE_T(actionIndx));
+    }
+}
+
+}
+
+int LandmarkGraph::addLandmark(
+        HashMap<int, int>& statementToLandmark,
+        const int statementIndx
+        ) noexcept {
+    const auto it = statementToLandmark.find(statementIndx);
+    if(it != statementToLandmark.end())
+        return it->second;
+    const int landmark = int(_statements.size());
+    statementToLandmark[statementIndx] = landmark;
+    _statements.push_back(statementIndx);
+    _predecessors.push_back({});
+    _successors.push_back({});
+    _isGoal.push_back(0);
+    return landmark;
+}
+
+LandmarkGraph::LandmarkGraph(
+        const Quest& quest,
+        const SIZE_T goalIndx,
+        const BitState& initialState
+        ) noexcept {
+    const SIZE_T actionCount = quest.getPossibleActions().size();
+
+    // achievers[i] = {actions that add the i-th statement}
+    Vector<Vector<int>> achievers(quest.getStatementCount());
+    for(SIZE_T i = 0; i < actionCount; ++i)
+        for(const int indx : quest.getActionAddList(i))
+            achievers[indx].push_back(int(i));
+
+    HashMap<int, int> statementToLandmark;
+    Vector<int> open;
+    const BitState& goalMask = quest.getGoalMask(goalIndx);
+    BitState::forEachBit(goalMask.getWords(), goalMask.getWordCount(),
+            [&](const SIZE_T indx) {
+        const int landmark = addLandmark(statementToLandmark, int(indx));
+        _isGoal[landmark] = 1;
+        open.push_back(int(indx));
+    });
+
+    Vector<char> reachable;
+    Vector<int> shared;
+    Vector<int> intersection;
+    while(open.empty() == false) {
+        const int indx = open.back();
+        open.pop_back();
+        if(initialState.hasBit(SIZE_T(indx)))
+            continue;
+
+        // Preconditions shared by all the first achievers.
+        markReachable(quest, initialState, indx, reachable);
+        bool isFirst = true;
+        for(const int actionIndx : achievers[indx]) {
+            const IndxRange preList = quest.getActionPreList(SIZE_T(actionIndx));
+            bool isApplicable = true;
+            for(const int preIndx : preList)
+                if(reachable[preIndx] == 0) {
+                    isApplicable = false;
+                    break;
+                }
+            if(isApplicable == false)
+                continue;
+            if(isFirst) {
+                shared.assign(preList.begin(), preList.end());
+                isFirst = false;
+                continue;
+            }
+            // Precondition lists are sorted.
+            intersection.clear();
+            std::set_intersection(
+                    shared.begin(), shared.end(),
+                    preList.begin(), preList.end(),
+                    std::back_inserter(intersection));
+            shared.swap(intersection);
+            if(shared.empty())
+                break;
+        }
+        if(isFirst)
+            // No first achievers: the statement is unreachable.
+            continue;
+
+        const int landmark = statementToLandmark[indx];
+        for(const int preIndx : shared) {
+            const bool isNew =
+                    statementToLandmark.find(preIndx) == statementToLandmark.end();
+            const int preLandmark = addLandmark(statementToLandmark, preIndx);
+            _predecessors[landmark].push_back(preLandmark);
+            _successors[preLandmark].push_back(landmark);
+            if(isNew)
+                open.push_back(preIndx);
+        }
+    }
+}
+
+SIZE_T LandmarkGraph::size() const noexcept {
+    return _statements.size();
+}
+
+int LandmarkGraph::getStatementIndx(const SIZE_T landmark) const noexcept {
+    return _statements[landmark];
+}
+
+const Vector<int>& LandmarkGraph::getPredecessors(
+        const SIZE_T landmark) const noexcept {
+    return _predecessors[landmark];
+}
+
+const Vector<int>& LandmarkGraph::getSuccessors(
+        const SIZE_T landmark) const noexcept {
+    return _successors[landmark];
+}
+
+bool LandmarkGraph::isGoal(const SIZE_T landmark) const noexcept {
+    return _isGoal[landmark] != 0;
+}
+
+}
@@ -0,0 +1,74 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+
+namespace mozok {
+
+class LandmarkGraph;
+using LandmarkGraphPtr = SharedPtr<const LandmarkGraph>;
+
+/// @brief Fact landmarks of a quest goal and their orderings.
+/// A landmark is a statement that must be true at some point of every plan
+/// that achieves the goal. All the goal statements are landmarks. Other
+/// landmarks are found by back-chaining from the goal through the relaxed
+/// planning graph: the statements that are preconditions of all the "first
+/// achievers" of a landmark (the actions that can add it before the landmark
+/// is reached for the first time) are landmarks too, and they are ordered
+/// before it (greedy-necessary ordering).
+/// The graph is used by the landmark-count heuristic (`LANDMARKS`).
+class LandmarkGraph {
+    /// @brief `_statements[i]` is the dense statement index (see
+    ///        `Quest::getStatementIndx()`) of the i-th landmark.
+    Vector<int> _statements;
+
+    /// @brief `_predecessors[i]` are the landmarks ordered before the i-th one.
+    Vector<Vector<int>> _predecessors;
+
+    /// @brief `_successors[i]` are the landmarks ordered after the i-th one.
+    Vector<Vector<int>> _successors;
+
+    /// @brief `_isGoal[i]` is `1` if the i-th landmark is a goal statement.
+    Vector<char> _isGoal;
+
+    /// @brief Returns the landmark of the statement. Adds a new landmark if
+    ///        needed.
+    int addLandmark(
+            HashMap<int, int>& statementToLandmark,
+            const int statementIndx
+            ) noexcept;
+
+public:
+    /// @brief Builds the landmark graph.
+    /// @param quest The quest.
+    /// @param goalIndx The quest goal.
+    /// @param initialState The state from which the relaxed planning graph
+    ///        is built.
+    LandmarkGraph(
+            const Quest& quest,
+            const SIZE_T goalIndx,
+            const BitState& initialState
+            ) noexcept;
+
+    /// @brief Returns the number of landmarks.
+    SIZE_T size() const noexcept;
+
+    /// @brief Returns the dense statement index of the landmark.
+    int getStatementIndx(const SIZE_T landmark) const noexcept;
+
+    /// @brief Returns the landmarks ordered before the landmark.
+    const Vector<int>& getPredecessors(const SIZE_T landmark) const noexcept;
+
+    /// @brief Returns the landmarks ordered after the landmark.
+    const Vector<int>& getSuccessors(const SIZE_T landmark) const noexcept;
+
+    /// @brief Checks if the landmark is a goal statement.
+    bool isGoal(const SIZE_T landmark) const noexcept;
+};
+
+}
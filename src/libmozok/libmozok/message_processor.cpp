@@ -131,4 +131,55 @@ void MessageProcessor::onSpaceLimitReached(
         ) noexcept
 { /* empty */ }
 
+void MessageProcessor::onTimeLimitReached(
+        const mozok::Str& /*worldName*/,
+        const mozok::Str& /*questName*/,
+        const int /*timeLimitValue*/
+        ) noexcept
+{ /* empty */ }
+
+void MessageProcessor::onPortfolioWinner(
+        const mozok::Str& /*worldName*/,
+        const mozok::Str& /*questName*/,
+        const mozok::Str& /*heuristic*/,
+        const mozok::Str& /*strategy*/
+        ) noexcept
+{ /* empty */ }
+
+void MessageProcessor::onLandmarksFound(
+        const mozok::Str& /*worldName*/,
+        const mozok::Str& /*questName*/,
+        const int /*goalIndx*/,
+        const int /*landmarkCount*/
+        ) noexcept
+{ /* empty */ }
+
+void MessageProcessor::onPatternDatabaseBuilt(
+        const mozok::Str& /*worldName*/,
+        const mozok::Str& /*questName*/,
+        const int /*goalIndx*/,
+        const int /*patternCount*/,
+        const int /*memory*/,
+        const int /*buildTimeUs*/,
+        const int /*lookupTimeNs*/
+        ) noexcept
+{ /* empty */ }
+
+void MessageProcessor::onHeuristicCacheStats(
+        const mozok::Str& /*worldName*/,
+        const mozok::Str& /*questName*/,
+        const int /*hits*/,
+        const int /*misses*/
+        ) noexcept
+{ /* empty */ }
+
+void MessageProcessor::onPlanRepairStats(
+        const mozok::Str& /*worldName*/,
+        const mozok::Str& /*questName*/,
+        const int /*reused*/,
+        const int /*repaired*/,
+        const int /*searched*/
+        ) noexcept
+{ /* empty */ }
+
 }
@@ -187,6 +187,98 @@ public:
         const int spaceLimitValue
         ) noexcept;
 
+    /// @brief A time limit was reached during a quest planning.
+    /// @param worldName The name of the world from which this message was sent.
+    /// @param questName The name of the quest.
+    /// @param timeLimitValue The time limit value in microseconds.
+    virtual void onTimeLimitReached(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int timeLimitValue
+        ) noexcept;
+
+    /// @brief Triggered when a portfolio search (`strategy PORTFOLIO`) was 
+    ///        decided by one of the raced planner configurations.
+    /// @param worldName The name of the world from which this message was sent.
+    /// @param questName The name of the quest.
+    /// @param heuristic The heuristic of the winning configuration 
+    ///        (as in the `heuristic` quest option, e.g. `HSP`).
+    /// @param strategy The search strategy of the winning configuration 
+    ///        (as in the `strategy` quest option, e.g. `ASTAR`).
+    virtual void onPortfolioWinner(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const mozok::Str& heuristic,
+        const mozok::Str& strategy
+        ) noexcept;
+
+    /// @brief Triggered when the landmarks of a quest goal were generated 
+    ///        (`heuristic LANDMARKS`). The landmarks are generated once per 
+    ///        goal, on the first planning of the quest.
+    /// @param worldName The name of the world from which this message was sent.
+    /// @param questName The name of the quest.
+    /// @param goalIndx The index of the goal.
+    /// @param landmarkCount The number of the landmarks found for the goal.
+    virtual void onLandmarksFound(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int goalIndx,
+        const int landmarkCount
+        ) noexcept;
+
+    /// @brief Triggered when the pattern database of a quest goal was built 
+    ///        (`heuristic PDB`). The databases are built once per goal, on 
+    ///        the first planning of the quest. A build that doesn't fit into 
+    ///        the planning time limit is continued by the next plannings.
+    /// @param worldName The name of the world from which this message was sent.
+    /// @param questName The name of the quest.
+    /// @param goalIndx The index of the goal.
+    /// @param patternCount The number of the patterns.
+    /// @param memory The size of the tables in bytes.
+    /// @param buildTimeUs The build time in microseconds.
+    /// @param lookupTimeNs The average lookup time in nanoseconds.
+    virtual void onPatternDatabaseBuilt(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int goalIndx,
+        const int patternCount,
+        const int memory,
+        const int buildTimeUs,
+        const int lookupTimeNs
+        ) noexcept;
+
+    /// @brief Triggered after every planning of a quest that uses the 
+    ///        heuristic cache (see `heuristicCacheSize`).
+    /// @param worldName The name of the world from which this message was sent.
+    /// @param questName The name of the quest.
+    /// @param hits The number of the cache hits of all the quest goals during 
+    ///        this planning.
+    /// @param misses The number of the cache misses during this planning.
+    virtual void onHeuristicCacheStats(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int hits,
+        const int misses
+        ) noexcept;
+
+    /// @brief Triggered after every replanning of a quest that had a 
+    ///        reachable plan (see `repairLimit`).
+    /// @param worldName The name of the world from which this message was sent.
+    /// @param questName The name of the quest.
+    /// @param reused The total number of the replannings that reused a 
+    ///        suffix of the last plan.
+    /// @param repaired The total number of the replannings resolved by the 
+    ///        local repair of the last plan.
+    /// @param searched The total number of the replannings that needed the 
+    ///        full search.
+    virtual void onPlanRepairStats(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int reused,
+        const int repaired,
+        const int searched
+        ) noexcept;
+
 };
 
 }
@@ -149,6 +149,76 @@ void MessageQueue::onSpaceLimitReached(
     pushMessage(msg);
 }
 
+void MessageQueue::onTimeLimitReached(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int timeLimitValue
+        ) noexcept {
+    MessagePtr msg = makeShared<OnTimeLimitReached>(
+            worldName, questName, timeLimitValue);
+    pushMessage(msg);
+}
+
+void MessageQueue::onPortfolioWinner(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const mozok::Str& heuristic,
+        const mozok::Str& strategy
+        ) noexcept {
+    MessagePtr msg = makeShared<OnPortfolioWinner>(
+            worldName, questName, heuristic, strategy);
+    pushMessage(msg);
+}
+
+void MessageQueue::onLandmarksFound(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int goalIndx,
+        const int landmarkCount
+        ) noexcept {
+    MessagePtr msg = makeShared<OnLandmarksFound>(
+            worldName, questName, goalIndx, landmarkCount);
+    pushMessage(msg);
+}
+
+void MessageQueue::onPatternDatabaseBuilt(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int goalIndx,
+        const int patternCount,
+        const int memory,
+        const int buildTimeUs,
+        const int lookupTimeNs
+        ) noexcept {
+    MessagePtr msg = makeShared<OnPatternDatabaseBuilt>(
+            worldName, questName, goalIndx, patternCount, memory, 
+            buildTimeUs, lookupTimeNs);
+    pushMessage(msg);
+}
+
+void MessageQueue::onHeuristicCacheStats(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int hits,
+        const int misses
+        ) noexcept {
+    MessagePtr msg = makeShared<OnHeuristicCacheStats>(
+            worldName, questName, hits, misses);
+    pushMessage(msg);
+}
+
+void MessageQueue::onPlanRepairStats(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int reused,
+        const int repaired,
+        const int searched
+        ) noexcept {
+    MessagePtr msg = makeShared<OnPlanRepairStats>(
+            worldName, questName, reused, repaired, searched);
+    pushMessage(msg);
+}
+
 
 // ============================= MESSAGE LIST =============================== //
 
@@ -306,4 +376,125 @@ void OnSpaceLimitReached::process(
             _worldName, _questName, _spaceLimitValue);
 }
 
+
+OnTimeLimitReached::OnTimeLimitReached(
+        const Str& worldName, 
+        const Str& questName,
+        const int timeLimitValue
+        ) noexcept :
+    Message(worldName),
+    _questName(questName),
+    _timeLimitValue(timeLimitValue)
+{ /* empty */ }
+
+void OnTimeLimitReached::process(
+        MessageProcessor& messageProcessor) const noexcept {
+    messageProcessor.onTimeLimitReached(
+            _worldName, _questName, _timeLimitValue);
+}
+
+
+OnPortfolioWinner::OnPortfolioWinner(
+        const Str& worldName, 
+        const Str& questName,
+        const Str& heuristic,
+        const Str& strategy
+        ) noexcept :
+    Message(worldName),
+    _questName(questName),
+    _heuristic(heuristic),
+    _strategy(strategy)
+{ /* empty */ }
+
+void OnPortfolioWinner::process(
+        MessageProcessor& messageProcessor) const noexcept {
+    messageProcessor.onPortfolioWinner(
+            _worldName, _questName, _heuristic, _strategy);
+}
+
+
+OnLandmarksFound::OnLandmarksFound(
+        const Str& worldName, 
+        const Str& questName,
+        const int goalIndx,
+        const int landmarkCount
+        ) noexcept :
+    Message(worldName),
+    _questName(questName),
+    _goalIndx(goalIndx),
+    _landmarkCount(landmarkCount)
+{ /* empty */ }
+
+void OnLandmarksFound::process(
+        MessageProcessor& messageProcessor) const noexcept {
+    messageProcessor.onLandmarksFound(
+            _worldName, _questName, _goalIndx, _landmarkCount);
+}
+
+
+OnPatternDatabaseBuilt::OnPatternDatabaseBuilt(
+        const Str& worldName, 
+        const Str& questName,
+        const int goalIndx,
+        const int patternCount,
+        const int memory,
+        const int buildTimeUs,
+        const int lookupTimeNs
+        ) noexcept :
+    Message(worldName),
+    _questName(questName),
+    _goalIndx(goalIndx),
+    _patternCount(patternCount),
+    _memory(memory),
+    _buildTimeUs(buildTimeUs),
+    _lookupTimeNs(lookupTimeNs)
+{ /* empty */ }
+
+void OnPatternDatabaseBuilt::process(
+        MessageProcessor& messageProcessor) const noexcept {
+    messageProcessor.onPatternDatabaseBuilt(
+            _worldName, _questName, _goalIndx, _patternCount, _memory, 
+            _buildTimeUs, _lookupTimeNs);
+}
+
+
+OnHeuristicCacheStats::OnHeuristicCacheStats(
+        const Str& worldName, 
+        const Str& questName,
+        const int hits,
+        const int misses
+        ) noexcept :
+    Message(worldName),
+    _questName(questName),
+    _hits(hits),
+    _misses(misses)
+{ /* empty */ }
+
+void OnHeuristicCacheStats::process(
+        MessageProcessor& messageProcessor) const noexcept {
+    messageProcessor.onHeuristicCacheStats(
+            _worldName, _questName, _hits, _misses);
+}
+
+
+OnPlanRepairStats::OnPlanRepairStats(
+        const Str& worldName, 
+        const Str& questName,
+        const int reused,
+        const int repaired,
+        const int searched
+        ) noexcept :
+    Message(worldName),
+    _questName(questName),
+    _reused(reused),
+    _repaired(repaired),
+    _searched(searched)
+{ /* empty */ }
+
+void OnPlanRepairStats::process(
+        MessageProcessor& messageProcessor) const noexcept {
+    messageProcessor.onPlanRepairStats(
+            _worldName, _questName, _reused, _repaired, _searched);
+}
+
 }
@@ -113,6 +113,51 @@ public:
         const mozok::Str& questName,
         const int spaceLimitValue
         ) noexcept override;
+
+    void onTimeLimitReached(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int timeLimitValue
+        ) noexcept override;
+
+    void onPortfolioWinner(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const mozok::Str& heuristic,
+        const mozok::Str& strategy
+        ) noexcept override;
+
+    void onLandmarksFound(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int goalIndx,
+        const int landmarkCount
+        ) noexcept override;
+
+    void onPatternDatabaseBuilt(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int goalIndx,
+        const int patternCount,
+        const int memory,
+        const int buildTimeUs,
+        const int lookupTimeNs
+        ) noexcept override;
+
+    void onHeuristicCacheStats(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int hits,
+        const int misses
+        ) noexcept override;
+
+    void onPlanRepairStats(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int reused,
+        const int repaired,
+        const int searched
+        ) noexcept override;
 };
 
 
@@ -238,6 +283,100 @@ public:
     void process(MessageProcessor& messageProcessor) const noexcept override;
 };
 
+
+class OnTimeLimitReached : public Message {
+    const Str _questName;
+    const int _timeLimitValue;
+public:
+    OnTimeLimitReached(
+            const Str& worldName, 
+            const Str& questName,
+            const int timeLimitValue
+            ) noexcept;
+    void process(MessageProcessor& messageProcessor) const noexcept override;
+};
+
+
+class OnPortfolioWinner : public Message {
+    const Str _questName;
+    const Str _heuristic;
+    const Str _strategy;
+public:
+    OnPortfolioWinner(
+            const Str& worldName, 
+            const Str& questName,
+            const Str& heuristic,
+            const Str& strategy
+            ) noexcept;
+    void process(MessageProcessor& messageProcessor) const noexcept override;
+};
+
+
+class OnLandmarksFound : public Message {
+    const Str _questName;
+    const int _goalIndx;
+    const int _landmarkCount;
+public:
+    OnLandmarksFound(
+            const Str& worldName, 
+            const Str& questName,
+            const int goalIndx,
+            const int landmarkCount
+            ) noexcept;
+    void process(MessageProcessor& messageProcessor) const noexcept override;
+};
+
+
+class OnPatternDatabaseBuilt : public Message {
+    const Str _questName;
+    const int _goalIndx;
+    const int _patternCount;
+    const int _memory;
+    const int _buildTimeUs;
+    const int _lookupTimeNs;
+public:
+    OnPatternDatabaseBuilt(
+            const Str& worldName, 
+            const Str& questName,
+            const int goalIndx,
+            const int patternCount,
+            const int memory,
+            const int buildTimeUs,
+            const int lookupTimeNs
+            ) noexcept;
+    void process(MessageProcessor& messageProcessor) const noexcept override;
+};
+
+class OnHeuristicCacheStats : public Message {
+    const Str _questName;
+    const int _hits;
+    const int _misses;
+public:
+    OnHeuristicCacheStats(
+            const Str& worldName, 
+            const Str& questName,
+            const int hits,
+            const int misses
+            ) noexcept;
+    void process(MessageProcessor& messageProcessor) const noexcept override;
+};
+
+class OnPlanRepairStats : public Message {
+    const Str _questName;
+    const int _reused;
+    const int _repaired;
+    const int _searched;
+public:
+    OnPlanRepairStats(
+            const Str& worldName, 
+            const Str& questName,
+            const int reused,
+            const int repaired,
+            const int searched
+            ) noexcept;
+    void process(MessageProcessor& messageProcessor) const noexcept override;
+};
+
 /// @}
 
 }
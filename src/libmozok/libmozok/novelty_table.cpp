@@ -0,0 +1,56 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/novelty_table.hpp>
+
+namespace mozok {
+
+NoveltyTable::NoveltyTable(
+        const SIZE_T statementCount,
+        const int width
+        ) noexcept :
+    _statementCount(statementCount),
+    _width(width >= 2 && statementCount <= PAIR_STATEMENT_LIMIT ? 2 : 1),
+    _statements(statementCount, 0) {
+    if(_width == 2)
+        _pairs.assign(BitState::getWordCount(
+                statementCount * (statementCount - 1) / 2 + 1), 0);
+}
+
+int NoveltyTable::getWidth() const noexcept {
+    return _width;
+}
+
+bool NoveltyTable::insertPair(const SIZE_T p, const SIZE_T q) noexcept {
+    const SIZE_T indx = p < q ? q * (q - 1) / 2 + p : p * (p - 1) / 2 + q;
+    BitState::Word& word = _pairs[indx / BitState::WORD_BITS];
+    const BitState::Word bit = 
+            BitState::Word(1) << (indx % BitState::WORD_BITS);
+    if(word & bit)
+        return false;
+    word |= bit;
+    return true;
+}
+
+int NoveltyTable::update(
+        const BitState& state,
+        const Vector<int>& newStatements
+        ) noexcept {
+    int novelty = _width + 1;
+    for(const int p : newStatements)
+        if(_statements[SIZE_T(p)] == 0) {
+            _statements[SIZE_T(p)] = 1;
+            novelty = 1;
+        }
+    if(_width < 2)
+        return novelty;
+    for(const int p : newStatements)
+        BitState::forEachBit(
+                state.getWords(), state.getWordCount(),
+                [&](const SIZE_T q) {
+            if(q != SIZE_T(p) && insertPair(SIZE_T(p), q) && novelty > 2)
+                novelty = 2;
+        });
+    return novelty;
+}
+
+}
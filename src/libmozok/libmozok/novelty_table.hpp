@@ -0,0 +1,67 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/bit_state.hpp>
+
+namespace mozok {
+
+/// @brief The novelty table of the width-based searches (`IW`, `BFWS`).
+/// Records the statements and the pairs of statements (the tuples) that were
+/// true together in some recorded state. The novelty of a state is the size
+/// of the smallest tuple of the state that wasn't recorded before: `1` if
+/// the state has a new statement, `2` if it has a new pair of statements,
+/// and `width + 1` otherwise.
+/// The statements are the dense statement indices of the quest (see
+/// `Quest::getStatementCount()`). The table of the pairs takes `n^2 / 16`
+/// bytes, so the width `2` is used only for the quests with at most
+/// `PAIR_STATEMENT_LIMIT` statements.
+class NoveltyTable {
+public:
+    /// @brief The maximum number of statements for which the pairs are
+    ///        recorded.
+    static const SIZE_T PAIR_STATEMENT_LIMIT = 4096;
+
+private:
+    const SIZE_T _statementCount;
+    const int _width;
+
+    /// @brief The recorded statements.
+    Vector<char> _statements;
+
+    /// @brief The bits of the recorded pairs `(p, q)`, `p < q`, at the index
+    ///        `q * (q - 1) / 2 + p` (empty if the width is `1`).
+    Vector<BitState::Word> _pairs;
+
+    /// @brief Records the pair, returns `true` if it is new.
+    bool insertPair(const SIZE_T p, const SIZE_T q) noexcept;
+
+public:
+    /// @brief Creates an empty table.
+    /// @param statementCount The number of the statements of the quest.
+    /// @param width The maximum size of the recorded tuples (`1` or `2`).
+    ///        The width `2` is lowered to `1` if there are too many
+    ///        statements.
+    NoveltyTable(const SIZE_T statementCount, const int width) noexcept;
+
+    /// @brief Returns the maximum size of the recorded tuples.
+    int getWidth() const noexcept;
+
+    /// @brief Records the tuples of the state and returns its novelty.
+    /// @param state The state.
+    /// @param newStatements The statements of the state that weren't true in
+    ///        the parent state. Only the tuples with these statements can be
+    ///        new, if the parent state was recorded. For the initial state,
+    ///        these are all the statements of the state.
+    /// @return Returns the novelty of the state, `getWidth() + 1` if it has
+    ///         no new tuples.
+    int update(
+            const BitState& state,
+            const Vector<int>& newStatements
+            ) noexcept;
+};
+
+}
@@ -0,0 +1,497 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/pattern_database.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+
+namespace mozok {
+
+namespace {
+
+/// @brief Distance value of the unreachable abstract states.
+const std::uint8_t UNREACHABLE = 0xff;
+
+/// @brief The greatest stored distance. Longer distances are clamped.
+const std::uint8_t MAX_DISTANCE = 0xfe;
+
+/// @brief An action of the abstract state space of a pattern.
+struct AbstractAction {
+    /// @brief `0` or `1`, see the zero-one cost partitioning.
+    int cost;
+
+    /// @brief (component position, value) pairs that must hold in the
+    ///        state after the action. The first pair is a changed component.
+    Vector<int> conditions;
+
+    /// @brief The index of the state before the action minus the index of
+    ///        the state after the action.
+    std::int64_t delta;
+};
+
+int findRoot(Vector<int>& parents, int indx) noexcept {
+    while(parents[indx] != indx) {
+        parents[indx] = parents[parents[indx]];
+        indx = parents[indx];
+    }
+    return indx;
+}
+
+/// @brief A simple deterministic generator of sample states.
+std::uint32_t nextSample(std::uint32_t& seed) noexcept {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+}
+
+PatternDatabase::PatternDatabase(
+        const Quest& quest,
+        const SIZE_T goalIndx,
+        const BitState& state,
+        const SIZE_T memoryLimit
+        ) noexcept :
+    _builtPatterns(0),
+    _memory(0),
+    _buildTimeUs(0),
+    _lookupTimeNs(0) {
+    const std::chrono::steady_clock::time_point begin =
+            std::chrono::steady_clock::now();
+    const SIZE_T statementCount = quest.getStatementCount();
+    const SIZE_T actionCount = quest.getPossibleActions().size();
+
+    // Skip the actions with false static preconditions.
+    Vector<char> isStatic(statementCount, 1);
+    for(SIZE_T i = 0; i < actionCount; ++i) {
+        for(const int indx : quest.getActionRemList(i))
+            isStatic[indx] = 0;
+        for(const int indx : quest.getActionAddList(i))
+            isStatic[indx] = 0;
+    }
+    Vector<int> actions;
+    for(SIZE_T i = 0; i < actionCount; ++i) {
+        bool isUsable = true;
+        for(const int indx : quest.getActionPreList(i))
+            if(isStatic[indx] && state.hasBit(SIZE_T(indx)) == false) {
+                isUsable = false;
+                break;
+            }
+        if(isUsable)
+            actions.push_back(int(i));
+    }
+
+    // Statements of the goal relations.
+    const BitState& goalMask = quest.getGoalMask(goalIndx);
+    HashSet<ID> goalRelations;
+    BitState::forEachBit(goalMask.getWords(), goalMask.getWordCount(),
+            [&](const SIZE_T indx) {
+        goalRelations.insert(
+                quest.getIndexedStatement(indx)->getRelation()->getId());
+    });
+    const auto relationOf = [&](const int indx) {
+        return quest.getIndexedStatement(SIZE_T(indx))->getRelation()->getId();
+    };
+
+    // Group the statements that are removed and added by the same action.
+    Vector<int> parents(statementCount);
+    for(SIZE_T i = 0; i < statementCount; ++i)
+        parents[i] = int(i);
+    for(const int i : actions)
+        for(const int remIndx : quest.getActionRemList(SIZE_T(i)))
+            for(const int addIndx : quest.getActionAddList(SIZE_T(i)))
+                if(relationOf(remIndx) == relationOf(addIndx)
+                        && goalRelations.count(relationOf(remIndx)) > 0)
+                    parents[findRoot(parents, remIndx)] =
+                            findRoot(parents, addIndx);
+
+    Vector<int> componentOf(statementCount, -1);
+    Vector<int> valueOf(statementCount, 0);
+    {
+        Vector<Vector<int>> groups;
+        Vector<int> rootComponent(statementCount, -1);
+        for(SIZE_T i = 0; i < statementCount; ++i) {
+            if(goalRelations.count(relationOf(int(i))) == 0)
+                continue;
+            const int root = findRoot(parents, int(i));
+            if(rootComponent[root] < 0) {
+                rootComponent[root] = int(groups.size());
+                groups.push_back({});
+            }
+            componentOf[i] = rootComponent[root];
+            groups[rootComponent[root]].push_back(int(i));
+            valueOf[i] = int(groups[rootComponent[root]].size());
+        }
+        _componentOffsets.push_back(0);
+        for(const Vector<int>& group : groups) {
+            _statements.insert(_statements.end(), group.begin(), group.end());
+            _componentOffsets.push_back(_statements.size());
+        }
+    }
+    const SIZE_T componentCount = _componentOffsets.size() - 1;
+
+    // A component can be used only if at most one of its statements is true.
+    // Every action that changes it must require and remove exactly one of
+    // its statements, and add at most one.
+    Vector<char> isSafe(componentCount, 1);
+    Vector<int> preRemCounts(componentCount, 0);
+    Vector<int> addCounts(componentCount, 0);
+    Vector<int> touched;
+    for(const int i : actions) {
+        const IndxRange preList = quest.getActionPreList(SIZE_T(i));
+        for(const int indx : quest.getActionRemList(SIZE_T(i))) {
+            if(componentOf[indx] < 0)
+                continue;
+            touched.push_back(componentOf[indx]);
+            if(std::binary_search(preList.begin(), preList.end(), indx))
+                ++preRemCounts[componentOf[indx]];
+        }
+        for(const int indx : quest.getActionAddList(SIZE_T(i))) {
+            if(componentOf[indx] < 0)
+                continue;
+            touched.push_back(componentOf[indx]);
+            ++addCounts[componentOf[indx]];
+        }
+        for(const int component : touched) {
+            if(preRemCounts[component] != 1 || addCounts[component] > 1)
+                isSafe[component] = 0;
+        }
+        for(const int component : touched)
+            preRemCounts[component] = addCounts[component] = 0;
+        touched.clear();
+    }
+
+    // Components with exactly one goal statement, in the goal order.
+    Vector<int> goalValues(componentCount, 0);
+    Vector<int> goalComponents;
+    for(const StatementPtr& goalStatement : quest.getGoals().at(goalIndx)) {
+        const int indx = quest.getStatementIndx(goalStatement);
+        if(indx < 0 || componentOf[indx] < 0)
+            continue;
+        const int component = componentOf[indx];
+        if(goalValues[component] != 0)
+            // Two goal statements, the component is not used.
+            isSafe[component] = 0;
+        else
+            goalComponents.push_back(component);
+        goalValues[component] = valueOf[indx];
+    }
+
+    // Pack the components into the patterns.
+    Vector<int> patternOf(componentCount, -1);
+    SIZE_T budget = memoryLimit;
+    SIZE_T product = 1;
+    Pattern pattern;
+    const auto closePattern = [&]() {
+        if(pattern.components.empty())
+            return;
+        budget -= product;
+        pattern.distances.resize(product);
+        _patterns.push_back(pattern);
+        pattern.components.clear();
+        pattern.strides.clear();
+        product = 1;
+    };
+    for(const int component : goalComponents) {
+        if(isSafe[component] == 0)
+            continue;
+        const SIZE_T domain = _componentOffsets[component + 1]
+                - _componentOffsets[component] + 1;
+        if(product * domain > budget || product * domain > 0xffffffffu)
+            closePattern();
+        if(product * domain > budget || product * domain > 0xffffffffu)
+            continue;
+        patternOf[component] = int(_patterns.size());
+        pattern.components.push_back(component);
+        pattern.strides.push_back(std::uint32_t(product));
+        product *= domain;
+    }
+    closePattern();
+
+    // Every action is charged to the first pattern it changes.
+    Vector<int> chargedPattern(actionCount, -1);
+    for(const int i : actions) {
+        for(const int indx : quest.getActionRemList(SIZE_T(i))) {
+            const int p = componentOf[indx] < 0 ? -1
+                    : patternOf[componentOf[indx]];
+            if(p >= 0 && (chargedPattern[i] < 0 || p < chargedPattern[i]))
+                chargedPattern[i] = p;
+        }
+    }
+
+    // The tables are calculated by `build()`.
+    _buildData = makeUnique<BuildData>();
+    _buildData->actions = std::move(actions);
+    _buildData->componentOf = std::move(componentOf);
+    _buildData->valueOf = std::move(valueOf);
+    _buildData->chargedPattern = std::move(chargedPattern);
+    _buildData->patternOf = std::move(patternOf);
+    _buildData->goalValues = std::move(goalValues);
+
+    _buildTimeUs = int(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin).count());
+}
+
+bool PatternDatabase::build(
+        const Quest& quest,
+        const PlanningDeadline& deadline
+        ) noexcept {
+    if(isComplete())
+        return true;
+    const std::chrono::steady_clock::time_point begin =
+            std::chrono::steady_clock::now();
+    // At least one pattern is built per call, so the build always advances. 
+    // A pattern is a long step, so the clock is read after every pattern.
+    bool isInterrupted = false;
+    while(_builtPatterns < _patterns.size() && isInterrupted == false) {
+        const BuildData& data = *_buildData;
+        buildPattern(
+                quest, data.actions, _builtPatterns, data.componentOf, 
+                data.valueOf, data.chargedPattern, data.patternOf, 
+                data.goalValues);
+        _memory += _patterns[_builtPatterns].distances.size();
+        ++_builtPatterns;
+        isInterrupted = deadline.isReached(0);
+    }
+
+    _buildTimeUs += int(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin).count());
+    if(_builtPatterns < _patterns.size())
+        return false;
+    _buildData.reset();
+    measureLookupTime(quest);
+    return true;
+}
+
+bool PatternDatabase::isComplete() const noexcept {
+    return _buildData == nullptr;
+}
+
+void PatternDatabase::buildPattern(
+        const Quest& quest,
+        const Vector<int>& actions,
+        const SIZE_T patternIndx,
+        const Vector<int>& componentOf,
+        const Vector<int>& valueOf,
+        const Vector<int>& chargedPattern,
+        const Vector<int>& patternOf,
+        const Vector<int>& goalValues
+        ) noexcept {
+    Pattern& pattern = _patterns[patternIndx];
+    const SIZE_T componentCount = pattern.components.size();
+    Vector<int> positionOf(patternOf.size(), -1);
+    Vector<int> domains(componentCount);
+    for(SIZE_T k = 0; k < componentCount; ++k) {
+        const int component = pattern.components[k];
+        positionOf[component] = int(k);
+        domains[k] = int(_componentOffsets[component + 1]
+                - _componentOffsets[component] + 1);
+    }
+
+    // Project the actions. `preValues[k]` and `newValues[k]` are the values
+    // of the k-th component before and after the action (`-1` if the action
+    // doesn't mention the component).
+    Vector<Pair<Vector<int>, int>> projected;
+    Vector<int> preValues(componentCount, -1);
+    Vector<int> newValues(componentCount, -1);
+    for(const int i : actions) {
+        bool isApplicable = true;
+        for(const int indx : quest.getActionPreList(SIZE_T(i))) {
+            if(componentOf[indx] < 0 || positionOf[componentOf[indx]] < 0)
+                continue;
+            int& value = preValues[positionOf[componentOf[indx]]];
+            if(value >= 0)
+                // Requires two statements of the same component.
+                isApplicable = false;
+            value = valueOf[indx];
+        }
+        for(const int indx : quest.getActionRemList(SIZE_T(i)))
+            if(componentOf[indx] >= 0 && positionOf[componentOf[indx]] >= 0)
+                newValues[positionOf[componentOf[indx]]] = 0;
+        for(const int indx : quest.getActionAddList(SIZE_T(i)))
+            if(componentOf[indx] >= 0 && positionOf[componentOf[indx]] >= 0)
+                newValues[positionOf[componentOf[indx]]] = valueOf[indx];
+
+        // The key is the changed components as (position, value after,
+        // value before) triples, then the other required components as
+        // (position, value) pairs.
+        Vector<int> key;
+        for(SIZE_T k = 0; k < componentCount; ++k)
+            if(newValues[k] >= 0 && newValues[k] != preValues[k]) {
+                key.push_back(int(k));
+                key.push_back(newValues[k]);
+                key.push_back(preValues[k]);
+            }
+        const SIZE_T changedSize = key.size();
+        for(SIZE_T k = 0; k < componentCount; ++k)
+            if(preValues[k] >= 0 && (newValues[k] < 0
+                    || newValues[k] == preValues[k])) {
+                key.push_back(int(k));
+                key.push_back(preValues[k]);
+            }
+        key.push_back(int(changedSize));
+        if(isApplicable && changedSize > 0)
+            projected.push_back(Pair<Vector<int>, int>(key,
+                    chargedPattern[i] == int(patternIndx) ? 1 : 0));
+        preValues.assign(componentCount, -1);
+        newValues.assign(componentCount, -1);
+    }
+
+    // Remove the duplicates, keeping the cheapest ones.
+    std::sort(projected.begin(), projected.end());
+    Vector<AbstractAction> abstractActions;
+    for(SIZE_T i = 0; i < projected.size(); ++i) {
+        if(i > 0 && projected[i].first == projected[i-1].first)
+            continue;
+        const Vector<int>& key = projected[i].first;
+        const SIZE_T changedSize = SIZE_T(key.back());
+        AbstractAction action;
+        action.cost = projected[i].second;
+        action.delta = 0;
+        for(SIZE_T j = 0; j < changedSize; j += 3) {
+            action.conditions.push_back(key[j]);
+            action.conditions.push_back(key[j+1]);
+            action.delta += std::int64_t(key[j+2] - key[j+1])
+                    * std::int64_t(pattern.strides[key[j]]);
+        }
+        for(SIZE_T j = changedSize; j + 1 < key.size(); j += 2) {
+            action.conditions.push_back(key[j]);
+            action.conditions.push_back(key[j+1]);
+        }
+        abstractActions.push_back(action);
+    }
+
+    // Index the actions by the first changed component and its new value.
+    Vector<int> bucketBase(componentCount + 1, 0);
+    for(SIZE_T k = 0; k < componentCount; ++k)
+        bucketBase[k+1] = bucketBase[k] + domains[k];
+    Vector<Vector<int>> buckets(bucketBase.back());
+    for(SIZE_T i = 0; i < abstractActions.size(); ++i)
+        buckets[bucketBase[abstractActions[i].conditions[0]]
+                + abstractActions[i].conditions[1]].push_back(int(i));
+
+    // Backward breadth-first search from the goal (0-1 BFS).
+    Vector<std::uint8_t>& distances = pattern.distances;
+    distances.assign(distances.size(), UNREACHABLE);
+    std::uint32_t goal = 0;
+    for(SIZE_T k = 0; k < componentCount; ++k)
+        goal += std::uint32_t(goalValues[pattern.components[k]])
+                * pattern.strides[k];
+    distances[goal] = 0;
+    std::deque<std::uint32_t> open;
+    open.push_back(goal);
+    Vector<int> values(componentCount);
+    while(open.empty() == false) {
+        const std::uint32_t indx = open.front();
+        open.pop_front();
+        const int distance = distances[indx];
+        for(SIZE_T k = 0; k < componentCount; ++k)
+            values[k] = int((indx / pattern.strides[k]) % domains[k]);
+        for(SIZE_T k = 0; k < componentCount; ++k)
+            for(const int actionIndx : buckets[bucketBase[k] + values[k]]) {
+                const AbstractAction& action = abstractActions[actionIndx];
+                bool isMatching = true;
+                for(SIZE_T j = 0; j < action.conditions.size(); j += 2)
+                    if(values[action.conditions[j]]
+                            != action.conditions[j+1]) {
+                        isMatching = false;
+                        break;
+                    }
+                if(isMatching == false)
+                    continue;
+                const std::uint32_t preIndx =
+                        std::uint32_t(std::int64_t(indx) + action.delta);
+                const std::uint8_t newDistance = std::uint8_t(
+                        std::min(distance + action.cost, int(MAX_DISTANCE)));
+                if(distances[preIndx] <= newDistance)
+                    continue;
+                distances[preIndx] = newDistance;
+                if(action.cost == 0)
+                    open.push_front(preIndx);
+                else
+                    open.push_back(preIndx);
+            }
+    }
+}
+
+void PatternDatabase::measureLookupTime(const Quest& quest) noexcept {
+    const SIZE_T SAMPLE_COUNT = 64;
+    const SIZE_T REPEAT_COUNT = 16;
+    const SIZE_T componentCount = _componentOffsets.size() - 1;
+    Vector<BitState> samples;
+    std::uint32_t seed = 1;
+    for(SIZE_T i = 0; i < SAMPLE_COUNT; ++i) {
+        BitState sample(quest.getStatementCount());
+        for(SIZE_T c = 0; c < componentCount; ++c) {
+            const SIZE_T size = _componentOffsets[c+1] - _componentOffsets[c];
+            const SIZE_T value = nextSample(seed) % (size + 1);
+            if(value > 0)
+                sample.setBit(
+                        SIZE_T(_statements[_componentOffsets[c] + value - 1]),
+                        quest.getStatementKeys());
+        }
+        samples.push_back(sample);
+    }
+
+    const std::chrono::steady_clock::time_point begin =
+            std::chrono::steady_clock::now();
+    int checksum = 0;
+    for(SIZE_T r = 0; r < REPEAT_COUNT; ++r)
+        for(const BitState& sample : samples)
+            checksum ^= lookup(sample);
+    const long long totalNs =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin).count();
+    volatile int sink = checksum;
+    (void)sink;
+    _lookupTimeNs = int(totalNs / static_cast<long long>(SAMPLE_COUNT * REPEAT_COUNT));
+}
+
+int PatternDatabase::lookup(const BitState& state) const noexcept {
+    int h = 0;
+    for(const Pattern& pattern : _patterns) {
+        std::uint32_t indx = 0;
+        bool isValid = true;
+        for(SIZE_T k = 0; k < pattern.components.size() && isValid; ++k) {
+            const int component = pattern.components[k];
+            const SIZE_T first = _componentOffsets[component];
+            const SIZE_T last = _componentOffsets[component + 1];
+            std::uint32_t value = 0;
+            for(SIZE_T i = first; i < last; ++i)
+                if(state.hasBit(SIZE_T(_statements[i]))) {
+                    if(value != 0) {
+                        // Several true statements.
+                        isValid = false;
+                        break;
+                    }
+                    value = std::uint32_t(i - first + 1);
+                }
+            indx += value * pattern.strides[k];
+        }
+        if(isValid == false)
+            continue;
+        const std::uint8_t distance = pattern.distances[indx];
+        if(distance == UNREACHABLE)
+            return INF;
+        h += distance;
+    }
+    return h;
+}
+
+SIZE_T PatternDatabase::getPatternCount() const noexcept {
+    return _patterns.size();
+}
+
+SIZE_T PatternDatabase::getMemory() const noexcept {
+    return _memory;
+}
+
+int PatternDatabase::getBuildTime() const noexcept {
+    return _buildTimeUs;
+}
+
+int PatternDatabase::getLookupTime() const noexcept {
+    return _lookupTimeNs;
+}
+
+}
@@ -0,0 +1,148 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+#include <libmozok/planning_deadline.hpp>
+
+#include <cstdint>
+#include <limits>
+
+namespace mozok {
+
+class PatternDatabase;
+using PatternDatabasePtr = SharedPtr<const PatternDatabase>;
+
+/// @brief Additive pattern databases of a quest goal (`PDB` heuristic).
+/// Only the actions whose static preconditions (the statements that no
+/// action adds or removes) hold in the given state are used.
+/// The patterns are selected automatically from the relations used in the
+/// goal. The statements of these relations are grouped into components:
+/// two statements are in the same component if an action removes one of
+/// them and adds the other. A component is used only if it contains a goal
+/// statement and at most one of its statements can be true at a time (every
+/// action that adds a statement of the component requires and removes
+/// another one). The value of a component is its true statement (or none),
+/// so a pattern (a group of components) has a finite abstract state space,
+/// which is enumerated by a backward breadth-first search from the goal.
+/// The components are packed into the patterns greedily, while the tables
+/// fit into the memory limit. Every action is charged to the first pattern
+/// it changes (zero-one cost partitioning), so the sum of the pattern
+/// distances is admissible.
+/// The constructor only selects the patterns. The tables are calculated by
+/// `build()`, which can be split across several planning calls, so a large
+/// database doesn't block a single call beyond its time limit.
+class PatternDatabase {
+    struct Pattern {
+        /// @brief The components of the pattern.
+        Vector<int> components;
+
+        /// @brief `strides[i]` is the stride of the i-th component in the
+        ///        abstract state index.
+        Vector<std::uint32_t> strides;
+
+        /// @brief Abstract goal distances, indexed by the abstract state.
+        Vector<std::uint8_t> distances;
+    };
+
+    /// @brief The data of the pattern selection, used until all the tables 
+    ///        are calculated.
+    struct BuildData {
+        Vector<int> actions;
+        Vector<int> componentOf;
+        Vector<int> valueOf;
+        Vector<int> chargedPattern;
+        Vector<int> patternOf;
+        Vector<int> goalValues;
+    };
+
+    /// @brief The statements of the i-th component are
+    ///        `_statements[_componentOffsets[i] .. _componentOffsets[i+1])`.
+    Vector<int> _statements;
+    Vector<SIZE_T> _componentOffsets;
+
+    Vector<Pattern> _patterns;
+
+    /// @brief The number of the patterns with calculated tables.
+    SIZE_T _builtPatterns;
+
+    /// @brief `nullptr` once the database is complete.
+    UniquePtr<BuildData> _buildData;
+
+    /// @brief Table memory in bytes.
+    SIZE_T _memory;
+
+    /// @brief Build time in microseconds.
+    int _buildTimeUs;
+
+    /// @brief Average lookup time in nanoseconds.
+    int _lookupTimeNs;
+
+    /// @brief Calculates the abstract distances of the pattern.
+    void buildPattern(
+            const Quest& quest,
+            const Vector<int>& actions,
+            const SIZE_T patternIndx,
+            const Vector<int>& componentOf,
+            const Vector<int>& valueOf,
+            const Vector<int>& chargedPattern,
+            const Vector<int>& patternOf,
+            const Vector<int>& goalValues
+            ) noexcept;
+
+    /// @brief Measures the average lookup time on sample states.
+    void measureLookupTime(const Quest& quest) noexcept;
+
+public:
+    static const int INF = std::numeric_limits<int>::max();
+
+    /// @brief Selects the patterns of the databases. The tables are not 
+    ///        calculated yet (see `build()`).
+    /// @param quest The quest.
+    /// @param goalIndx The quest goal.
+    /// @param state The state that defines the static statements.
+    /// @param memoryLimit The maximum total size of the tables in bytes.
+    PatternDatabase(
+            const Quest& quest,
+            const SIZE_T goalIndx,
+            const BitState& state,
+            const SIZE_T memoryLimit
+            ) noexcept;
+
+    /// @brief Continues calculating the tables until all of them are ready, 
+    ///        or until the deadline. At least one table is calculated per 
+    ///        call.
+    /// @param quest The quest of the constructor.
+    /// @param deadline The deadline of the planning call.
+    /// @return Returns `true` if the database is complete.
+    bool build(const Quest& quest, const PlanningDeadline& deadline) noexcept;
+
+    /// @brief Returns `true` if all the tables are calculated. Only complete 
+    ///        databases can be used for the lookups.
+    bool isComplete() const noexcept;
+
+    /// @brief Returns the sum of the abstract goal distances of the state.
+    ///        A pattern doesn't contribute if a component of the pattern
+    ///        has several true statements in the state.
+    /// @return Returns `INF` if the goal is unreachable from the state.
+    int lookup(const BitState& state) const noexcept;
+
+    /// @brief Returns the number of patterns.
+    SIZE_T getPatternCount() const noexcept;
+
+    /// @brief Returns the total size of the tables in bytes.
+    SIZE_T getMemory() const noexcept;
+
+    /// @brief Returns the build time in microseconds, summed over the 
+    ///        `build()` calls.
+    int getBuildTime() const noexcept;
+
+    /// @brief Returns the average lookup time in nanoseconds.
+    int getLookupTime() const noexcept;
+};
+
+}
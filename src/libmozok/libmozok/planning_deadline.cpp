@@ -0,0 +1,18 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/planning_deadline.hpp>
+
+namespace mozok {
+
+PlanningDeadline::PlanningDeadline(const int timeLimitUs) noexcept :
+    _isSet(timeLimitUs > 0),
+    _time(Clock::now() + std::chrono::microseconds(timeLimitUs))
+{ /* empty */ }
+
+bool PlanningDeadline::isReached(const int searchStep) const noexcept {
+    if(_isSet == false || searchStep % CHECK_STEPS != 0)
+        return false;
+    return Clock::now() >= _time;
+}
+
+}
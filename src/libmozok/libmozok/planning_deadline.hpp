@@ -0,0 +1,35 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <chrono>
+
+namespace mozok {
+
+/// @brief The wall-clock deadline of a planning call (see 
+/// `QuestSettings::timeLimitUs`). Reading the clock isn't free, so the 
+/// searches check the deadline only once per `CHECK_STEPS` expanded states.
+class PlanningDeadline {
+    using Clock = std::chrono::steady_clock;
+
+    const bool _isSet;
+    const Clock::time_point _time;
+
+public:
+    /// @brief The number of search steps between the clock reads.
+    static const int CHECK_STEPS = 16;
+
+    /// @param timeLimitUs The time limit in microseconds, counted from now. 
+    ///        The deadline is not set if the limit isn't positive.
+    PlanningDeadline(const int timeLimitUs) noexcept;
+
+    /// @brief Checks the deadline on every `CHECK_STEPS`-th search step.
+    /// @param searchStep The number of the steps made by the search.
+    /// @return Returns `true` if the deadline is set and has passed.
+    bool isReached(const int searchStep) const noexcept;
+};
+
+}
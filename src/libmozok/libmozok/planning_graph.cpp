@@ -0,0 +1,455 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/planning_graph.hpp>
+
+#include <algorithm>
+
+namespace mozok {
+
+namespace {
+
+using Word = BitState::Word;
+
+bool hasBit(const Word* mask, const SIZE_T indx) noexcept {
+    return (mask[indx / BitState::WORD_BITS]
+            >> (indx % BitState::WORD_BITS)) & 1;
+}
+
+void setBit(Word* mask, const SIZE_T indx) noexcept {
+    mask[indx / BitState::WORD_BITS] |= Word(1) << (indx % BitState::WORD_BITS);
+}
+
+bool intersects(const Word* a, const Word* b, const SIZE_T wordCount) noexcept {
+    for(SIZE_T w = 0; w < wordCount; ++w)
+        if((a[w] & b[w]) != 0)
+            return true;
+    return false;
+}
+
+}
+
+PlanExtractionMonitor::~PlanExtractionMonitor() noexcept
+{ /* empty */ }
+
+PlanningGraph::PlanningGraph(
+        const Quest& quest,
+        const BitState& initialState
+        ) noexcept :
+    _quest(quest),
+    _statementCount(quest.getStatementCount()),
+    _actionCount(quest.getPossibleActions().size()),
+    _wordCount(BitState::getWordCount(quest.getStatementCount())),
+    _useMutexes(quest.getStatementCount() <= MUTEX_STATEMENT_LIMIT),
+    _delMasks(_actionCount * _wordCount),
+    _levels(1),
+    _levelCount(1),
+    _isLeveledOff(false),
+    _factLevels(_statementCount, -1),
+    _actionLevels(_actionCount, -1),
+    _missingPreconditions(_actionCount),
+    _nogoodCount(0) {
+    for(SIZE_T a = 0; a < _actionCount; ++a) {
+        _missingPreconditions[a] = int(_quest.getActionPreList(a).size());
+        if(_missingPreconditions[a] == 0)
+            _pendingActions.push_back(int(a));
+        const Word* remMask = _quest.getActionRemMask(a);
+        const Word* addMask = _quest.getActionAddMask(a);
+        for(SIZE_T w = 0; w < _wordCount; ++w)
+            _delMasks[a * _wordCount + w] = remMask[w] & ~addMask[w];
+    }
+
+    Level& level = _levels.front();
+    level.facts.assign(
+            initialState.getWords(),
+            initialState.getWords() + _wordCount);
+    if(_useMutexes)
+        level.mutexes.assign(_statementCount * _wordCount, 0);
+    BitState::forEachBit(level.facts.data(), _wordCount, [&](const SIZE_T p) {
+        addFact(p, 0);
+    });
+}
+
+void PlanningGraph::addFact(const SIZE_T p, const SIZE_T k) noexcept {
+    _factLevels[p] = int(k);
+    for(const int a : _quest.getStatementPreActions(p))
+        if(--_missingPreconditions[a] == 0)
+            _pendingActions.push_back(a);
+}
+
+const PlanningGraph::Level& PlanningGraph::getLevel(
+        const SIZE_T k) const noexcept {
+    return _levels[std::min(k, _levels.size() - 1)];
+}
+
+bool PlanningGraph::isFactMutex(
+        const Level& level,
+        const SIZE_T p,
+        const SIZE_T q
+        ) const noexcept {
+    if(!_useMutexes)
+        return false;
+    return hasBit(level.mutexes.data() + p * _wordCount, q);
+}
+
+bool PlanningGraph::isMutex(
+        const Level& level,
+        const int x,
+        const int y
+        ) const noexcept {
+    if(x == y)
+        return false;
+    if(x < 0 && y < 0)
+        return isFactMutex(level, SIZE_T(-x - 1), SIZE_T(-y - 1));
+    if(x < 0 || y < 0) {
+        const SIZE_T p = SIZE_T(x < 0 ? -x - 1 : -y - 1);
+        const SIZE_T a = SIZE_T(x < 0 ? y : x);
+        // The action removes the fact of the no-op.
+        if(hasBit(_delMasks.data() + a * _wordCount, p))
+            return true;
+        for(const int q : _quest.getActionPreList(a))
+            if(isFactMutex(level, p, SIZE_T(q)))
+                return true;
+        return false;
+    }
+
+    // Interference.
+    const Word* delX = _delMasks.data() + SIZE_T(x) * _wordCount;
+    const Word* delY = _delMasks.data() + SIZE_T(y) * _wordCount;
+    if(intersects(delX, _quest.getActionPreMask(y), _wordCount)
+            || intersects(delX, _quest.getActionAddMask(y), _wordCount)
+            || intersects(delY, _quest.getActionPreMask(x), _wordCount)
+            || intersects(delY, _quest.getActionAddMask(x), _wordCount))
+        return true;
+
+    // Competing needs.
+    if(_useMutexes) {
+        const Word* preY = _quest.getActionPreMask(y);
+        for(const int p : _quest.getActionPreList(x))
+            if(intersects(
+                    level.mutexes.data() + SIZE_T(p) * _wordCount,
+                    preY,
+                    _wordCount))
+                return true;
+    }
+    return false;
+}
+
+void PlanningGraph::expand() noexcept {
+    ++_levelCount;
+    if(_isLeveledOff)
+        return;
+
+    const SIZE_T k = _levels.size() - 1;
+    Level next;
+    next.facts = _levels.back().facts;
+
+    // The actions of the action level `k`. The actions of the previous 
+    // levels stay applicable, since the facts only grow and the mutexes 
+    // only shrink.
+    {
+        const Level& last = _levels.back();
+        SIZE_T pendingCount = 0;
+        for(const int a : _pendingActions) {
+            const Word* preMask = _quest.getActionPreMask(SIZE_T(a));
+            bool isApplicable = true;
+            if(_useMutexes)
+                for(const int p : _quest.getActionPreList(SIZE_T(a)))
+                    if(intersects(
+                            last.mutexes.data() + SIZE_T(p) * _wordCount,
+                            preMask,
+                            _wordCount)) {
+                        isApplicable = false;
+                        break;
+                    }
+            if(!isApplicable) {
+                _pendingActions[pendingCount++] = a;
+                continue;
+            }
+            _actionLevels[a] = int(k);
+            _actions.push_back(a);
+        }
+        _pendingActions.resize(pendingCount);
+    }
+    for(const int a : _actions) {
+        const Word* addMask = _quest.getActionAddMask(SIZE_T(a));
+        for(SIZE_T w = 0; w < _wordCount; ++w)
+            next.facts[w] |= addMask[w];
+    }
+
+    if(_useMutexes) {
+        const Level& last = _levels.back();
+
+        // The achievers of the fact level `k + 1`: the actions, then the 
+        // no-ops.
+        const SIZE_T actionCount = _actions.size();
+        Vector<int> achievers(_actions);
+        BitState::forEachBit(last.facts.data(), _wordCount, [&](const SIZE_T p) {
+            achievers.push_back(-int(p) - 1);
+        });
+
+        // `preMutexes[i * _wordCount ..]` is the mask of the facts that are 
+        // mutex with a precondition of the action `_actions[i]`, so the 
+        // competing needs are checked by one mask intersection.
+        Vector<Word> preMutexes(actionCount * _wordCount, 0);
+        for(SIZE_T i = 0; i < actionCount; ++i) {
+            Word* row = preMutexes.data() + i * _wordCount;
+            for(const int p : _quest.getActionPreList(SIZE_T(_actions[i]))) {
+                const Word* mutexRow = 
+                        last.mutexes.data() + SIZE_T(p) * _wordCount;
+                for(SIZE_T w = 0; w < _wordCount; ++w)
+                    row[w] |= mutexRow[w];
+            }
+        }
+        const auto isActionMutex = [&](const SIZE_T i, const SIZE_T j) {
+            const SIZE_T x = SIZE_T(_actions[i]);
+            const SIZE_T y = SIZE_T(_actions[j]);
+            const Word* delX = _delMasks.data() + x * _wordCount;
+            const Word* delY = _delMasks.data() + y * _wordCount;
+            return intersects(
+                        preMutexes.data() + i * _wordCount, 
+                        _quest.getActionPreMask(y), _wordCount)
+                    || intersects(delX, _quest.getActionPreMask(y), _wordCount)
+                    || intersects(delX, _quest.getActionAddMask(y), _wordCount)
+                    || intersects(delY, _quest.getActionPreMask(x), _wordCount)
+                    || intersects(delY, _quest.getActionAddMask(x), _wordCount);
+        };
+        const auto isNoopMutex = [&](const SIZE_T i, const SIZE_T q) {
+            return hasBit(_delMasks.data() + SIZE_T(_actions[i]) * _wordCount, q)
+                    || hasBit(preMutexes.data() + i * _wordCount, q);
+        };
+
+        // `together[p * _wordCount ..]` is the mask of the facts that have 
+        // an achiever that isn't mutex with an achiever of the fact `p`.
+        Vector<Word> together(_statementCount * _wordCount, 0);
+        Vector<Word> compatible(_wordCount);
+        for(SIZE_T i = 0; i < achievers.size(); ++i) {
+            const int x = achievers[i];
+            std::fill(compatible.begin(), compatible.end(), 0);
+            for(SIZE_T j = 0; j < achievers.size(); ++j) {
+                const int y = achievers[j];
+                if(y < 0) {
+                    const SIZE_T q = SIZE_T(-y - 1);
+                    if(hasBit(compatible.data(), q))
+                        continue;
+                    if(i != j && (x < 0 
+                            ? isFactMutex(last, SIZE_T(-x - 1), q)
+                            : isNoopMutex(i, q)))
+                        continue;
+                    setBit(compatible.data(), q);
+                } else {
+                    const Word* addMask = _quest.getActionAddMask(SIZE_T(y));
+                    if(BitState::isSubset(
+                            addMask, compatible.data(), _wordCount))
+                        continue;
+                    if(i != j && (x < 0 
+                            ? isNoopMutex(j, SIZE_T(-x - 1))
+                            : isActionMutex(i, j)))
+                        continue;
+                    for(SIZE_T w = 0; w < _wordCount; ++w)
+                        compatible[w] |= addMask[w];
+                }
+            }
+            const auto addTogether = [&](const SIZE_T p) {
+                Word* row = together.data() + p * _wordCount;
+                for(SIZE_T w = 0; w < _wordCount; ++w)
+                    row[w] |= compatible[w];
+            };
+            if(x < 0)
+                addTogether(SIZE_T(-x - 1));
+            else
+                for(const int p : _quest.getActionAddList(SIZE_T(x)))
+                    addTogether(SIZE_T(p));
+        }
+
+        next.mutexes.assign(_statementCount * _wordCount, 0);
+        BitState::forEachBit(next.facts.data(), _wordCount, [&](const SIZE_T p) {
+            Word* row = next.mutexes.data() + p * _wordCount;
+            const Word* rowTogether = together.data() + p * _wordCount;
+            for(SIZE_T w = 0; w < _wordCount; ++w)
+                row[w] = next.facts[w] & ~rowTogether[w];
+        });
+    }
+
+    if(next.facts == _levels.back().facts
+            && next.mutexes == _levels.back().mutexes) {
+        _isLeveledOff = true;
+        return;
+    }
+    BitState::forEachBit(next.facts.data(), _wordCount, [&](const SIZE_T p) {
+        if(_factLevels[p] < 0)
+            addFact(p, k + 1);
+    });
+    _levels.push_back(std::move(next));
+}
+
+SIZE_T PlanningGraph::getLevelCount() const noexcept {
+    return _levelCount;
+}
+
+SIZE_T PlanningGraph::getDistinctLevelCount() const noexcept {
+    return _levels.size();
+}
+
+bool PlanningGraph::isLeveledOff() const noexcept {
+    return _isLeveledOff;
+}
+
+bool PlanningGraph::hasGoal(const BitState& goalMask) const noexcept {
+    const Level& level = _levels.back();
+    if(!BitState::isSubset(goalMask.getWords(), level.facts.data(), _wordCount))
+        return false;
+    if(!_useMutexes)
+        return true;
+    bool isMutexFree = true;
+    BitState::forEachBit(goalMask.getWords(), _wordCount, [&](const SIZE_T p) {
+        if(intersects(
+                level.mutexes.data() + p * _wordCount,
+                goalMask.getWords(),
+                _wordCount))
+            isMutexFree = false;
+    });
+    return isMutexFree;
+}
+
+PlanningGraph::ExtractionResult PlanningGraph::extract(
+        const SIZE_T k,
+        const BitStatePtr& goals,
+        PlanExtractionMonitor& monitor,
+        Vector<int>& plan
+        ) noexcept {
+    if(k == 0)
+        return EXTRACTION_FOUND;
+    if(!monitor.onExtractionStep(_nogoodCount))
+        return EXTRACTION_STOPPED;
+    BitStateMap<char>& nogoods = *_nogoods[k];
+    if(nogoods.find(*goals) != nullptr)
+        return EXTRACTION_FAILED;
+
+    // The goals that appeared later are the harder ones, try them first.
+    Vector<int> goalList;
+    BitState::forEachBit(goals->getWords(), _wordCount, [&](const SIZE_T p) {
+        goalList.push_back(int(p));
+    });
+    std::stable_sort(goalList.begin(), goalList.end(),
+            [&](const int p, const int q) {
+        return _factLevels[p] > _factLevels[q];
+    });
+
+    _chosen[k - 1].clear();
+    const ExtractionResult result = assign(k, goalList, 0, monitor, plan);
+    if(result == EXTRACTION_FAILED) {
+        nogoods.insert(goals, 0);
+        ++_nogoodCount;
+    }
+    return result;
+}
+
+PlanningGraph::ExtractionResult PlanningGraph::assign(
+        const SIZE_T k,
+        const Vector<int>& goals,
+        const SIZE_T goalIndx,
+        PlanExtractionMonitor& monitor,
+        Vector<int>& plan
+        ) noexcept {
+    Vector<int>& chosen = _chosen[k - 1];
+    if(goalIndx == goals.size()) {
+        // All the goals are achieved, now achieve the preconditions of the
+        // chosen actions one level below.
+        const Vector<Fingerprint>& keys = _quest.getStatementKeys();
+        BitStatePtr subgoals = makeShared<BitState>(_statementCount);
+        for(const int x : chosen) {
+            if(x < 0)
+                subgoals->setBit(SIZE_T(-x - 1), keys);
+            else
+                for(const int p : _quest.getActionPreList(SIZE_T(x)))
+                    subgoals->setBit(SIZE_T(p), keys);
+        }
+        const ExtractionResult result = extract(k - 1, subgoals, monitor, plan);
+        if(result == EXTRACTION_FOUND)
+            for(const int x : chosen)
+                if(x >= 0)
+                    plan.push_back(x);
+        return result;
+    }
+
+    const SIZE_T p = SIZE_T(goals[goalIndx]);
+    for(const int x : chosen)
+        if((x < 0 && SIZE_T(-x - 1) == p)
+                || (x >= 0 && hasBit(_quest.getActionAddMask(SIZE_T(x)), p)))
+            return assign(k, goals, goalIndx + 1, monitor, plan);
+
+    const Level& level = getLevel(k - 1);
+    const auto tryAchiever = [&](const int x) {
+        for(const int y : chosen)
+            if(isMutex(level, x, y))
+                return EXTRACTION_FAILED;
+        chosen.push_back(x);
+        const ExtractionResult result =
+                assign(k, goals, goalIndx + 1, monitor, plan);
+        chosen.pop_back();
+        return result;
+    };
+
+    // No-op first, so the plan doesn't change what is already achieved.
+    if(hasBit(level.facts.data(), p)) {
+        const ExtractionResult result = tryAchiever(-int(p) - 1);
+        if(result != EXTRACTION_FAILED)
+            return result;
+    }
+    for(const int a : _quest.getStatementAddActions(p)) {
+        if(_actionLevels[a] < 0 || SIZE_T(_actionLevels[a]) > k - 1)
+            continue;
+        const ExtractionResult result = tryAchiever(a);
+        if(result != EXTRACTION_FAILED)
+            return result;
+    }
+    return EXTRACTION_FAILED;
+}
+
+PlanningGraph::ExtractionResult PlanningGraph::extractPlan(
+        const BitState& goalMask,
+        PlanExtractionMonitor& monitor,
+        Vector<int>& plan
+        ) noexcept {
+    while(_nogoods.size() < _levelCount)
+        _nogoods.push_back(makeShared<BitStateMap<char>>());
+    _chosen.resize(_levelCount);
+
+    const Vector<Fingerprint>& keys = _quest.getStatementKeys();
+    BitStatePtr goals = makeShared<BitState>(_statementCount);
+    BitState::forEachBit(goalMask.getWords(), _wordCount, [&](const SIZE_T p) {
+        goals->setBit(p, keys);
+    });
+    plan.clear();
+    const ExtractionResult result =
+            extract(_levelCount - 1, goals, monitor, plan);
+    if(result != EXTRACTION_FOUND)
+        plan.clear();
+    return result;
+}
+
+SIZE_T PlanningGraph::getNogoodCount(const SIZE_T k) const noexcept {
+    if(k >= _nogoods.size())
+        return 0;
+    return _nogoods[k]->size();
+}
+
+const BitState::Word* PlanningGraph::getStatementMutexes(
+        const SIZE_T k,
+        const SIZE_T p
+        ) const noexcept {
+    if(!_useMutexes)
+        return nullptr;
+    return getLevel(k).mutexes.data() + p * _wordCount;
+}
+
+int PlanningGraph::getFactLevel(const SIZE_T statementIndx) const noexcept {
+    return _factLevels[statementIndx];
+}
+
+int PlanningGraph::getActionLevel(
+        const SIZE_T possibleActionIndx) const noexcept {
+    return _actionLevels[possibleActionIndx];
+}
+
+}
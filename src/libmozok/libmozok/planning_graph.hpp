@@ -0,0 +1,197 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+
+namespace mozok {
+
+/// @brief A callback class for the `PlanningGraph::extractPlan(...)`.
+/// Checks the limits of the plan extraction.
+class PlanExtractionMonitor {
+public:
+    virtual ~PlanExtractionMonitor() noexcept;
+
+    /// @brief This method will be invoked before every extraction step (an
+    ///        attempt to achieve a set of goals at a level of the graph).
+    /// @param nogoodCount The number of the memoized nogoods.
+    /// @return Returns `false` if the extraction must be stopped.
+    virtual bool onExtractionStep(const SIZE_T nogoodCount) noexcept = 0;
+};
+
+/// @brief The planning graph of the GraphPlan algorithm (`GRAPHPLAN`).
+/// The graph alternates the fact levels and the action levels. The first
+/// fact level is the initial state. An action is at the action level `k` if
+/// its preconditions are at the fact level `k` and no two of them are
+/// mutex, and the fact level `k + 1` contains the facts of the level `k`
+/// (no-op actions) and the facts added by the actions of the level `k`.
+/// Two actions are mutex if one of them removes a precondition or an added
+/// fact of the other one (interference), or if their preconditions are
+/// mutex (competing needs). Two facts are mutex if all the pairs of their
+/// achievers are mutex. The levels grow and the mutexes shrink, until the
+/// graph levels off.
+/// The fact mutexes are computed only for the quests with at most
+/// `MUTEX_STATEMENT_LIMIT` statements, otherwise only the interference is
+/// used.
+class PlanningGraph {
+public:
+    /// @brief The maximum number of statements for which the fact mutexes
+    ///        are computed. A level takes `n^2 / 8` bytes.
+    static const SIZE_T MUTEX_STATEMENT_LIMIT = 4096;
+
+    /// @brief The results of the plan extraction.
+    enum ExtractionResult {
+        EXTRACTION_FOUND,
+        EXTRACTION_FAILED,
+        EXTRACTION_STOPPED
+    };
+
+private:
+    /// @brief A fact level.
+    struct Level {
+        /// @brief The mask of the facts of the level.
+        Vector<BitState::Word> facts;
+
+        /// @brief `mutexes[p * _wordCount ..]` is the mask of the facts that
+        ///        are mutex with the fact `p` (empty if the mutexes are not
+        ///        used).
+        Vector<BitState::Word> mutexes;
+    };
+
+    const Quest& _quest;
+    const SIZE_T _statementCount;
+    const SIZE_T _actionCount;
+    const SIZE_T _wordCount;
+    const bool _useMutexes;
+
+    /// @brief `_delMasks[a * _wordCount ..]` is the mask of the facts that
+    ///        are removed and not added by the action `a`.
+    Vector<BitState::Word> _delMasks;
+
+    /// @brief The distinct fact levels. After the graph has leveled off,
+    ///        the next levels are the same as the last one.
+    Vector<Level> _levels;
+    SIZE_T _levelCount;
+    bool _isLeveledOff;
+
+    /// @brief The first fact level of every fact, or `-1`.
+    Vector<int> _factLevels;
+
+    /// @brief The first action level of every possible action, or `-1`.
+    Vector<int> _actionLevels;
+
+    /// @brief The number of the preconditions of every possible action that
+    ///        are missing at the last fact level.
+    Vector<int> _missingPreconditions;
+
+    /// @brief The actions with all the preconditions at the last fact level,
+    ///        that are not at an action level yet (some preconditions are
+    ///        mutex).
+    Vector<int> _pendingActions;
+
+    /// @brief The actions of the action levels, in the order of the levels.
+    Vector<int> _actions;
+
+    /// @brief The memoized sets of goals that can't be achieved at the fact
+    ///        level (`_nogoods[k]` for the level `k`). The levels after the
+    ///        graph has leveled off have their own nogoods.
+    Vector<SharedPtr<BitStateMap<char>>> _nogoods;
+    SIZE_T _nogoodCount;
+
+    /// @brief The actions chosen by the current extraction step (the
+    ///        achiever IDs, see `isMutex()`).
+    Vector<Vector<int>> _chosen;
+
+    /// @brief Adds a fact to the fact level `k`.
+    void addFact(const SIZE_T p, const SIZE_T k) noexcept;
+
+    /// @brief Returns the fact level `k`. The levels after the graph has
+    ///        leveled off are the same as the last one.
+    const Level& getLevel(const SIZE_T k) const noexcept;
+
+    /// @brief Checks if the facts are mutex at the fact level.
+    bool isFactMutex(
+            const Level& level, const SIZE_T p, const SIZE_T q) const noexcept;
+
+    /// @brief Checks if two achievers are mutex at the action level that
+    ///        follows the fact level. An achiever is either a possible action
+    ///        (`x >= 0`), or the no-op action of the fact `-x - 1`.
+    bool isMutex(const Level& level, const int x, const int y) const noexcept;
+
+    /// @brief Tries to achieve the goals at the fact level `k`.
+    ExtractionResult extract(
+            const SIZE_T k,
+            const BitStatePtr& goals,
+            PlanExtractionMonitor& monitor,
+            Vector<int>& plan
+            ) noexcept;
+
+    /// @brief Chooses the achievers of `goals[goalIndx..]` at the action
+    ///        level `k - 1` (see `extract()`).
+    ExtractionResult assign(
+            const SIZE_T k,
+            const Vector<int>& goals,
+            const SIZE_T goalIndx,
+            PlanExtractionMonitor& monitor,
+            Vector<int>& plan
+            ) noexcept;
+
+public:
+    /// @brief Creates the planning graph with one fact level.
+    /// @param quest The quest.
+    /// @param initialState The initial state.
+    PlanningGraph(const Quest& quest, const BitState& initialState) noexcept;
+
+    /// @brief Adds the next action and fact levels. After the graph has
+    ///        leveled off, only the number of the levels grows.
+    void expand() noexcept;
+
+    /// @brief Returns the number of the fact levels.
+    SIZE_T getLevelCount() const noexcept;
+
+    /// @brief Returns the number of the distinct fact levels. If the graph
+    ///        has leveled off, the last distinct level is the one where it
+    ///        happened.
+    SIZE_T getDistinctLevelCount() const noexcept;
+
+    /// @brief Checks if the graph has leveled off (an expansion didn't
+    ///        change the facts or the mutexes).
+    bool isLeveledOff() const noexcept;
+
+    /// @brief Checks if all the goal statements are at the last fact level,
+    ///        and no two of them are mutex.
+    bool hasGoal(const BitState& goalMask) const noexcept;
+
+    /// @brief Searches backward from the goal at the last fact level for the
+    ///        sets of non-mutex actions that achieve it. Goal sets that fail
+    ///        are memoized as nogoods and are never searched again.
+    /// @param goalMask The goal.
+    /// @param monitor The limits of the extraction.
+    /// @param plan Receives the indices of the possible actions of the plan.
+    ExtractionResult extractPlan(
+            const BitState& goalMask,
+            PlanExtractionMonitor& monitor,
+            Vector<int>& plan
+            ) noexcept;
+
+    /// @brief Returns the number of the nogoods at the fact level `k`.
+    SIZE_T getNogoodCount(const SIZE_T k) const noexcept;
+
+    /// @brief Returns the mask of the statements that are mutex with the
+    ///        statement `p` at the fact level `k`, or `nullptr` if the
+    ///        mutexes are not used.
+    const BitState::Word* getStatementMutexes(
+            const SIZE_T k, const SIZE_T p) const noexcept;
+
+    /// @brief Returns the first fact level of the statement, or `-1`.
+    int getFactLevel(const SIZE_T statementIndx) const noexcept;
+
+    /// @brief Returns the first action level of the possible action, or `-1`.
+    int getActionLevel(const SIZE_T possibleActionIndx) const noexcept;
+};
+
+}
@@ -0,0 +1,122 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/portfolio_search.hpp>
+#include <libmozok/quest_planner.hpp>
+
+namespace mozok {
+
+namespace {
+
+/// @brief Heuristic and strategy configurations raced by the portfolio. If 
+///        there are fewer threads than configurations, the first ones are 
+///        used.
+const Pair<QuestHeuristic, QuestSearchStrategy> PORTFOLIO_CONFIGS[] = {
+    {QuestHeuristic::SIMPLE, QuestSearchStrategy::ASTAR},
+    {QuestHeuristic::HSP, QuestSearchStrategy::ASTAR},
+    {QuestHeuristic::SIMPLE, QuestSearchStrategy::DFS},
+    {QuestHeuristic::HSP, QuestSearchStrategy::DFS},
+};
+
+} // namespace
+
+void LimitRecorder::onSearchLimitReached(
+        const Str&, const Str&, const int) noexcept {
+    searchLimitReached = true;
+}
+
+void LimitRecorder::onSpaceLimitReached(
+        const Str&, const Str&, const int) noexcept {
+    spaceLimitReached = true;
+}
+
+void LimitRecorder::onTimeLimitReached(
+        const Str&, const Str&, const int) noexcept {
+    timeLimitReached = true;
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_Portfolio(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    // The quest's own heuristic always takes part in the race. 
+    Vector<QuestSettings> configs;
+    QuestSettings config = settings;
+    config.strategy = QuestSearchStrategy::ASTAR;
+    configs.push_back(config);
+    for(const auto& heuristicAndStrategy : PORTFOLIO_CONFIGS) {
+        if(int(configs.size()) >= settings.threads)
+            break;
+        if(heuristicAndStrategy.first == settings.heuristic
+                && heuristicAndStrategy.second == QuestSearchStrategy::ASTAR)
+            continue;
+        config.heuristic = heuristicAndStrategy.first;
+        config.strategy = heuristicAndStrategy.second;
+        configs.push_back(config);
+    }
+
+    Vector<LimitRecorder> recorders(configs.size());
+    Vector<QuestPlanPtr> plans(configs.size());
+    Vector<UniquePtr<SearchCancelFlag>> cancelFlags;
+    for(SIZE_T i = 0; i < configs.size(); ++i)
+        cancelFlags.push_back(makeUnique<SearchCancelFlag>(cancelFlag));
+
+    // The winner is the first configuration that decides. It cancels all 
+    // the other configurations, including the quest's own one.
+    Atomic<int> winner(-1);
+    auto searchFunc = [&](const SIZE_T indx) noexcept {
+        plans[indx] = findGoalPlan_Search(
+                goalIndx, worldName, recorders[indx], configs[indx], 
+                cancelFlags[indx].get());
+        if(plans[indx]->status == MOZOK_QUEST_STATUS_UNKNOWN)
+            return;
+        int noWinner = -1;
+        if(winner.compare_exchange_strong(noWinner, int(indx)) == false)
+            return;
+        for(SIZE_T i = 0; i < configs.size(); ++i)
+            if(i != indx)
+                cancelFlags[i]->cancel();
+    };
+
+    Vector<Thread> threads;
+    for(SIZE_T i = 1; i < configs.size(); ++i)
+        threads.push_back(Thread(searchFunc, i));
+    searchFunc(0);
+    for(Thread& thread : threads)
+        thread.join();
+
+    const int winnerIndx = winner.load();
+    if(winnerIndx >= 0) {
+        messageProcessor.onPortfolioWinner(
+                worldName, _quest->getQuest()->getName(), 
+                questHeuristicToStr(configs[winnerIndx].heuristic),
+                questSearchStrategyToStr(configs[winnerIndx].strategy));
+        return plans[winnerIndx];
+    }
+
+    // No configuration was able to decide within the limits.
+    bool searchLimitReached = false;
+    bool spaceLimitReached = false;
+    bool timeLimitReached = false;
+    for(const LimitRecorder& recorder : recorders) {
+        searchLimitReached |= recorder.searchLimitReached;
+        spaceLimitReached |= recorder.spaceLimitReached;
+        timeLimitReached |= recorder.timeLimitReached;
+    }
+    if(searchLimitReached)
+        messageProcessor.onSearchLimitReached(
+            worldName, _quest->getQuest()->getName(), settings.searchLimit);
+    if(spaceLimitReached)
+        messageProcessor.onSpaceLimitReached(
+            worldName, _quest->getQuest()->getName(), settings.spaceLimit);
+    if(timeLimitReached)
+        messageProcessor.onTimeLimitReached(
+            worldName, _quest->getQuest()->getName(), settings.timeLimitUs);
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+}
+
+}
@@ -0,0 +1,31 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/message_processor.hpp>
+
+namespace mozok {
+
+/// @brief A message processor used by the portfolio searches. It only
+/// remembers which limits were reached, so the portfolio can decide later
+/// whether these events must be reported.
+class LimitRecorder : public MessageProcessor {
+public:
+    bool searchLimitReached = false;
+    bool spaceLimitReached = false;
+    bool timeLimitReached = false;
+
+    void onSearchLimitReached(
+            const Str&, const Str&, const int) noexcept override;
+
+    void onSpaceLimitReached(
+            const Str&, const Str&, const int) noexcept override;
+
+    void onTimeLimitReached(
+            const Str&, const Str&, const int) noexcept override;
+};
+
+}
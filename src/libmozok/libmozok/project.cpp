@@ -45,10 +45,40 @@ namespace {
     const char* KEYWORD_HEURISTIC = "heuristic";
     const char* KEYWORD_SIMPLE = "SIMPLE";
     const char* KEYWORD_HSP = "HSP";
+    const char* KEYWORD_HADD = "HADD";
+    const char* KEYWORD_HMAX = "HMAX";
+    const char* KEYWORD_FF = "FF";
+    const char* KEYWORD_LANDMARKS = "LANDMARKS";
+    const char* KEYWORD_PDB = "PDB";
+    const char* KEYWORD_PDB_MEMORY_LIMIT = "pdbMemoryLimit";
+    const char* KEYWORD_HEURISTIC_CACHE_SIZE = "heuristicCacheSize";
+    const char* KEYWORD_SEARCH_GRAPH_SIZE = "searchGraphSize";
+    const char* KEYWORD_REPAIR_LIMIT = "repairLimit";
+    const char* KEYWORD_ANYTIME_WEIGHT = "anytimeWeight";
+    const char* KEYWORD_TIME_LIMIT_US = "timeLimitUs";
+    const char* KEYWORD_IDA_TABLE_SIZE = "idaTableSize";
+    const char* KEYWORD_BEAM_WIDTH = "beamWidth";
     const char* KEYWORD_USE_ATREE = "use_atree";
+    const char* KEYWORD_FINGERPRINT_ONLY = "fingerprint_only";
+    const char* KEYWORD_CONCURRENT_GOALS = "concurrent_goals";
     const char* KEYWORD_STRATEGY = "strategy";
     const char* KEYWORD_ASTAR = "ASTAR";
     const char* KEYWORD_DFS = "DFS";
+    const char* KEYWORD_HDASTAR = "HDASTAR";
+    const char* KEYWORD_PORTFOLIO = "PORTFOLIO";
+    const char* KEYWORD_INCREMENTAL = "INCREMENTAL";
+    const char* KEYWORD_BACKWARD = "BACKWARD";
+    const char* KEYWORD_BIDIRECTIONAL = "BIDIRECTIONAL";
+    const char* KEYWORD_ANYTIME = "ANYTIME";
+    const char* KEYWORD_IDA = "IDA";
+    const char* KEYWORD_GBFS = "GBFS";
+    const char* KEYWORD_EHC = "EHC";
+    const char* KEYWORD_GRAPHPLAN = "GRAPHPLAN";
+    const char* KEYWORD_SAT = "SAT";
+    const char* KEYWORD_BEAM = "BEAM";
+    const char* KEYWORD_IW = "IW";
+    const char* KEYWORD_BFWS = "BFWS";
+    const char* KEYWORD_THREADS = "threads";
 }
 
 
@@ -585,6 +615,137 @@ public:
         return res;
     }
 
+    /// @brief Parses the value of a quest option (see `quest_definition`).
+    ///        The `use_atree` option has no value and isn't parsed here.
+    /// @param optionName The name of the option.
+    /// @param options The option and its value will be added here.
+    /// @return Returns 'Result::OK()' if the reading operation was successful.
+    ///         Otherwise, return a detailed error message.
+    Result quest_option_value(
+            const Str& optionName, 
+            Vector<Pair<QuestOption, int>>& options
+            ) noexcept {
+        Result res;
+        const Pair<const char*, QuestOption> intOptions[] = {
+            {KEYWORD_SEARCH_LIMIT, QUEST_OPTION_SEARCH_LIMIT},
+            {KEYWORD_SPACE_LIMIT, QUEST_OPTION_SPACE_LIMIT},
+            {KEYWORD_OMEGA, QUEST_OPTION_OMEGA},
+            {KEYWORD_THREADS, QUEST_OPTION_THREADS},
+            {KEYWORD_PDB_MEMORY_LIMIT, QUEST_OPTION_PDB_MEMORY_LIMIT},
+            {KEYWORD_HEURISTIC_CACHE_SIZE, QUEST_OPTION_HEURISTIC_CACHE_SIZE},
+            {KEYWORD_SEARCH_GRAPH_SIZE, QUEST_OPTION_SEARCH_GRAPH_SIZE},
+            {KEYWORD_REPAIR_LIMIT, QUEST_OPTION_REPAIR_LIMIT},
+            {KEYWORD_ANYTIME_WEIGHT, QUEST_OPTION_ANYTIME_WEIGHT},
+            {KEYWORD_TIME_LIMIT_US, QUEST_OPTION_TIME_LIMIT_US},
+            {KEYWORD_IDA_TABLE_SIZE, QUEST_OPTION_IDA_TABLE_SIZE},
+            {KEYWORD_BEAM_WIDTH, QUEST_OPTION_BEAM_WIDTH}
+        };
+        for(const Pair<const char*, QuestOption>& intOption : intOptions)
+            if(optionName == intOption.first) {
+                int value = 0;
+                res <<= space(1);
+                res <<= pos_int(value);
+                options.push_back({intOption.second, value});
+                return res;
+            }
+
+        if(optionName == KEYWORD_FINGERPRINT_ONLY) {
+            options.push_back({QUEST_OPTION_FINGERPRINT_ONLY, 1});
+        } else if(optionName == KEYWORD_CONCURRENT_GOALS) {
+            options.push_back({QUEST_OPTION_CONCURRENT_GOALS, 1});
+        } else if(optionName == KEYWORD_HEURISTIC) {
+            const Pair<const char*, QuestHeuristic> heuristics[] = {
+                {KEYWORD_SIMPLE, QuestHeuristic::SIMPLE},
+                {KEYWORD_HSP, QuestHeuristic::HSP},
+                {KEYWORD_HADD, QuestHeuristic::HADD},
+                {KEYWORD_HMAX, QuestHeuristic::HMAX},
+                {KEYWORD_FF, QuestHeuristic::FF},
+                {KEYWORD_LANDMARKS, QuestHeuristic::LANDMARKS},
+                {KEYWORD_PDB, QuestHeuristic::PDB}
+            };
+            res <<= space(1);
+            Str heuristicName;
+            res <<= name(heuristicName, UPPER);
+            if(res.isError())
+                return res;
+            for(const Pair<const char*, QuestHeuristic>& h : heuristics)
+                if(heuristicName == h.first) {
+                    options.push_back({QUEST_OPTION_HEURISTIC, h.second});
+                    return res;
+                }
+            res <<= errorParserError(_file, _line, _col, 
+                    "Unknown heuristic name '" + heuristicName + "'");
+        } else if(optionName == KEYWORD_STRATEGY) {
+            const Pair<const char*, QuestSearchStrategy> strategies[] = {
+                {KEYWORD_ASTAR, QuestSearchStrategy::ASTAR},
+                {KEYWORD_DFS, QuestSearchStrategy::DFS},
+                {KEYWORD_HDASTAR, QuestSearchStrategy::HDASTAR},
+                {KEYWORD_PORTFOLIO, QuestSearchStrategy::PORTFOLIO},
+                {KEYWORD_INCREMENTAL, QuestSearchStrategy::INCREMENTAL},
+                {KEYWORD_BACKWARD, QuestSearchStrategy::BACKWARD},
+                {KEYWORD_BIDIRECTIONAL, QuestSearchStrategy::BIDIRECTIONAL},
+                {KEYWORD_ANYTIME, QuestSearchStrategy::ANYTIME},
+                {KEYWORD_IDA, QuestSearchStrategy::IDA},
+                {KEYWORD_GBFS, QuestSearchStrategy::GBFS},
+                {KEYWORD_EHC, QuestSearchStrategy::EHC},
+                {KEYWORD_GRAPHPLAN, QuestSearchStrategy::GRAPHPLAN},
+                {KEYWORD_SAT, QuestSearchStrategy::SAT},
+                {KEYWORD_BEAM, QuestSearchStrategy::BEAM},
+                {KEYWORD_IW, QuestSearchStrategy::IW},
+                {KEYWORD_BFWS, QuestSearchStrategy::BFWS}
+            };
+            res <<= space(1);
+            Str strategyName;
+            res <<= name(strategyName, UPPER);
+            if(res.isError())
+                return res;
+            for(const Pair<const char*, QuestSearchStrategy>& s : strategies)
+                if(strategyName == s.first) {
+                    options.push_back({QUEST_OPTION_STRATEGY, s.second});
+                    return res;
+                }
+            res <<= errorParserError(_file, _line, _col, 
+                    "Unknown strategy name '" + strategyName + "'");
+        } else {
+            // Unknown option
+            res <<= errorParserError(_file, _line, _col, 
+                    "Unknown option '" + optionName + "'");
+        }
+        return res;
+    }
+
+    /// @brief Parses one quest option in the format of the `options:` section 
+    ///        of a quest definition (for example `strategy BEAM`), and sets 
+    ///        it for an already defined quest. The `use_atree` option can't 
+    ///        be changed after the quest definition.
+    /// @param questName The name of the quest.
+    /// @return Returns 'Result::OK()' if the operation was successful.
+    ///         Otherwise, return a detailed error message.
+    Result quest_option(const Str& questName) noexcept {
+        Result res;
+        Str optionName;
+        res <<= space(0);
+        res <<= name(optionName, LOWER);
+        if(res.isError())
+            return res;
+        if(optionName == KEYWORD_USE_ATREE)
+            return errorParserError(_file, _line, _col, 
+                    "Option '" + optionName + "' can't be changed");
+        Vector<Pair<QuestOption, int>> options;
+        res <<= quest_option_value(optionName, options);
+        res <<= space(0);
+        if(res.isError())
+            return res;
+        res <<= empty_lines();
+        if(_src[_pos] != '\0')
+            return errorParserError(_file, _line, _col, 
+                    "Unexpected symbols after the option value");
+        for(const Pair<QuestOption, int>& option : options)
+            res <<= _world->setQuestOption(
+                    questName, option.first, option.second);
+        return res;
+    }
+
     /// @brief Parses a quest definition.
     /// @param isMainQuest Is this quest is a main quest.
     /// @return Returns 'Result::OK()' if the reading operation was successful.
@@ -604,14 +765,8 @@ public:
             return res;
 
         // Parse quest options.
-        int spaceLimit = -1;
-        int searchLimit = -1;
-        int omega = -1;
-        bool setHeuristic = false;
-        bool setStrategy = false;
+        Vector<Pair<QuestOption, int>> options;
         bool useActionTree = false;
-        QuestHeuristic heuristic = QuestHeuristic::SIMPLE;
-        QuestSearchStrategy strategy = QuestSearchStrategy::ASTAR;
         res <<= empty_lines();
         res <<= space(1);
         if(keyword(KEYWORD_OPTIONS).isOk()) {
@@ -625,62 +780,23 @@ public:
                 res <<= space(1);
                 Str optionName;
                 res <<= name(optionName, LOWER);
-                if(optionName == KEYWORD_SEARCH_LIMIT) {
-                    res <<= space(1);
-                    res <<= pos_int(searchLimit);
-                } else if(optionName == KEYWORD_SPACE_LIMIT) {
-                    res <<= space(1);
-                    res <<= pos_int(spaceLimit);
-                } else if(optionName == KEYWORD_OMEGA) {
-                    res <<= space(1);
-                    res <<= pos_int(omega);
-                } else if(optionName == KEYWORD_HEURISTIC) {
-                    res <<= space(1);
-                    Str heuristicName;
-                    res <<= name(heuristicName, UPPER);
-                    if(heuristicName == KEYWORD_SIMPLE) {
-                        heuristic = QuestHeuristic::SIMPLE;
-                        setHeuristic = true;
-                    } else if (heuristicName == KEYWORD_HSP) {
-                        heuristic = QuestHeuristic::HSP;
-                        setHeuristic = true;
-                    } else {    
-                        res <<= errorParserError(_file, _line, _col, 
-                            "Unknown heuristic name '" + heuristicName + "'");
-                    }
-                } else if(optionName == KEYWORD_STRATEGY) {
-                    res <<= space(1);
-                    Str strategyName;
-                    res <<= name(strategyName, UPPER);
-                    if(strategyName == KEYWORD_ASTAR) {
-                        strategy = QuestSearchStrategy::ASTAR;
-                        setStrategy = true;
-                    } else if (strategyName == KEYWORD_DFS) {
-                        strategy = QuestSearchStrategy::DFS;
-                        setStrategy = true;
-                    } else {    
-                        res <<= errorParserError(_file, _line, _col, 
-                            "Unknown strategy name '" + strategyName + "'");
-                    }
-                } else if (optionName == KEYWORD_USE_ATREE) {
-                    useActionTree = true;
-                } else if(optionName == KEYWORD_PRECONDITIONS) {
+                if(optionName == KEYWORD_PRECONDITIONS) {
                     // This is the end of options list.
                     _pos -= _col;
                     _col = 0;
                     res <<= space(1);
                     break;
+                } else if (optionName == KEYWORD_USE_ATREE) {
+                    useActionTree = true;
                 } else {
-                    // Unknown option
-                    res <<= errorParserError(_file, _line, _col, 
-                            "Unknown option '" + optionName + "'");
-                    break;
+                    res <<= quest_option_value(optionName, options);
+                    if(res.isError())
+                        break;
                 }
                 res <<= space(0);
                 res <<= next_line();
             }
         }
-
         if(res.isError())
             return res;
         
@@ -742,21 +858,9 @@ public:
                 actions, objects, subquests, useActionTree);
         
         // Setup quest options.
-        if(searchLimit >= 0)
-            res <<= _world->setQuestOption(
-                    questName, QUEST_OPTION_SEARCH_LIMIT, searchLimit);
-        if(spaceLimit >= 0)
-            res <<= _world->setQuestOption(
-                    questName, QUEST_OPTION_SPACE_LIMIT, spaceLimit);
-        if(omega >= 0)
+        for(const Pair<QuestOption, int>& option : options)
             res <<= _world->setQuestOption(
-                    questName, QUEST_OPTION_OMEGA, omega);
-        if(setHeuristic)
-            res <<= _world->setQuestOption(
-                    questName, QUEST_OPTION_HEURISTIC, heuristic);
-        if(setStrategy)
-            res <<= _world->setQuestOption(
-                    questName, QUEST_OPTION_STRATEGY, strategy);
+                    questName, option.first, option.second);
 
         if(res.isError())
             res <<= errorParserWorldError(
@@ -841,4 +945,14 @@ Result addFromProjectSRC(
     return parseQuestFile(world, projectFileName, projectSrc);
 }
 
+Result setQuestOptionFromSRC(
+        World* world, 
+        const Str& questName, 
+        const Str& optionName,
+        const Str& optionValue
+        ) noexcept {
+    QuestProjectParser parser(world, questName, optionName + " " + optionValue);
+    return parser.quest_option(questName);
+}
+
 }
@@ -25,4 +25,19 @@ mozok::Result addFromProjectSRC(
         const mozok::Str& projectSrc
         ) noexcept;
 
+/// @brief Sets an option of a quest. The option is given in the format of the 
+///        `options:` section of the .quest format. 
+/// @param world The world of the quest.
+/// @param questName The name of the quest.
+/// @param optionName The name of the option (for example `strategy`).
+/// @param optionValue The value of the option (for example `BEAM`). Empty for 
+///        the options without a value (`fingerprint_only`).
+/// @return Returns the status of the operation.
+mozok::Result setQuestOptionFromSRC(
+        mozok::World* world, 
+        const mozok::Str& questName,
+        const mozok::Str& optionName,
+        const mozok::Str& optionValue
+        ) noexcept;
+
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <libmozok/statement.hpp>
 #include <libmozok/quest.hpp>
 
+#include <algorithm>
+
 namespace mozok {
 
 namespace {
@@ -46,6 +48,14 @@ bool QuestApplicableActionsIterator::actionCallback(
     ) noexcept
 { return true; }
 
+QuestPossibleActionsIterator::~QuestPossibleActionsIterator() noexcept 
+    = default;
+
+bool QuestPossibleActionsIterator::possibleActionCallback(
+        const SIZE_T /*possibleActionIndx*/
+    ) noexcept
+{ return true; }
+
 
 Quest::Quest(
         const Str& name, 
@@ -55,7 +65,8 @@ Quest::Quest(
         const ActionVec& actions,
         const ObjectVec& objects,
         const QuestVec& subquests,
-        const bool useActionTree
+        const bool useActionTree,
+        const StatementTablePtr& table
         ) noexcept :
     _name(name),
     _id(id),
@@ -69,15 +80,19 @@ Quest::Quest(
     _relevantActions(buildRelevantActions(actions)),
     _relevantObjects(buildRelevantObjects(objects)),
     _relevantRelations(buildRelevantRelations(actions)),
-    _possibleActions(buildPossibleActions())
+    _possibleActions(buildPossibleActions()),
+    _table(table),
+    _wordCount(0)
 {
+    buildStatementIndex();
+
     // Build the action tree.
     if(useActionTree) {
         HashSet<int> all;
         for(SIZE_T i=0; i<_possibleActions.size(); ++i)
             all.insert(int(i));
-        StatementSet empty;
-        _actionTree = buildActionTree(empty, nullptr, all);
+        HashSet<int> empty;
+        _actionTree = buildActionTree(empty, -1, all);
     }
 }
 
@@ -154,11 +169,209 @@ UnorderedSet<ID> Quest::buildRelevantRelations(
 Quest::PossibleActionVec Quest::buildPossibleActions() const noexcept {
     PossibleActionVec possibleActions;
     PossibleActionsBuilder it(possibleActions);
-    Vector<StatementVec> emptyPre;
-    iterateOverApplicableActions_Slow(nullState, it, emptyPre);
+    iterateOverApplicableActions_Slow(nullState, it);
     return possibleActions;
 }
 
+int Quest::addToStatementIndex(const StatementId id) noexcept {
+    if(SIZE_T(id) >= _statementIdToIndx.size())
+        _statementIdToIndx.resize(SIZE_T(id) + 1, -1);
+    if(_statementIdToIndx[id] >= 0)
+        return _statementIdToIndx[id];
+    const int indx = int(_statements.size());
+    _statementIdToIndx[id] = indx;
+    _statements.push_back(_table->getStatement(id));
+    _statementKeys.push_back(_table->getKey(id));
+    return indx;
+}
+
+void Quest::fillMask(
+        BitState::Word* mask, 
+        const StatementIdVec& ids
+        ) const noexcept {
+    for(const StatementId id : ids) {
+        const SIZE_T indx = SIZE_T(_statementIdToIndx[id]);
+        mask[indx / BitState::WORD_BITS] |= 
+                BitState::Word(1) << (indx % BitState::WORD_BITS);
+    }
+}
+
+void Quest::buildStatementIndex() noexcept {
+    StatementTable& table = *_table;
+
+    // Interned pre, rem and add lists of the possible actions.
+    Vector<StatementIdVec> lists(_possibleActions.size() * 3);
+    for(SIZE_T i = 0; i < _possibleActions.size(); ++i) {
+        const ActionWithArgs& aa = _possibleActions[i];
+        aa.action->getPreconditions().substituteIds(
+                table, aa.arguments, lists[i * 3 + 0]);
+        aa.action->getRemList().substituteIds(
+                table, aa.arguments, lists[i * 3 + 1]);
+        aa.action->getAddList().substituteIds(
+                table, aa.arguments, lists[i * 3 + 2]);
+    }
+
+    Vector<StatementIdVec> goals;
+    for(const Goal& goal : _goals) {
+        goals.push_back({});
+        for(const StatementPtr& st : goal)
+            goals.back().push_back(table.intern(st));
+    }
+
+    for(const StatementPtr& st : _preconditions)
+        addToStatementIndex(table.intern(st));
+    for(const StatementIdVec& goal : goals)
+        for(const StatementId id : goal)
+            addToStatementIndex(id);
+    for(const StatementIdVec& list : lists)
+        for(const StatementId id : list)
+            addToStatementIndex(id);
+
+    _wordCount = BitState::getWordCount(_statements.size());
+    _actionMasks.assign(lists.size() * _wordCount, BitState::Word(0));
+    for(SIZE_T i = 0; i < lists.size(); ++i)
+        fillMask(&_actionMasks[i * _wordCount], lists[i]);
+
+    _actionListOffsets.assign(1, SIZE_T(0));
+    for(const StatementIdVec& list : lists) {
+        const SIZE_T first = _actionLists.size();
+        for(const StatementId id : list)
+            _actionLists.push_back(_statementIdToIndx[id]);
+        // Remove the duplicates (the same as in the masks).
+        std::sort(_actionLists.begin() + first, _actionLists.end());
+        _actionLists.erase(
+                std::unique(_actionLists.begin() + first, _actionLists.end()),
+                _actionLists.end());
+        _actionListOffsets.push_back(_actionLists.size());
+    }
+
+    // Reverse the precondition and the add lists (counting sort by the 
+    // statement).
+    _preActionOffsets.assign(_statements.size() + 1, SIZE_T(0));
+    _addActionOffsets.assign(_statements.size() + 1, SIZE_T(0));
+    for(SIZE_T i = 0; i < _possibleActions.size(); ++i) {
+        for(const int indx : getActionPreList(i))
+            ++_preActionOffsets[SIZE_T(indx) + 1];
+        for(const int indx : getActionAddList(i))
+            ++_addActionOffsets[SIZE_T(indx) + 1];
+    }
+    for(SIZE_T i = 0; i < _statements.size(); ++i) {
+        _preActionOffsets[i + 1] += _preActionOffsets[i];
+        _addActionOffsets[i + 1] += _addActionOffsets[i];
+    }
+    _preActions.resize(_preActionOffsets.back());
+    _addActions.resize(_addActionOffsets.back());
+    Vector<SIZE_T> next(_preActionOffsets.begin(), _preActionOffsets.end() - 1);
+    Vector<SIZE_T> nextAdd(
+            _addActionOffsets.begin(), _addActionOffsets.end() - 1);
+    for(SIZE_T i = 0; i < _possibleActions.size(); ++i) {
+        for(const int indx : getActionPreList(i))
+            _preActions[next[SIZE_T(indx)]++] = int(i);
+        for(const int indx : getActionAddList(i))
+            _addActions[nextAdd[SIZE_T(indx)]++] = int(i);
+    }
+
+    for(const StatementIdVec& goal : goals) {
+        Vector<BitState::Word> mask(_wordCount, BitState::Word(0));
+        fillMask(mask.data(), goal);
+        BitState goalMask(_statements.size());
+        BitState::forEachBit(mask.data(), _wordCount, [&](const SIZE_T indx) {
+            goalMask.setBit(indx, _statementKeys);
+        });
+        _goalMasks.push_back(goalMask);
+    }
+}
+
+SIZE_T Quest::getStatementCount() const noexcept {
+    return _statements.size();
+}
+
+int Quest::getStatementIndx(const StatementPtr& statement) const noexcept {
+    const StatementId id = _table->find(statement);
+    if(id == INVALID_STATEMENT_ID)
+        return -1;
+    return getStatementIndx(id);
+}
+
+int Quest::getStatementIndx(const StatementId id) const noexcept {
+    if(SIZE_T(id) >= _statementIdToIndx.size())
+        return -1;
+    return _statementIdToIndx[id];
+}
+
+const StatementPtr& Quest::getIndexedStatement(
+        const SIZE_T indx) const noexcept {
+    return _statements[indx];
+}
+
+const Vector<Fingerprint>& Quest::getStatementKeys() const noexcept {
+    return _statementKeys;
+}
+
+IndxRange Quest::getActionPreList(
+        const SIZE_T possibleActionIndx) const noexcept {
+    const int* lists = _actionLists.data();
+    return {lists + _actionListOffsets[possibleActionIndx * 3 + 0],
+            lists + _actionListOffsets[possibleActionIndx * 3 + 1]};
+}
+
+IndxRange Quest::getActionRemList(
+        const SIZE_T possibleActionIndx) const noexcept {
+    const int* lists = _actionLists.data();
+    return {lists + _actionListOffsets[possibleActionIndx * 3 + 1],
+            lists + _actionListOffsets[possibleActionIndx * 3 + 2]};
+}
+
+IndxRange Quest::getActionAddList(
+        const SIZE_T possibleActionIndx) const noexcept {
+    const int* lists = _actionLists.data();
+    return {lists + _actionListOffsets[possibleActionIndx * 3 + 2],
+            lists + _actionListOffsets[possibleActionIndx * 3 + 3]};
+}
+
+IndxRange Quest::getStatementPreActions(
+        const SIZE_T statementIndx) const noexcept {
+    const int* actions = _preActions.data();
+    return {actions + _preActionOffsets[statementIndx],
+            actions + _preActionOffsets[statementIndx + 1]};
+}
+
+IndxRange Quest::getStatementAddActions(
+        const SIZE_T statementIndx) const noexcept {
+    const int* actions = _addActions.data();
+    return {actions + _addActionOffsets[statementIndx],
+            actions + _addActionOffsets[statementIndx + 1]};
+}
+
+const BitState::Word* Quest::getActionPreMask(
+        const SIZE_T possibleActionIndx) const noexcept {
+    return &_actionMasks[(possibleActionIndx * 3 + 0) * _wordCount];
+}
+
+const BitState::Word* Quest::getActionRemMask(
+        const SIZE_T possibleActionIndx) const noexcept {
+    return &_actionMasks[(possibleActionIndx * 3 + 1) * _wordCount];
+}
+
+const BitState::Word* Quest::getActionAddMask(
+        const SIZE_T possibleActionIndx) const noexcept {
+    return &_actionMasks[(possibleActionIndx * 3 + 2) * _wordCount];
+}
+
+const BitState& Quest::getGoalMask(const SIZE_T goalIndx) const noexcept {
+    return _goalMasks[goalIndx];
+}
+
+BitStatePtr Quest::makeBitState(const StatePtr& state) const noexcept {
+    BitStatePtr res = makeShared<BitState>(_statements.size());
+    state->forEachStatementId([&](const StatementId id) {
+        const int indx = getStatementIndx(id);
+        if(indx >= 0)
+            res->setBit(SIZE_T(indx), _statementKeys);
+    });
+    return res;
+}
+
 const Str& Quest::getName() const noexcept {
     return _name;
 }
@@ -200,8 +413,7 @@ const Quest::PossibleActionVec& Quest::getPossibleActions() const noexcept {
 
 void Quest::iterateOverApplicableActions_Slow(
             const StatePtr& state,
-            QuestApplicableActionsIterator& it,
-            Vector<StatementVec>& actionPreBuffers
+            QuestApplicableActionsIterator& it
             ) const noexcept {
     for(ActionVec::size_type actionIndx = 0; 
             actionIndx < _actions.size(); ++actionIndx) {
@@ -210,7 +422,7 @@ void Quest::iterateOverApplicableActions_Slow(
             if(action->getArguments().size() > 0)
                 continue; // This action is not applicable.
         ObjectVec objects(action->getArguments().size(), ObjectPtr(nullptr));
-        if(findNextObj(state, it, actionPreBuffers, 
+        if(findNextObj(state, it, 
                 objects, actionIndx, 0, SIZE_T(0), SIZE_T(1)) == false)
             break; // Stop the search.
     }
@@ -218,49 +430,50 @@ void Quest::iterateOverApplicableActions_Slow(
 
 namespace {
 class PopularityCmp {
-    StatementMap<HashSet<int>> &_reverseIndx;
+    HashMap<int, HashSet<int>> &_reverseIndx;
 public:
-    PopularityCmp(StatementMap<HashSet<int>> &reverseIndx)
+    PopularityCmp(HashMap<int, HashSet<int>> &reverseIndx)
     : _reverseIndx(reverseIndx)
     { /* empty */ }
 
-    bool operator()(const StatementPtr& a, const StatementPtr& b) const noexcept {
-        return _reverseIndx[a].size() < _reverseIndx[b].size();
+    bool operator()(const int a, const int b) const noexcept {
+        const SIZE_T aSize = _reverseIndx[a].size();
+        const SIZE_T bSize = _reverseIndx[b].size();
+        if(aSize != bSize)
+            return aSize < bSize;
+        return a > b; // deterministic order of equally popular statements
     }
 }; 
 }
 
 struct Quest::ActionNode {
-    StatementPtr precondition; // can be `nullptr`
+    int preconditionIndx; // dense index of the precondition (or `-1`)
     Vector<ActionNodePtr> children; // empty for leaf nodes
     Vector<int> actions;
 };
 
 Quest::ActionNodePtr Quest::buildActionTree(
-        StatementSet &all,
-        const StatementPtr& last,
+        HashSet<int> &all,
+        const int last,
         HashSet<int> &actions
         ) const noexcept {
     ActionNodePtr node = makeShared<ActionNode>();
-    node->precondition = last;
+    node->preconditionIndx = last;
 
     // reverseIndx[precondition] = {actions with the precondition}
-    StatementMap<HashSet<int>> reverseIndx;
+    HashMap<int, HashSet<int>> reverseIndx;
 
     for(const int actionIndx : actions) {
-        const auto& pa = _possibleActions[actionIndx];
-        const auto& pre = pa.action->getPreconditions();
-        StatementVec preStatements = pre.substitute(pa.arguments);
-        for(const auto &st : preStatements) {
-            if(all.find(st) != all.end())
+        for(const int pre : getActionPreList(SIZE_T(actionIndx))) {
+            if(all.find(pre) != all.end())
                 continue;
-            reverseIndx[st].insert(actionIndx);
+            reverseIndx[pre].insert(actionIndx);
         }
     }
 
     // Create a queue of popular precondition statements.
     PopularityCmp popularityCmp(reverseIndx);
-    PriorityQueue<StatementPtr, PopularityCmp> popularPreconditions(popularityCmp);
+    PriorityQueue<int, PopularityCmp> popularPreconditions(popularityCmp);
     for(const auto& pre : reverseIndx)
         popularPreconditions.push(pre.first);
 
@@ -268,7 +481,7 @@ Quest::ActionNodePtr Quest::buildActionTree(
     while(popularPreconditions.empty() == false) {
         if(actions.empty())
             break;
-        const StatementPtr &pre = popularPreconditions.top();
+        const int pre = popularPreconditions.top();
         auto& selected = reverseIndx[pre];
         for(const int actionIndx : selected)
             actions.erase(actionIndx);
@@ -287,64 +500,51 @@ Quest::ActionNodePtr Quest::buildActionTree(
 
 bool Quest::iterateNext(
             const ActionNodePtr& node,
-            const StatePtr& state,
-            QuestApplicableActionsIterator& it,
-            Vector<StatementVec>& actionPreBuffers
+            const BitState& state,
+            QuestPossibleActionsIterator& it
             ) const noexcept {
     // Check node precondition.
-    if(node->precondition)
-        if(state->hasSubstate({node->precondition}) == false)
+    if(node->preconditionIndx >= 0)
+        if(state.hasBit(SIZE_T(node->preconditionIndx)) == false)
             return true;
     
     // Iterate trough the actions without additional preconditions.
-    for(const int actionIndx : node->actions) {
-        const ActionWithArgs aa = _possibleActions[actionIndx];
-        if(it.actionCallback(
-                aa.action, aa.arguments, aa.combinedIndx) == false)
+    for(const int actionIndx : node->actions)
+        if(it.possibleActionCallback(SIZE_T(actionIndx)) == false)
             return false;
-    }
 
     // Iterate trough actions with preconditions.
     for(const auto& child : node->children)
-        if(iterateNext(child, state, it, actionPreBuffers) == false)
+        if(iterateNext(child, state, it) == false)
             return false;
 
     return true;
 }
 
 void Quest::iterateOverApplicableActions_AT(
-            const StatePtr& state,
-            QuestApplicableActionsIterator& it,
-            Vector<StatementVec>& actionPreBuffers
+            const BitState& state,
+            QuestPossibleActionsIterator& it
             ) const noexcept {
-    iterateNext(_actionTree, state, it, actionPreBuffers);
+    iterateNext(_actionTree, state, it);
 }
 
 void Quest::iterateOverApplicableActions(
-            const StatePtr& state,
-            QuestApplicableActionsIterator& it,
-            Vector<StatementVec>& actionPreBuffers
+            const BitState& state,
+            QuestPossibleActionsIterator& it
             ) const noexcept {
     // If enabled, use the action tree.
     if(_actionTree) {
-        iterateOverApplicableActions_AT(state, it, actionPreBuffers);
+        iterateOverApplicableActions_AT(state, it);
         return;
     }
 
     // Otherwise, use the _possibleActions array.
-    for(const ActionWithArgs& aa : _possibleActions) {
+    for(SIZE_T i = 0; i < _possibleActions.size(); ++i) {
         // Objects were selected in such a way that they are suitable by types,
         // but we need to verify if they also satisfy the action preconditions.
-        if(state != nullState) {
-            if(aa.action->checkActionPreconditions(
-                    aa.arguments, state, 
-                    actionPreBuffers[aa.combinedIndx % _actions.size()]
-                    ) == false)
-                continue;
-        }
-        if(it.actionCallback(
-                aa.action, aa.arguments, 
-                aa.combinedIndx) == false)
+        if(state.hasSubstate(getActionPreMask(i)) == false)
+            continue;
+        if(it.possibleActionCallback(i) == false)
             break;
     }
 }
@@ -352,7 +552,6 @@ void Quest::iterateOverApplicableActions(
 bool Quest::findNextObj(
         const StatePtr& state,
         QuestApplicableActionsIterator& it,
-        Vector<StatementVec>& actionPreBuffers,
         ObjectVec &objects,
         ObjectVec::size_type actionIndx,
         ObjectVec::size_type argIndx,
@@ -366,8 +565,7 @@ bool Quest::findNextObj(
         // Objects were selected in such a way that they are suitable by types,
         // but we need to verify if they also satisfy the action preconditions.
         if(state != nullState)
-            if(action->checkActionPreconditions(
-                    objects, state, actionPreBuffers[actionIndx]) == false)
+            if(action->checkActionPreconditions(objects, state) == false)
                 return true;
         // Call the callback function and return the call's result.
         return it.actionCallback(
@@ -387,7 +585,7 @@ bool Quest::findNextObj(
             continue;
         objects[argIndx] = obj;
         if(findNextObj(
-                state, it, actionPreBuffers, objects, actionIndx, 
+                state, it, objects, actionIndx, 
                 argIndx + 1, combinedIndx + i * combinedSize,
                 combinedSize * multiplier) == false)
             return false;
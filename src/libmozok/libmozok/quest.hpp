@@ -8,6 +8,9 @@
 
 #include <libmozok/statement.hpp>
 #include <libmozok/action.hpp>
+#include <libmozok/state.hpp>
+#include <libmozok/statement_table.hpp>
+#include <libmozok/bit_state.hpp>
 
 namespace mozok {
 
@@ -18,6 +21,16 @@ using QuestVec = Vector<QuestPtr>;
 using Goal = StatementVec;
 using GoalVec = Vector<Goal>;
 
+/// @brief A contiguous range of dense indices (statements or actions).
+struct IndxRange {
+    const int* first;
+    const int* last;
+
+    const int* begin() const noexcept { return first; }
+    const int* end() const noexcept { return last; }
+    SIZE_T size() const noexcept { return SIZE_T(last - first); }
+};
+
 
 /// @brief A callback class for the `Quest::iterateOverApplicableActions(...)`.
 class QuestApplicableActionsIterator {
@@ -39,6 +52,23 @@ public:
 };
 
 
+/// @brief A callback class for the `Quest::iterateOverApplicableActions(...)`.
+/// Unlike `QuestApplicableActionsIterator`, it receives the index of the 
+/// applicable action in the `Quest::getPossibleActions()` vector.
+class QuestPossibleActionsIterator {
+public:
+    virtual ~QuestPossibleActionsIterator() noexcept;
+
+    /// @brief This method will be invoked for the next applicable action.
+    /// @param possibleActionIndx Index of the applicable action in the 
+    ///        `Quest::getPossibleActions()` vector.
+    /// @return Return `true` if you want to continue the search. 
+    ///         Return `false` if you want to stop the search.
+    virtual bool possibleActionCallback(
+            const SIZE_T /*possibleActionIndx*/) noexcept;
+};
+
+
 /// @brief Quest contains preconditions, goals, related actions and objects and 
 ///        sub-quests.
 /// A quest outlines player goals and the methods to achieve them. A quest may 
@@ -113,13 +143,9 @@ private:
     /// @param state The state from which do the search. If `state` is 
     ///         `nullptr`, it will not check the action preconditions.
     /// @param it Callback object.
-    /// @param actionPreBuffers Action's pre-buffer (see 
-    ///         `QuestPlanner::_actionPreBuffers` for the description).
-    ///         Not used when state is `nullptr`.
     void iterateOverApplicableActions_Slow(
             const StatePtr& state,
-            QuestApplicableActionsIterator& it,
-            Vector<StatementVec>& actionPreBuffers
+            QuestApplicableActionsIterator& it
             ) const noexcept;
 
     /// @brief Action tree node.
@@ -135,35 +161,80 @@ private:
     using ActionNodePtr = SharedPtr<ActionNode>;
     ActionNodePtr _actionTree;
 
+    /// @brief The statement table of the world this quest belongs to.
+    const StatementTablePtr _table;
+
+    /// @brief Dense statement index: all statements that can be checked or 
+    ///        changed by the possible actions, or are part of the quest 
+    ///        preconditions or goals. `_statements[i]` has the index `i`.
+    StatementVec _statements;
+
+    /// @brief `_statementIdToIndx[id]` is the dense index of the statement 
+    ///        with the given `StatementId`, or `-1` if it is irrelevant.
+    Vector<int> _statementIdToIndx;
+
+    /// @brief `_statementKeys[i]` is the Zobrist key of `_statements[i]`.
+    Vector<Fingerprint> _statementKeys;
+
+    /// @brief The width of all the `BitState` masks (in words).
+    SIZE_T _wordCount;
+
+    /// @brief Precondition, remove and add masks of the possible actions.
+    /// The masks of the i-th action start at `i * 3 * _wordCount`.
+    Vector<BitState::Word> _actionMasks;
+
+    /// @brief Precondition, remove and add lists of the possible actions, as 
+    ///        sorted dense statement indices, stored in one flat array. 
+    /// The k-th list (0 - pre, 1 - rem, 2 - add) of the i-th action is 
+    /// `_actionLists[_actionListOffsets[i*3+k] .. _actionListOffsets[i*3+k+1])`.
+    Vector<int> _actionLists;
+    Vector<SIZE_T> _actionListOffsets;
+
+    /// @brief The reverse of the precondition lists: the possible actions 
+    ///        that have the i-th statement as a precondition are 
+    ///        `_preActions[_preActionOffsets[i] .. _preActionOffsets[i+1])`.
+    Vector<int> _preActions;
+    Vector<SIZE_T> _preActionOffsets;
+
+    /// @brief The reverse of the add lists (the achievers of the statements), 
+    ///        used by the regression search. The same layout as above.
+    Vector<int> _addActions;
+    Vector<SIZE_T> _addActionOffsets;
+
+    /// @brief `_goalMasks[i]` is the mask of the i-th quest goal.
+    Vector<BitState> _goalMasks;
+
+    /// @brief Builds the dense statement index and the action and goal masks.
+    void buildStatementIndex() noexcept;
+    int addToStatementIndex(const StatementId id) noexcept;
+    void fillMask(
+            BitState::Word* mask, 
+            const StatementIdVec& ids) const noexcept;
+
     ActionNodePtr buildActionTree(
-            StatementSet &all,
-            const StatementPtr& last,
+            HashSet<int> &all,
+            const int last,
             HashSet<int> &actions
             ) const noexcept;
 
     bool iterateNext(
             const ActionNodePtr& node,
-            const StatePtr& state,
-            QuestApplicableActionsIterator& it,
-            Vector<StatementVec>& actionPreBuffers
+            const BitState& state,
+            QuestPossibleActionsIterator& it
             ) const noexcept;
 
     /// @brief Iterate, using the action tree. 
     /// Action tree take some additional time and space to make.
     /// Can dramatically improve the planning speed for complex tasks.
     void iterateOverApplicableActions_AT(
-            const StatePtr& state,
-            QuestApplicableActionsIterator& it,
-            Vector<StatementVec>& actionPreBuffers
+            const BitState& state,
+            QuestPossibleActionsIterator& it
             ) const noexcept;
 
     /// @brief Iterates trough all allowed objects for a given allowed action.
     /// @param state The state from which the search occurs. If `state` is 
     ///         `nullptr` then it will skip checking the action preconditions.
     /// @param it Callback object.
-    /// @param actionPreBuffers Action's pre-buffer (see 
-    ///         `QuestPlanner::_actionPreBuffers` for the description).
-    ///         Not used when state is `nullptr`.
     /// @param objects Current list of selected allowed objects.
     /// @param actionIndx Action's index in the list of quest's allowed actions.
     /// @param argIndx Action argument index (starting from 0).
@@ -176,7 +247,6 @@ private:
     bool findNextObj(
             const StatePtr& state,
             QuestApplicableActionsIterator& it,
-            Vector<StatementVec>& actionPreBuffers,
             ObjectVec &objects,
             ObjectVec::size_type actionIndx,
             ObjectVec::size_type argIndx,
@@ -193,7 +263,8 @@ public:
         const ActionVec& actions,
         const ObjectVec& objects,
         const QuestVec& subquests,
-        const bool useActionTree
+        const bool useActionTree,
+        const StatementTablePtr& table
         ) noexcept;
 
     const Str& getName() const noexcept;
@@ -206,18 +277,76 @@ public:
     const QuestVec& getSubquests() const noexcept;
 
     /// @brief Iterates trough the possible applicable actions.
-    /// @param state The state from which the search occurs. If `state` is 
-    ///         `nullptr`, it will not check the action preconditions.
+    /// @param state The state from which the search occurs.
     /// @param it Callback object.
-    /// @param actionPreBuffers Action's pre-buffer (see 
-    ///         `QuestPlanner::_actionPreBuffers` for the description).
-    ///         Not used when state is `nullptr`.
     void iterateOverApplicableActions(
-            const StatePtr& state,
-            QuestApplicableActionsIterator& it,
-            Vector<StatementVec>& actionPreBuffers
+            const BitState& state,
+            QuestPossibleActionsIterator& it
             ) const noexcept;
 
+    /// @brief Returns the number of statements in the dense statement index 
+    ///        (the width of the quest's `BitState`s in bits).
+    SIZE_T getStatementCount() const noexcept;
+
+    /// @brief Returns the dense index of a statement, or `-1` if the statement 
+    ///        is irrelevant to the planning (it can't be checked or changed 
+    ///        by any possible action and it isn't a part of any goal).
+    int getStatementIndx(const StatementPtr& statement) const noexcept;
+
+    /// @brief Returns the dense index of an interned statement, or `-1` if 
+    ///        the statement is irrelevant (see above).
+    int getStatementIndx(const StatementId id) const noexcept;
+
+    /// @brief Returns the statement with the given dense index.
+    const StatementPtr& getIndexedStatement(const SIZE_T indx) const noexcept;
+
+    /// @brief Hash values of the indexed statements (see `BitState`).
+    const Vector<Fingerprint>& getStatementKeys() const noexcept;
+
+    /// @brief Returns the preconditions mask of a possible action.
+    const BitState::Word* getActionPreMask(
+            const SIZE_T possibleActionIndx) const noexcept;
+
+    /// @brief Returns the remove mask of a possible action.
+    const BitState::Word* getActionRemMask(
+            const SIZE_T possibleActionIndx) const noexcept;
+
+    /// @brief Returns the add mask of a possible action.
+    const BitState::Word* getActionAddMask(
+            const SIZE_T possibleActionIndx) const noexcept;
+
+    /// @brief Returns the dense indices of the preconditions of a possible 
+    ///        action.
+    IndxRange getActionPreList(
+            const SIZE_T possibleActionIndx) const noexcept;
+
+    /// @brief Returns the dense indices of the statements removed by a 
+    ///        possible action.
+    IndxRange getActionRemList(
+            const SIZE_T possibleActionIndx) const noexcept;
+
+    /// @brief Returns the dense indices of the statements added by a 
+    ///        possible action.
+    IndxRange getActionAddList(
+            const SIZE_T possibleActionIndx) const noexcept;
+
+    /// @brief Returns the indices of the possible actions that have the 
+    ///        statement with the given dense index as a precondition.
+    IndxRange getStatementPreActions(const SIZE_T statementIndx) const noexcept;
+
+    /// @brief Returns the indices of the possible actions that add the 
+    ///        statement with the given dense index.
+    IndxRange getStatementAddActions(const SIZE_T statementIndx) const noexcept;
+
+    /// @brief Returns the mask of the goal.
+    const BitState& getGoalMask(const SIZE_T goalIndx) const noexcept;
+
+    /// @brief Creates the dense representation of the quest substate. 
+    ///        Irrelevant statements (see `getStatementIndx`) are skipped.
+    /// @param state A quest state.
+    /// @return Returns the new dense state.
+    BitStatePtr makeBitState(const StatePtr& state) const noexcept;
+
     /// @brief Checks if given action is listed as allowed for this quest.
     /// @param actionId Action's unique ID.
     /// @return Returns `true` if action is listed as allowed for this quest.
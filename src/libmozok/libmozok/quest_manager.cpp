@@ -11,6 +11,77 @@ const int DEFAULT_SPACE_LIMIT = 10000;
 const int DEFAULT_OMEGA = 0;
 const QuestHeuristic DEFAULT_HEURISTIC = QuestHeuristic::SIMPLE;
 const QuestSearchStrategy DEFAULT_STRATEGY = QuestSearchStrategy::ASTAR;
+const int DEFAULT_THREADS = 4;
+const bool DEFAULT_FINGERPRINT_ONLY = false;
+const int DEFAULT_PDB_MEMORY_LIMIT = 16384;
+const int DEFAULT_HEURISTIC_CACHE_SIZE = 65536;
+const int DEFAULT_REPAIR_LIMIT = 100;
+const int DEFAULT_ANYTIME_WEIGHT = 5;
+const int DEFAULT_TIME_LIMIT_US = 0;
+const int DEFAULT_IDA_TABLE_SIZE = 0;
+const int DEFAULT_BEAM_WIDTH = 100;
+const bool DEFAULT_CONCURRENT_GOALS = false;
+const int DEFAULT_SEARCH_GRAPH_SIZE = 65536;
+
+Str questHeuristicToStr(const QuestHeuristic heuristic) noexcept {
+    switch(heuristic) {
+        case QuestHeuristic::SIMPLE:
+            return "SIMPLE";
+        case QuestHeuristic::HSP:
+            return "HSP";
+        case QuestHeuristic::HADD:
+            return "HADD";
+        case QuestHeuristic::HMAX:
+            return "HMAX";
+        case QuestHeuristic::FF:
+            return "FF";
+        case QuestHeuristic::LANDMARKS:
+            return "LANDMARKS";
+        case QuestHeuristic::PDB:
+            return "PDB";
+        default:
+            return "???";
+    }
+}
+
+Str questSearchStrategyToStr(const QuestSearchStrategy strategy) noexcept {
+    switch(strategy) {
+        case QuestSearchStrategy::ASTAR:
+            return "ASTAR";
+        case QuestSearchStrategy::DFS:
+            return "DFS";
+        case QuestSearchStrategy::HDASTAR:
+            return "HDASTAR";
+        case QuestSearchStrategy::PORTFOLIO:
+            return "PORTFOLIO";
+        case QuestSearchStrategy::INCREMENTAL:
+            return "INCREMENTAL";
+        case QuestSearchStrategy::BACKWARD:
+            return "BACKWARD";
+        case QuestSearchStrategy::BIDIRECTIONAL:
+            return "BIDIRECTIONAL";
+        case QuestSearchStrategy::ANYTIME:
+            return "ANYTIME";
+        case QuestSearchStrategy::IDA:
+            return "IDA";
+        case QuestSearchStrategy::GBFS:
+            return "GBFS";
+        case QuestSearchStrategy::EHC:
+            return "EHC";
+        case QuestSearchStrategy::GRAPHPLAN:
+            return "GRAPHPLAN";
+        case QuestSearchStrategy::SAT:
+            return "SAT";
+        case QuestSearchStrategy::BEAM:
+            return "BEAM";
+        case QuestSearchStrategy::IW:
+            return "IW";
+        case QuestSearchStrategy::BFWS:
+            return "BFWS";
+        default:
+            return "???";
+    }
+}
 
 QuestManager::QuestManager(
         const QuestPtr& quest
@@ -25,10 +96,26 @@ QuestManager::QuestManager(
         /*.spaceLimit = */DEFAULT_SPACE_LIMIT,
         /*.omega = */DEFAULT_OMEGA,
         /*.heuristic = */DEFAULT_HEURISTIC,
-        /*.strategy = */DEFAULT_STRATEGY
+        /*.strategy = */DEFAULT_STRATEGY,
+        /*.threads = */DEFAULT_THREADS,
+        /*.fingerprintOnly = */DEFAULT_FINGERPRINT_ONLY,
+        /*.pdbMemoryLimit = */DEFAULT_PDB_MEMORY_LIMIT,
+        /*.heuristicCacheSize = */DEFAULT_HEURISTIC_CACHE_SIZE,
+        /*.repairLimit = */DEFAULT_REPAIR_LIMIT,
+        /*.anytimeWeight = */DEFAULT_ANYTIME_WEIGHT,
+        /*.timeLimitUs = */DEFAULT_TIME_LIMIT_US,
+        /*.idaTableSize = */DEFAULT_IDA_TABLE_SIZE,
+        /*.beamWidth = */DEFAULT_BEAM_WIDTH,
+        /*.concurrentGoals = */DEFAULT_CONCURRENT_GOALS,
+        /*.searchGraphSize = */DEFAULT_SEARCH_GRAPH_SIZE
     }),
     _parentQuest(nullptr),
-    _parentQuestGoal(-1)
+    _parentQuestGoal(-1),
+    _reusedPlans(0),
+    _repairedPlans(0),
+    _searchedPlans(0),
+    _cachedHeuristic(DEFAULT_HEURISTIC),
+    _cachedOmega(DEFAULT_OMEGA)
 { /* empty */ }
 
 const QuestPtr& QuestManager::getQuest() const noexcept {
@@ -86,6 +173,8 @@ void QuestManager::setOption(
         const QuestOption option, 
         const int value
         ) noexcept {
+    // The anytime search was started with the old settings.
+    _anytimeSearch.reset();
     switch (option) {
     case QUEST_OPTION_SEARCH_LIMIT:
         _settings.searchLimit = value;
@@ -102,6 +191,39 @@ void QuestManager::setOption(
     case QUEST_OPTION_STRATEGY:
         _settings.strategy = QuestSearchStrategy(value);
         break;
+    case QUEST_OPTION_THREADS:
+        _settings.threads = value;
+        break;
+    case QUEST_OPTION_FINGERPRINT_ONLY:
+        _settings.fingerprintOnly = (value != 0);
+        break;
+    case QUEST_OPTION_PDB_MEMORY_LIMIT:
+        _settings.pdbMemoryLimit = value;
+        break;
+    case QUEST_OPTION_HEURISTIC_CACHE_SIZE:
+        _settings.heuristicCacheSize = value;
+        break;
+    case QUEST_OPTION_REPAIR_LIMIT:
+        _settings.repairLimit = value;
+        break;
+    case QUEST_OPTION_ANYTIME_WEIGHT:
+        _settings.anytimeWeight = value;
+        break;
+    case QUEST_OPTION_TIME_LIMIT_US:
+        _settings.timeLimitUs = value;
+        break;
+    case QUEST_OPTION_IDA_TABLE_SIZE:
+        _settings.idaTableSize = value;
+        break;
+    case QUEST_OPTION_BEAM_WIDTH:
+        _settings.beamWidth = value;
+        break;
+    case QUEST_OPTION_CONCURRENT_GOALS:
+        _settings.concurrentGoals = (value != 0);
+        break;
+    case QUEST_OPTION_SEARCH_GRAPH_SIZE:
+        _settings.searchGraphSize = value;
+        break;
     default:
         // skip
         break;
@@ -124,12 +246,90 @@ int QuestManager::getParentQuestGoal() const noexcept {
     return _parentQuestGoal;
 }
 
+LandmarkGraphPtr QuestManager::getLandmarks(const ID goalIndx) const noexcept {
+    if(SIZE_T(goalIndx) >= _landmarks.size())
+        return nullptr;
+    return _landmarks[SIZE_T(goalIndx)];
+}
+
+PatternDatabasePtr QuestManager::getPatternDatabase(
+        const ID goalIndx) const noexcept {
+    if(SIZE_T(goalIndx) >= _patternDatabases.size())
+        return nullptr;
+    return _patternDatabases[SIZE_T(goalIndx)];
+}
+
+HeuristicCache* QuestManager::getHeuristicCache(
+        const ID goalIndx) const noexcept {
+    if(SIZE_T(goalIndx) >= _heuristicCaches.size())
+        return nullptr;
+    return _heuristicCaches[SIZE_T(goalIndx)].get();
+}
+
+SearchGraph* QuestManager::getSearchGraph(const ID goalIndx) const noexcept {
+    if(SIZE_T(goalIndx) >= _searchGraphs.size())
+        return nullptr;
+    return _searchGraphs[SIZE_T(goalIndx)].get();
+}
+
+void QuestManager::setAnytimeSearch(const AnytimeSearchPtr& search) noexcept {
+    _anytimeSearch = search;
+}
+
+bool QuestManager::hasAnytimeSearch() const noexcept {
+    return _anytimeSearch != nullptr;
+}
+
+void QuestManager::updateHeuristicCaches() noexcept {
+    // The cached values are valid only for the same heuristic.
+    if(_cachedHeuristic != _settings.heuristic
+            || _cachedOmega != _settings.omega) {
+        _heuristicCaches.clear();
+        _searchGraphs.clear();
+        _cachedHeuristic = _settings.heuristic;
+        _cachedOmega = _settings.omega;
+    }
+    const SIZE_T goalCount = _quest->getGoals().size();
+
+    if(_settings.strategy == QuestSearchStrategy::INCREMENTAL) {
+        _heuristicCaches.clear();
+        _searchGraphs.resize(goalCount);
+        for(SearchGraphPtr& graph : _searchGraphs)
+            if(graph == nullptr 
+                    || graph->size() > SIZE_T(_settings.searchGraphSize))
+                graph = makeShared<SearchGraph>(_settings.fingerprintOnly);
+        return;
+    }
+    _searchGraphs.clear();
+
+    const bool isMultiThreaded = 
+            _settings.strategy == QuestSearchStrategy::PORTFOLIO
+            || (_settings.strategy == QuestSearchStrategy::HDASTAR 
+                && _settings.threads > 1);
+    if(_settings.heuristicCacheSize <= 0
+            || _settings.heuristic == QuestHeuristic::LANDMARKS
+            || _settings.strategy == QuestSearchStrategy::ANYTIME
+            || isMultiThreaded) {
+        _heuristicCaches.clear();
+        return;
+    }
+    if(_heuristicCaches.empty() == false
+            && _heuristicCaches.front()->getCapacity() 
+                == SIZE_T(_settings.heuristicCacheSize))
+        return;
+    _heuristicCaches.clear();
+    for(SIZE_T i = 0; i < goalCount; ++i)
+        _heuristicCaches.push_back(makeShared<HeuristicCache>(
+                SIZE_T(_settings.heuristicCacheSize)));
+}
+
 bool QuestManager::performPlanning(
         const Str& worldName,
         const ID substateId,
         const StatePtr& state,
         QuestManagerPtr& questManager,
-        MessageProcessor& messageProcessor
+        MessageProcessor& messageProcessor,
+        const int serverTimeLimitUs
         ) noexcept {
     // Skip inactivated quests.
     if(questManager->getStatus() == MOZOK_QUEST_STATUS_INACTIVE)
@@ -143,16 +343,122 @@ bool QuestManager::performPlanning(
     if(questManager->getStatus() == MOZOK_QUEST_STATUS_UNREACHABLE)
         return false; 
 
+    // The quest's own time limit overrides the one of the server.
+    QuestSettings settings = questManager->_settings;
+    if(settings.timeLimitUs <= 0)
+        settings.timeLimitUs = serverTimeLimitUs;
+
     // The status is already known for the given state.
-    if(questManager->getLastSubstateId() >= substateId)
-        return false;
+    if(questManager->getLastSubstateId() >= substateId) {
+        if(questManager->_anytimeSearch == nullptr)
+            return false;
+        // Continue improving the plan of the given state.
+        const QuestPlanPtr plan = questManager->_anytimeSearch->improvePlan(
+                settings.searchLimit, PlanningDeadline(settings.timeLimitUs));
+        if(questManager->_anytimeSearch->isFinished())
+            questManager->_anytimeSearch.reset();
+        if(plan == nullptr)
+            return false;
+        return publishPlan(worldName, plan, questManager, messageProcessor);
+    }
+    // The plan of the previous substate is no longer improved.
+    questManager->_anytimeSearch.reset();
 
     // Perform planning.
     const QuestPtr quest = questManager->getQuest();
-    QuestPlanner planner(substateId, state, questManager);
-    QuestPlanPtr plan = planner.findQuestPlan(
-            worldName, messageProcessor, questManager->_settings);
-    
+    if(questManager->_settings.heuristic == QuestHeuristic::LANDMARKS
+            && questManager->_landmarks.empty()) {
+        // Generate the landmarks of all the goals.
+        const BitStatePtr initialState = quest->makeBitState(state);
+        for(SIZE_T i = 0; i < quest->getGoals().size(); ++i) {
+            questManager->_landmarks.push_back(makeShared<LandmarkGraph>(
+                    *quest, i, *initialState));
+            messageProcessor.onLandmarksFound(
+                    worldName, quest->getName(), int(i), 
+                    int(questManager->_landmarks.back()->size()));
+        }
+    }
+    // The time limit doesn't include the landmarks, built only once.
+    const PlanningDeadline deadline(settings.timeLimitUs);
+    const SIZE_T goalCount = quest->getGoals().size();
+    if(questManager->_settings.heuristic == QuestHeuristic::PDB
+            && questManager->_patternDatabases.size() < goalCount) {
+        // Build the pattern databases of all the goals. The memory limit 
+        // is shared by the goals. The build counts toward the time limit: 
+        // once it is reached, the build is continued by the next planning 
+        // call, and the quest isn't planned until all the databases are 
+        // complete.
+        const BitStatePtr initialState = quest->makeBitState(state);
+        const SIZE_T memoryLimit = 
+                SIZE_T(questManager->_settings.pdbMemoryLimit) * 1024;
+        while(questManager->_patternDatabases.size() < goalCount) {
+            const SIZE_T i = questManager->_patternDatabases.size();
+            UniquePtr<PatternDatabase>& build = 
+                    questManager->_patternDatabaseBuild;
+            if(build == nullptr) {
+                if(i > 0 && deadline.isReached(0))
+                    return false;
+                build = makeUnique<PatternDatabase>(
+                        *quest, i, *initialState, memoryLimit / goalCount);
+            }
+            if(build->build(*quest, deadline) == false)
+                return false;
+            const PatternDatabasePtr pdb(std::move(build));
+            questManager->_patternDatabases.push_back(pdb);
+            messageProcessor.onPatternDatabaseBuilt(
+                    worldName, quest->getName(), int(i), 
+                    int(pdb->getPatternCount()), int(pdb->getMemory()), 
+                    pdb->getBuildTime(), pdb->getLookupTime());
+        }
+    }
+    questManager->updateHeuristicCaches();
+    QuestPlanner planner(substateId, state, questManager, deadline);
+    QuestPlanPtr plan;
+    // The anytime search improves its own plans.
+    const bool isRepairUsed = questManager->_settings.repairLimit > 0
+            && questManager->_settings.strategy != QuestSearchStrategy::ANYTIME
+            && questManager->_lastPlan != nullptr
+            && questManager->_lastPlan->status == MOZOK_QUEST_STATUS_REACHABLE;
+    if(isRepairUsed) {
+        // Try to reuse or repair the last plan first.
+        bool isReused = false;
+        plan = planner.repairLastPlan(settings, isReused);
+        if(plan != nullptr && isReused)
+            ++questManager->_reusedPlans;
+        else if(plan != nullptr)
+            ++questManager->_repairedPlans;
+    }
+    if(plan == nullptr) {
+        plan = planner.findQuestPlan(
+                worldName, messageProcessor, settings);
+        if(isRepairUsed && plan->status != MOZOK_QUEST_STATUS_DONE)
+            ++questManager->_searchedPlans;
+    }
+    if(isRepairUsed)
+        messageProcessor.onPlanRepairStats(
+                worldName, quest->getName(), questManager->_reusedPlans, 
+                questManager->_repairedPlans, questManager->_searchedPlans);
+    if(questManager->_heuristicCaches.empty() == false) {
+        SIZE_T hits = 0;
+        SIZE_T misses = 0;
+        for(const HeuristicCachePtr& cache : questManager->_heuristicCaches) {
+            hits += cache->getHits();
+            misses += cache->getMisses();
+            cache->resetStats();
+        }
+        messageProcessor.onHeuristicCacheStats(
+                worldName, quest->getName(), int(hits), int(misses));
+    }
+    return publishPlan(worldName, plan, questManager, messageProcessor);
+}
+
+bool QuestManager::publishPlan(
+        const Str& worldName,
+        const QuestPlanPtr& plan,
+        QuestManagerPtr& questManager,
+        MessageProcessor& messageProcessor
+        ) noexcept {
+    const QuestPtr quest = questManager->getQuest();
     const QuestStatus oldStatus = questManager->getStatus();
     const int oldGoal = questManager->getLastActiveGoalIndx();
 
@@ -9,6 +9,10 @@
 
 #include <libmozok/quest.hpp>
 #include <libmozok/quest_plan.hpp>
+#include <libmozok/landmarks.hpp>
+#include <libmozok/pattern_database.hpp>
+#include <libmozok/heuristic_cache.hpp>
+#include <libmozok/search_graph.hpp>
 
 namespace mozok {
 
@@ -16,25 +20,66 @@ class QuestManager;
 using QuestManagerPtr = SharedPtr<QuestManager>;
 using QuestManagerVec = Vector<QuestManagerPtr>;
 
+class AnytimeSearch;
+using AnytimeSearchPtr = SharedPtr<AnytimeSearch>;
+
 
 enum QuestOption {
     QUEST_OPTION_SEARCH_LIMIT,
     QUEST_OPTION_SPACE_LIMIT,
     QUEST_OPTION_OMEGA,
     QUEST_OPTION_HEURISTIC,
-    QUEST_OPTION_STRATEGY
+    QUEST_OPTION_STRATEGY,
+    QUEST_OPTION_THREADS,
+    QUEST_OPTION_FINGERPRINT_ONLY,
+    QUEST_OPTION_PDB_MEMORY_LIMIT,
+    QUEST_OPTION_HEURISTIC_CACHE_SIZE,
+    QUEST_OPTION_REPAIR_LIMIT,
+    QUEST_OPTION_ANYTIME_WEIGHT,
+    QUEST_OPTION_TIME_LIMIT_US,
+    QUEST_OPTION_IDA_TABLE_SIZE,
+    QUEST_OPTION_BEAM_WIDTH,
+    QUEST_OPTION_CONCURRENT_GOALS,
+    QUEST_OPTION_SEARCH_GRAPH_SIZE
 };
 
 enum QuestHeuristic {
     SIMPLE,
-    HSP
+    HSP,
+    HADD,
+    HMAX,
+    FF,
+    LANDMARKS,
+    PDB
 };
 
 enum QuestSearchStrategy {
     ASTAR,
-    DFS
+    DFS,
+    HDASTAR,
+    PORTFOLIO,
+    INCREMENTAL,
+    BACKWARD,
+    BIDIRECTIONAL,
+    ANYTIME,
+    IDA,
+    GBFS,
+    EHC,
+    GRAPHPLAN,
+    SAT,
+    BEAM,
+    IW,
+    BFWS
 };
 
+/// @brief Converts a `QuestHeuristic` value into the corresponding .quest 
+///        keyword (e.g. `HSP`).
+Str questHeuristicToStr(const QuestHeuristic heuristic) noexcept;
+
+/// @brief Converts a `QuestSearchStrategy` value into the corresponding .quest 
+///        keyword (e.g. `ASTAR`).
+Str questSearchStrategyToStr(const QuestSearchStrategy strategy) noexcept;
+
 /// @brief Quest settings for planner.
 struct QuestSettings {
     /// @brief Maximum number of unique states to visit during search process.
@@ -52,6 +97,55 @@ struct QuestSettings {
 
     /// @brief Sets the search strategy.
     QuestSearchStrategy strategy;
+
+    /// @brief Number of threads used by the parallel search strategies 
+    ///        (`HDASTAR`, `PORTFOLIO`), and by the concurrent search of the 
+    ///        quest goals (see `concurrentGoals`).
+    int threads;
+
+    /// @brief If `true`, the closed lists compare states only by their 
+    ///        128-bit fingerprints.
+    bool fingerprintOnly;
+
+    /// @brief The maximum size of the pattern databases of all the quest 
+    ///        goals in kilobytes (`PDB` heuristic).
+    int pdbMemoryLimit;
+
+    /// @brief The maximum number of entries in the heuristic cache of every 
+    ///        quest goal (`0` disables the cache).
+    int heuristicCacheSize;
+
+    /// @brief Maximum number of states expanded by the local repair of the 
+    ///        last plan (`0` disables the plan repair).
+    int repairLimit;
+
+    /// @brief The initial weight of the heuristic used by the `ANYTIME` 
+    ///        strategy. The weight is lowered by `0.5` with every improved 
+    ///        plan, until it reaches `1`.
+    int anytimeWeight;
+
+    /// @brief Maximum wall-clock time of a search in microseconds (`0` means 
+    ///        no limit, or the limit of the server, see 
+    ///        `Server::setPlanningTimeLimit()`).
+    int timeLimitUs;
+
+    /// @brief Maximum number of states in the transposition table of the 
+    ///        `IDA` strategy (`0` disables the table).
+    int idaTableSize;
+
+    /// @brief Maximum number of states kept at every depth by the `BEAM` 
+    ///        strategy.
+    int beamWidth;
+
+    /// @brief If `true`, the remaining quest goals are searched concurrently 
+    ///        on at most `threads` threads. Not used with the strategies that 
+    ///        are already parallel (`HDASTAR`, `PORTFOLIO`) and with `ANYTIME`.
+    bool concurrentGoals;
+
+    /// @brief The maximum number of states in the search graph of every 
+    ///        quest goal, kept between the planning calls by the 
+    ///        `INCREMENTAL` strategy.
+    int searchGraphSize;
 };
 
 
@@ -91,6 +185,62 @@ class QuestManager {
     /// @brief Main quest goal index.
     int _parentQuestGoal;
 
+    /// @brief Landmark graphs of the quest goals. Built once, on the first 
+    ///        planning with the `LANDMARKS` heuristic.
+    Vector<LandmarkGraphPtr> _landmarks;
+
+    /// @brief Pattern databases of the quest goals. Built once, on the first 
+    ///        plannings with the `PDB` heuristic.
+    Vector<PatternDatabasePtr> _patternDatabases;
+
+    /// @brief The pattern database of the next goal, if its build didn't fit 
+    ///        into the time limit of the last planning call.
+    UniquePtr<PatternDatabase> _patternDatabaseBuild;
+
+    /// @brief Heuristic caches of the quest goals, shared by the planning 
+    ///        calls. Empty if the cache is not used by the current settings.
+    Vector<HeuristicCachePtr> _heuristicCaches;
+
+    /// @brief State graphs of the quest goals, kept between the planning 
+    ///        calls by the `INCREMENTAL` strategy. Empty for other 
+    ///        strategies.
+    Vector<SearchGraphPtr> _searchGraphs;
+
+    /// @brief The search that keeps improving the plan of the last substate 
+    ///        (`ANYTIME` strategy), or `nullptr`.
+    AnytimeSearchPtr _anytimeSearch;
+
+    /// @brief The number of the replannings resolved by reusing a suffix of 
+    ///        the last plan, by the local repair of the last plan, and by 
+    ///        the full search (see `QuestPlanner::repairLastPlan()`).
+    int _reusedPlans;
+    int _repairedPlans;
+    int _searchedPlans;
+
+    /// @brief The heuristic and the `omega` of the cached values.
+    QuestHeuristic _cachedHeuristic;
+    int _cachedOmega;
+
+    /// @brief Creates or drops the heuristic caches and the search graphs 
+    ///        according to the current settings. The cache is not used with 
+    ///        the path-dependent `LANDMARKS` heuristic, with the strategies 
+    ///        that search the same goal on several threads, and with the 
+    ///        `INCREMENTAL` and `ANYTIME` strategies (their graphs keep the 
+    ///        `h()` values). 
+    ///        A graph that has grown beyond `searchGraphSize` states is 
+    ///        dropped.
+    void updateHeuristicCaches() noexcept;
+
+    /// @brief Sets a new plan and sends the messages about the new status, 
+    ///        goal and plan of the quest (see `performPlanning()`).
+    /// @return Returns true if the plan was accepted.
+    static bool publishPlan(
+            const Str& worldName,
+            const QuestPlanPtr& plan,
+            QuestManagerPtr& questManager,
+            MessageProcessor& messageProcessor
+            ) noexcept;
+
 public:
     QuestManager(const QuestPtr& quest) noexcept;
     const QuestPtr& getQuest() const noexcept;
@@ -154,7 +304,34 @@ public:
     /// @return -1 for main quests, parent quest goal for activated subquests.
     int getParentQuestGoal() const noexcept;
 
-    /// @brief Performs planning for the quest.
+    /// @return Returns the landmark graph of the goal, or `nullptr` if the 
+    ///         landmarks were not generated.
+    LandmarkGraphPtr getLandmarks(const ID goalIndx) const noexcept;
+
+    /// @return Returns the pattern database of the goal, or `nullptr` if the 
+    ///         databases were not built.
+    PatternDatabasePtr getPatternDatabase(const ID goalIndx) const noexcept;
+
+    /// @return Returns the heuristic cache of the goal, or `nullptr` if the 
+    ///         cache is not used.
+    HeuristicCache* getHeuristicCache(const ID goalIndx) const noexcept;
+
+    /// @return Returns the search graph of the goal, or `nullptr` if the 
+    ///         `INCREMENTAL` strategy is not used.
+    SearchGraph* getSearchGraph(const ID goalIndx) const noexcept;
+
+    /// @brief Keeps the search that can improve the plan of the last 
+    ///        substate (`ANYTIME` strategy). The search is continued by the 
+    ///        next planning calls, until a new substate is planned.
+    void setAnytimeSearch(const AnytimeSearchPtr& search) noexcept;
+
+    /// @return Returns `true` if the plan of the last substate can still be 
+    ///         improved by the anytime search.
+    bool hasAnytimeSearch() const noexcept;
+
+    /// @brief Performs planning for the quest. If the status of the given 
+    ///        state is already known, continues the anytime search instead, 
+    ///        if any.
     /// @param worldName The name of the world where quest lives.
     /// @param substateId Current substate ID of this quest. This state ID must 
     ///         be consistent with the `state` value.
@@ -162,13 +339,16 @@ public:
     ///         with the `substateId` value.
     /// @param questManager The manager of the quest.
     /// @param messageProcessor A message processor for handling messages.
+    /// @param serverTimeLimitUs The time limit of the server, used if the 
+    ///        quest has no `timeLimitUs` option (`0` means no limit).
     /// @return Returns true if a new plan was found.
     static bool performPlanning(
             const Str& worldName,
             const ID substateId,
             const StatePtr& state,
             QuestManagerPtr& questManager,
-            MessageProcessor& messageProcessor
+            MessageProcessor& messageProcessor,
+            const int serverTimeLimitUs
             ) noexcept;
 
 };
@@ -10,14 +10,16 @@ QuestPlan::QuestPlan(
         const QuestPtr& _quest,
         const ID _goalIndx,
         const QuestStatus _status,
-        const ActionVec& _plan
+        const ActionVec& _plan,
+        const Vector<int>& _actionIndices
         ) noexcept :
     givenSubstateId(_givenSubstate),
     givenState(_givenState),
     quest(_quest),
     goalIndx(_goalIndx),
     status(_status),
-    plan(_plan)
+    plan(_plan),
+    actionIndices(_actionIndices)
 { /* empty */ }
 
 }
\ No newline at end of file
@@ -35,13 +35,18 @@ struct QuestPlan {
     // Plan actions doesn't contain action's pre, add and rem statements.
     const ActionVec plan;
 
+    /// @brief `actionIndices[i]` is the index of the i-th plan action in 
+    ///        `Quest::getPossibleActions()`. Used by the plan repair.
+    const Vector<int> actionIndices;
+
     QuestPlan(
         const ID _givenStateId, 
         const StatePtr& _givenSubstate,
         const QuestPtr& _quest,
         const ID _goalIndx,
         const QuestStatus _status,
-        const ActionVec& _plan 
+        const ActionVec& _plan,
+        const Vector<int>& _actionIndices = Vector<int>()
         ) noexcept;
 };
 
@@ -8,297 +8,50 @@
 #include <libmozok/state.hpp>
 #include <libmozok/statement.hpp>
 #include <libmozok/quest_planner.hpp>
+#include <libmozok/message_queue.hpp>
+#include <libmozok/search_node.hpp>
+#include <libmozok/heuristic_calculator.hpp>
+#include <libmozok/forward_search.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <utility>
 
 namespace mozok {
 
-namespace {
-
-struct StateNode;
-class StateNodeCmp;
-
-using StateNodePtr = SharedPtr<StateNode>;
-using StateNodeQueue = PriorityQueue<StateNodePtr, StateNodeCmp>;
-
-class QuestPlannerActionsIterator;
-class QuestHSPRelaxedActionsIterator;
-
-using ActionTable = Vector<int>;
-using DifficultyMap = 
-    HashMap<const StatementPtr, int, StatementHash, StatementEqual>;
-
-/// @brief A state node in the state graph.
-struct StateNode {
-    /// @brief Node state.
-    const StatePtr state;
-
-    /// @brief Preceding state on the cheapest path from the initial state 
-    ///     to this state.
-    const StateNodePtr preceding;
-
-    /// @brief Action that changes state from the preceding to current state.
-    const ActionPtr action;
-
-    /// @brief Action arguments.
-    ObjectVec arguments;
-
-    /// @brief Cheapest known length from the initial state.
-    int gScore;
-
-	/// @brief Best guess of shortest length from the initial state 
-    ///     (f(n) = g(n) + h(n)).
-	int fScore;
-
-    StateNode(
-            const StatePtr _state, 
-            const StateNodePtr _preceding,
-            const ActionPtr _action
-            ) noexcept :
-        state(_state),
-        preceding(_preceding),
-        action(_action),
-        gScore(0),
-        fScore(0)
-    { /* empty */ }
-};
-
-
-// State node comparison classes.
-
-struct StateNodeCmp_Base {
-    virtual bool operator() (
-        const StateNodePtr& a, const StateNodePtr& b) const noexcept = 0;
-};
-
-struct StateNodeCmp_AStar : public StateNodeCmp_Base {
-    virtual bool operator() (
-        const StateNodePtr& a, const StateNodePtr& b) const noexcept 
-    { return a->fScore > b->fScore; }
-} const stateNodeCmp_AStar;
-
-struct StateNodeCmp_DFS : public StateNodeCmp_Base {
-    virtual bool operator() (
-            const StateNodePtr& a, const StateNodePtr& b) const noexcept {
-        if(a->gScore != b->gScore)
-            return a->gScore < b->gScore;
-        return a->fScore > b->fScore;
-    }
-} const stateNodeCmp_DFS;
-
-class StateNodeCmp {
-    const StateNodeCmp_Base* const _cmpObj;
-public:
-    StateNodeCmp(const StateNodeCmp_Base* const cmpObj) noexcept
-    : _cmpObj(cmpObj) { /*empty*/ }
-    bool operator() (
-            const StateNodePtr& a, const StateNodePtr& b) noexcept {
-        return _cmpObj->operator()(a,b);
-    }
-};
-
-
-/// @brief A callback class for the `Quest::iterateOverApplicableActions(...)`.
-/// This one is the main iterator, used to find a plan for the initial
-/// planning problem.
-class QuestPlannerActionsIterator : 
-        public QuestApplicableActionsIterator {
-    const QuestPtr _quest;
-    Vector<StatementVec> &_actionPreBuffers;
-    /// @brief A node from which we iterate trough the possible substitutions.
-    const StateNodePtr _node;
-    StateSet& _knownStates;
-    const Goal& _goal;
-    StateNodeQueue& _openSet;
-    const QuestSettings& _settings;
-    ActionTable &_tab;
-    DifficultyMap &_difficulties;
-
-    const int INF = std::numeric_limits<int>::max();
-
-    /// @brief Calculates simple but surprisingly effective `h()` value.
-    inline int calcSimpleHeuristic(const StatePtr& state) const noexcept {
-        int h_simp = 0;
-        for(const StatementPtr& goalStatement : _goal)
-            if(state->hasSubstate({goalStatement}) == false)
-                h_simp += int(goalStatement->getArguments().size()) 
-                        + _settings.omega;
-        return h_simp;
-    }
-
-    inline int calcHSPHeuristic_Fast(
-            const StatePtr& state,
-            const Goal& goal
-            ) noexcept {
-        //if(state->hasSubstate(goal))
-        //    return 0;
-
-        const Quest::PossibleActionVec actions = _quest->getPossibleActions();
-        SIZE_T applied_from = _tab.size();
-
-        for(auto &it : _difficulties)
-            it.second = INF;
-        for(const auto& statement : state->getStatementSet())
-            _difficulties[statement] = 0;
-
-        StatePtr relaxedState = state->duplicate();
-        SIZE_T actionCount = _quest->getActions().size();
-
-        while(true) {
-            bool modified = false;
-
-            for(SIZE_T i=0; i<applied_from; ) {
-                const Quest::ActionWithArgs& aa = actions[_tab[i]];
-                // check action preconditions
-                StatementVec& stvec = _actionPreBuffers[aa.combinedIndx % actionCount];
-                if(aa.action->checkActionPreconditions(
-                        aa.arguments, relaxedState, stvec) == false) {
-                    ++i;
-                    continue;
-                }
-                // `stvec` now contains `preList`
-                const auto addList = aa.action->getAddList().substitute(aa.arguments);
-                // Apply only the 'add' part of the action.
-                relaxedState->addStatements(addList);
-                
-                // Calculate the action "difficulty".
-                int actionDifficulty = 1;
-                for(const auto& precondition : stvec)
-                    actionDifficulty += _difficulties[precondition];
-
-                // Mark this action as applied
-                std::swap(_tab[i], _tab[--applied_from]);
-
-                // Update the difficulties for the statements added by the action.
-                for(const auto& added: addList) {
-                    auto it = _difficulties.find(added);
-                    if(it == _difficulties.end()) {
-                        modified = true;
-                        _difficulties[added] = actionDifficulty;
-                    } else if(it->second > actionDifficulty) {
-                        modified = true;
-                        it->second = actionDifficulty;
-                    }
-                }
-            }
-
-            if(modified == false)
-                break;
-
-            if(relaxedState->hasSubstate(goal))
-               break;
-        }
-
-        // Get goal difficulty
-        int h = 0;
-        for(const auto& goalStatement : goal) {
-            const auto it = _difficulties.find(goalStatement);
-            if(it == _difficulties.cend())
-                return INF;
-            h += it->second;
-        }
-        return h;
-    }
-
-public:
-    QuestPlannerActionsIterator(
-            const QuestPtr& quest,
-            Vector<StatementVec> &actionPreBuffers,
-            const StateNodePtr& node,
-            StateSet& knownStates, 
-            const Goal& goal,
-            StateNodeQueue& openSet,
-            const QuestSettings& settings,
-            ActionTable &tab,
-            DifficultyMap &difficulties
-            ) noexcept :
-        _quest(quest),
-        _actionPreBuffers(actionPreBuffers),
-        _node(node),
-        _knownStates(knownStates),
-        _goal(goal),
-        _openSet(openSet),
-        _settings(settings),
-        _tab(tab),
-        _difficulties(difficulties)
-    { /* empty */ }
-
-    bool actionCallback(
-            const ActionPtr& action, 
-            const ObjectVec& arguments,
-            const SIZE_T /*combinedIndx*/
-            ) noexcept {
-        if(_openSet.size() > StateNodeQueue::size_type(_settings.spaceLimit))
-            return false;
-        
-        StatePtr newState = _node->state->duplicate();
-        
-        // We can apply the action unsafely because the arguments were selected
-        // in such a way that they are fully compatible with the action and with
-        // the state.
-        action->applyActionUnsafe(arguments, newState); 
-        
-        if(_knownStates.find(newState) != _knownStates.end())
-            // A StateNode with such a state already present in the tree.
-            return true;
-        
-        // Save the resulting state into a new node.
-        StatementVec emptySVec;
-        ActionPtr nodeAction = makeShared<Action>(
-                action->getName(), action->getId(), action->isNotApplicable(), 
-                arguments, emptySVec, emptySVec, emptySVec);
-        StateNodePtr newNode = makeShared<StateNode>(newState, _node, nodeAction);
+SearchCancelFlag::SearchCancelFlag(
+        const SearchCancelFlag* parent
+        ) noexcept :
+    _isCancelled(false),
+    _parent(parent)
+{ /* empty */ }
 
-        int h_value = 0;
-        switch(_settings.heuristic) {
-            case QuestHeuristic::SIMPLE:
-                h_value = calcSimpleHeuristic(newState);
-                break;
-            case QuestHeuristic::HSP:
-                h_value = calcHSPHeuristic_Fast(newState, _goal);
-                break;
-            default:
-                break;
-        }
+void SearchCancelFlag::cancel() noexcept {
+    _isCancelled.store(true);
+}
 
-        // Goal is unreachable from this state.
-        if(h_value == INF)
-            return true;
+bool SearchCancelFlag::isCancelled() const noexcept {
+    return _isCancelled.load() 
+            || (_parent != nullptr && _parent->isCancelled());
+}
 
-        newNode->gScore = _node->gScore + 1;
-        newNode->fScore = newNode->gScore + h_value; 
-        
-        // Insert the new node into the graph and into the open set.
-        _knownStates.insert(newState);
-        if(_openSet.size() <= StateNodeQueue::size_type(_settings.spaceLimit))
-            _openSet.push(newNode);
-        
-        return true;
-    }
-};
 
-} // namespace
+AnytimeSearch::~AnytimeSearch() noexcept 
+{ /* empty */ }
 
 
 QuestPlanner::QuestPlanner(
         const ID givenSubstateId, 
         const StatePtr& givenState,
-        const QuestManagerPtr& quest
+        const QuestManagerPtr& quest,
+        const PlanningDeadline& deadline
         ) noexcept :
     _givenSubstateId(givenSubstateId),
     _givenState(givenState->duplicate()),
-    _quest(quest) { 
-    createActionPreBuffers();
-}
-
-void QuestPlanner::createActionPreBuffers() noexcept {
-    _actionPreBuffers.reserve(_quest->getQuest()->getActions().size());
-    for(const ActionPtr& action : _quest->getQuest()->getActions()) {
-        const RelationList& pre = action->getPreconditions();
-        _actionPreBuffers.push_back(pre.substitute(pre.getArguments()));
-    }
-}
+    _quest(quest),
+    _givenBitState(quest->getQuest()->makeBitState(_givenState)),
+    _deadline(deadline)
+{ /* empty */ }
 
 ID QuestPlanner::getGivenSubstateId() const noexcept {
     return _givenSubstateId;
@@ -308,6 +61,104 @@ const QuestManagerPtr& QuestPlanner::getQuest() const noexcept {
     return _quest;
 }
 
+QuestPlanPtr QuestPlanner::repairLastPlan(
+        const QuestSettings& settings,
+        bool& isReused
+        ) const noexcept {
+    isReused = false;
+    const QuestPlanPtr& lastPlan = _quest->getLastPlan();
+    if(lastPlan == nullptr 
+            || lastPlan->status != MOZOK_QUEST_STATUS_REACHABLE
+            || lastPlan->goalIndx != _quest->getLastActiveGoalIndx()
+            || lastPlan->actionIndices.size() != lastPlan->plan.size())
+        return nullptr;
+
+    const Quest& quest = *_quest->getQuest();
+    const ID goalIndx = lastPlan->goalIndx;
+    const BitState& goalMask = quest.getGoalMask(SIZE_T(goalIndx));
+    if(_givenBitState->hasSubstate(goalMask))
+        // Quest is already done.
+        return nullptr;
+    const Vector<int>& oldPlan = lastPlan->actionIndices;
+
+    // Tier 1: the shortest suffix of the old plan that still reaches the 
+    // goal from the given state.
+    for(SIZE_T first = oldPlan.size(); first-- > 0; ) {
+        if(checkPlanSuffix(quest, *_givenBitState, oldPlan, first, goalMask)) {
+            isReused = true;
+            const Vector<int> actionIndices(
+                    oldPlan.begin() + first, oldPlan.end());
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_REACHABLE, 
+                    makePlanActions(quest, actionIndices), actionIndices);
+        }
+    }
+
+    // Tier 2: a short search from the given state to the goal, or to a 
+    // state of the old plan, where the rest of the old plan is spliced in.
+    BitStateMap<int> planStates(settings.fingerprintOnly);
+    BitStatePtr planState = quest.makeBitState(lastPlan->givenState);
+    for(SIZE_T i = 0; i < oldPlan.size(); ++i) {
+        if(planStates.find(*planState) == nullptr)
+            planStates.insert(planState, int(i));
+        const SIZE_T actionIndx = SIZE_T(oldPlan[i]);
+        BitStatePtr nextState = makeShared<BitState>(*planState);
+        nextState->apply(
+                quest.getActionRemMask(actionIndx), 
+                quest.getActionAddMask(actionIndx), 
+                quest.getStatementKeys());
+        planState = nextState;
+    }
+
+    SearchArena arena;
+    const SIZE_T initialNodeIndx = 
+            arena.add({_givenBitState, NO_NODE, -1, 0, 0, -1});
+    KnownStates knownStates(settings.fingerprintOnly);
+    knownStates.insert(_givenBitState, true);
+    OpenNodeCmp cmpObj(&openNodeCmp_AStar);
+    OpenNodeQueue openSet(cmpObj);
+    openSet.push({0, 0, initialNodeIndx});
+    HeuristicCalculator heuristic(
+            _quest->getQuest(), goalIndx, settings, 
+            _quest->getLandmarks(goalIndx), 
+            _quest->getPatternDatabase(goalIndx),
+            _quest->getHeuristicCache(goalIndx));
+    heuristic.calculate(
+            _givenBitState, -1, arena[initialNodeIndx].landmarks);
+
+    for(int searchStep = 0; 
+            searchStep < settings.repairLimit && openSet.size() > 0; 
+            ++searchStep) {
+        const SIZE_T nodeIndx = openSet.top().nodeIndx;
+        openSet.pop();
+        const BitStatePtr state = arena[nodeIndx].state;
+
+        SIZE_T suffix = oldPlan.size();
+        if(state->hasSubstate(goalMask) == false) {
+            const int* planStep = planStates.find(*state);
+            if(planStep == nullptr) {
+                QuestPlannerActionsIterator it(
+                        quest, arena, nodeIndx, knownStates, openSet, 
+                        settings, heuristic);
+                quest.iterateOverApplicableActions(*state, it);
+                continue;
+            }
+            suffix = SIZE_T(*planStep);
+        }
+
+        Vector<int> actionIndices = 
+                buildPlan({&arena}, makeNodeRef(0, nodeIndx));
+        actionIndices.insert(
+                actionIndices.end(), oldPlan.begin() + suffix, oldPlan.end());
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_REACHABLE, 
+                makePlanActions(quest, actionIndices), actionIndices);
+    }
+    return nullptr;
+}
+
 QuestPlanPtr QuestPlanner::findQuestPlan(
         const Str& worldName,
         MessageProcessor& messageProcessor,
@@ -315,127 +166,141 @@ QuestPlanPtr QuestPlanner::findQuestPlan(
         ) noexcept {
     const GoalVec& goals = _quest->getQuest()->getGoals();
     QuestPlanPtr lastPlan;
-    if(_quest->getLastActiveGoalIndx() >= 0)
-        for(GoalVec::size_type goalIndx = GoalVec::size_type(
-                    _quest->getLastActiveGoalIndx()); 
-                goalIndx < goals.size(); 
-                ++goalIndx) {
-            lastPlan = findGoalPlan(
-                    ID(goalIndx), worldName, messageProcessor, settings);
-            if(lastPlan->status != MOZOK_QUEST_STATUS_UNREACHABLE)
-                break;
-        }
+    if(_quest->getLastActiveGoalIndx() < 0)
+        return lastPlan;
+
+    const GoalVec::size_type firstGoalIndx = 
+            GoalVec::size_type(_quest->getLastActiveGoalIndx());
+    // The anytime search is kept only for the goal of the plan, so the goals 
+    // are searched one by one. HDA* and the portfolio already use all the 
+    // threads for one goal.
+    if(settings.concurrentGoals && settings.threads > 1 
+            && firstGoalIndx + 1 < goals.size()
+            && settings.strategy != QuestSearchStrategy::ANYTIME
+            && settings.strategy != QuestSearchStrategy::HDASTAR
+            && settings.strategy != QuestSearchStrategy::PORTFOLIO)
+        return findQuestPlan_Concurrent(worldName, messageProcessor, settings);
+
+    for(GoalVec::size_type goalIndx = firstGoalIndx; 
+            goalIndx < goals.size(); 
+            ++goalIndx) {
+        lastPlan = findGoalPlan(
+                ID(goalIndx), worldName, messageProcessor, settings, nullptr);
+        if(lastPlan->status != MOZOK_QUEST_STATUS_UNREACHABLE)
+            break;
+    }
     return lastPlan;
 }
 
+QuestPlanPtr QuestPlanner::findQuestPlan_Concurrent(
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings
+        ) const noexcept {
+    const GoalVec::size_type firstGoalIndx = 
+            GoalVec::size_type(_quest->getLastActiveGoalIndx());
+    const SIZE_T goalCount = 
+            SIZE_T(_quest->getQuest()->getGoals().size() - firstGoalIndx);
+
+    // Messages are delayed, so they can be processed in the goals order.
+    Vector<MessageQueue> messages(goalCount);
+    Vector<SearchCancelFlag> cancelFlags(goalCount);
+    Vector<QuestPlanPtr> plans(goalCount);
+
+    // The goals are taken in the quest order, so a goal is skipped only if 
+    // a goal with a smaller index has already won.
+    Atomic<SIZE_T> nextGoal(0);
+    auto searchFunc = [&]() noexcept {
+        for(SIZE_T indx = nextGoal++; indx < goalCount; indx = nextGoal++) {
+            if(cancelFlags[indx].isCancelled())
+                continue;
+            plans[indx] = findGoalPlan(
+                    ID(firstGoalIndx + indx), worldName, messages[indx], 
+                    settings, &cancelFlags[indx]);
+            if(plans[indx]->status == MOZOK_QUEST_STATUS_UNREACHABLE)
+                continue;
+            // Goals with greater indices can't win anymore.
+            for(SIZE_T i = indx + 1; i < goalCount; ++i)
+                cancelFlags[i].cancel();
+        }
+    };
+
+    const SIZE_T threadCount = std::min(SIZE_T(settings.threads), goalCount);
+    Vector<Thread> threads;
+    for(SIZE_T i = 1; i < threadCount; ++i)
+        threads.push_back(Thread(searchFunc));
+    searchFunc();
+    for(Thread& thread : threads)
+        thread.join();
+
+    // The same result as the sequential search would give.
+    for(SIZE_T i = 0; i < goalCount; ++i) {
+        messages[i].processAll(messageProcessor);
+        if(plans[i]->status != MOZOK_QUEST_STATUS_UNREACHABLE)
+            return plans[i];
+    }
+    return plans.back();
+}
+
 QuestPlanPtr QuestPlanner::findGoalPlan(
         const ID goalIndx,
         const Str& worldName,
         MessageProcessor& messageProcessor,
-        const QuestSettings& settings
-        ) noexcept {
-    const Goal& goal = _quest->getQuest()->getGoals().at(goalIndx);
-    if(_givenState->hasSubstate(goal))
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const BitState& goalMask = 
+            _quest->getQuest()->getGoalMask(SIZE_T(goalIndx));
+    if(_givenBitState->hasSubstate(goalMask))
         // Quest is already done.
         return makeShared<QuestPlan>(
                 _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
                 MOZOK_QUEST_STATUS_DONE, ActionVec());
-    
-    StateNodePtr initialStateNode = makeShared<StateNode>(
-            _givenState, StateNodePtr(nullptr), ActionPtr(nullptr));
-    
-    // All discovered states so far.
-    StateSet knownStates;
 
-    // States that must be investigated next.
-    // Nodes with lower f-score have higher priority.
-    const StateNodeCmp_Base* cmpFunc = nullptr;
-    switch(settings.strategy) {
-        case QuestSearchStrategy::ASTAR: 
-            cmpFunc = &stateNodeCmp_AStar;
-            break;
-        case QuestSearchStrategy::DFS: 
-            cmpFunc = &stateNodeCmp_DFS;
-            break;
-    }
-    StateNodeCmp cmpObj(cmpFunc);
-    StateNodeQueue openSet(cmpObj);
-    openSet.push(initialStateNode);
-
-    StateNodePtr finalNode(nullptr);
-    int searchStep = 0;
-
-    // Data tables for HSP heuristic.
-    ActionTable tab;
-    DifficultyMap difficulties;
-    if(settings.heuristic == QuestHeuristic::HSP) {
-        const Quest::PossibleActionVec actions = 
-                _quest->getQuest()->getPossibleActions();
-        tab.resize(actions.size());
-        for(SIZE_T i=0; i<actions.size(); ++i)
-            tab[i] = int(i);
-    }
-
-    while(openSet.size() > 0) {
-        ++searchStep;
-        const bool isSearchLimitReached = 
-                searchStep > settings.searchLimit;
-        const bool isSpaceLimitReached = 
-                int(openSet.size()) > settings.spaceLimit;
-        if(isSearchLimitReached || isSpaceLimitReached) {
-            if(isSearchLimitReached)
-                messageProcessor.onSearchLimitReached(
-                    worldName, _quest->getQuest()->getName(), 
-                    settings.searchLimit);
-            if(isSpaceLimitReached)
-                messageProcessor.onSpaceLimitReached(
-                    worldName, _quest->getQuest()->getName(), 
-                    settings.spaceLimit);
-            // We reach the search limit.
-            return makeShared<QuestPlan>(
-                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
-                    MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
-        }
-        
-        // Pop next open node with the smallest f-score.
-        StateNodePtr node = openSet.top();
-        openSet.pop();
-
-        // Check if node contains all the conditions from the goal.
-        if(node->state->hasSubstate(goal)) {
-            // We have found the optimal plan.
-            finalNode = node;
-            break;
-        }
-
-        // Get all neighboring states using an actions iterator.
-        QuestPlannerActionsIterator it(
-            _quest->getQuest(), _actionPreBuffers, node, knownStates, goal,
-            openSet, settings, tab, difficulties);
-        _quest->getQuest()->iterateOverApplicableActions(
-                node->state, it, _actionPreBuffers);
-    }
-
-    if(finalNode.get() == nullptr)
-        // Goal is unreachable.
-        return makeShared<QuestPlan>(
-                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
-                    MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+    if(settings.strategy == QuestSearchStrategy::HDASTAR 
+            && settings.threads > 1)
+        return findGoalPlan_HDAStar(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::PORTFOLIO)
+        return findGoalPlan_Portfolio(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::INCREMENTAL
+            && _quest->getSearchGraph(goalIndx) != nullptr)
+        return findGoalPlan_Incremental(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::BACKWARD)
+        return findGoalPlan_Backward(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::BIDIRECTIONAL)
+        return findGoalPlan_Bidirectional(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::ANYTIME)
+        return findGoalPlan_Anytime(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::IDA)
+        return findGoalPlan_IDA(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::EHC)
+        return findGoalPlan_EHC(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::GRAPHPLAN)
+        return findGoalPlan_GraphPlan(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::SAT)
+        return findGoalPlan_SAT(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::BEAM)
+        return findGoalPlan_Beam(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::IW)
+        return findGoalPlan_IW(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
+    if(settings.strategy == QuestSearchStrategy::BFWS)
+        return findGoalPlan_BFWS(
+                goalIndx, worldName, messageProcessor, settings, cancelFlag);
     
-    // At this point quest goal is reachable.
-
-    // Build quest plan.
-    ActionVec plan(finalNode->gScore, ActionPtr(nullptr));
-    while(finalNode.get() != nullptr) {
-        if(finalNode->action.get() != nullptr)
-            plan[finalNode->gScore - 1] = finalNode->action;
-        finalNode = finalNode->preceding;
-    }
-    return makeShared<QuestPlan>(
-            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
-            MOZOK_QUEST_STATUS_REACHABLE, plan);
+    return findGoalPlan_Search(
+            goalIndx, worldName, messageProcessor, settings, cancelFlag);
 }
 
-
-
 }
@@ -11,9 +11,46 @@
 
 #include <libmozok/quest_plan.hpp>
 #include <libmozok/quest_manager.hpp>
+#include <libmozok/planning_deadline.hpp>
 
 namespace mozok {
 
+/// @brief Cancellation flag of a search. A search is cancelled when its own 
+/// flag, or the flag of any of its parents, is set.
+class SearchCancelFlag {
+    Atomic<bool> _isCancelled;
+    const SearchCancelFlag* const _parent;
+public:
+    SearchCancelFlag(const SearchCancelFlag* parent = nullptr) noexcept;
+    
+    void cancel() noexcept;
+    bool isCancelled() const noexcept;
+};
+
+/// @brief An anytime search of a quest goal (`strategy ANYTIME`). The search 
+/// is kept by the quest manager between the planning calls, and every call 
+/// continues it for a bounded number of steps, so the plan of the given state 
+/// is improved in the background of the game.
+class AnytimeSearch {
+public:
+    virtual ~AnytimeSearch() noexcept;
+
+    /// @brief Continues the search until a plan better than the last one is 
+    ///        found, until `stepLimit` states are expanded, or until the 
+    ///        deadline.
+    /// @param stepLimit Maximum number of states to expand.
+    /// @param deadline The deadline of the planning call.
+    /// @return Returns the better plan, or `nullptr`.
+    virtual QuestPlanPtr improvePlan(
+            const int stepLimit, 
+            const PlanningDeadline& deadline
+            ) noexcept = 0;
+
+    /// @return Returns `true` if the plan can't be improved anymore: the last 
+    ///         plan is optimal, or the search has reached the space limit.
+    virtual bool isFinished() const noexcept = 0;
+};
+
 /// @brief Quest planner performs planning for a given quest.
 /// A plan is a list of proper actions that leads to the quest completion.
 class QuestPlanner {
@@ -26,41 +63,339 @@ class QuestPlanner {
     /// @brief Quest manager of the quest.
     const QuestManagerPtr _quest;
 
-    /// @brief This array is used for the optimization.
-    /// It contains `StatementVec`s that contain identical relations and 
-    /// constant arguments as those specified in the action's preconditions.
-    /// Given in the order from the quest definition.
-    Vector<StatementVec> _actionPreBuffers;
+    /// @brief The dense representation of the given state (see `BitState`).
+    /// Used as the initial state of all the searches.
+    const BitStatePtr _givenBitState;
 
-    /// @brief Creates `_actionPreBuffers` vector.
-    void createActionPreBuffers() noexcept;
+    /// @brief The deadline of all the searches of this planner.
+    const PlanningDeadline _deadline;
 
     /// @brief Finds a plan for a given goal.
     /// @param goalIndx Goal index.
     /// @param worldName Quest's world name.
     /// @param messageProcessor A message processor.
+    /// @param cancelFlag If not `nullptr`, the search stops and returns an 
+    ///        `UNKNOWN` plan as soon as the flag is set.
     /// @return Returns a plan for a given goal.
     QuestPlanPtr findGoalPlan(
         const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using a single-threaded best-first 
+    ///        search (`ASTAR`, `DFS` or `GBFS`).
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag If not `nullptr`, the search stops and returns an 
+    ///        `UNKNOWN` plan as soon as the flag is set.
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_Search(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the enforced hill-climbing 
+    ///        (`EHC`). Starting from the given state, a breadth-first search 
+    ///        looks for the closest state with a lower `h()`, and the search 
+    ///        continues from it, until the goal is reached. If a breadth-first
+    ///        search finds no better state, or the search or the space limit 
+    ///        is reached, the greedy best-first search (`GBFS`) starts over 
+    ///        from the given state.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_EHC(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the GraphPlan algorithm 
+    ///        (`GRAPHPLAN`). The planning graph is expanded until the goal 
+    ///        appears without mutexes, and then a plan is extracted backward 
+    ///        level by level. The failed goal sets are memoized as nogoods. 
+    ///        If the graph levels off without the goal, or a failed 
+    ///        extraction after the level-off adds no nogoods, the goal is 
+    ///        `UNREACHABLE`. The plan is the shortest in the number of the 
+    ///        levels, not of the actions.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_GraphPlan(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal by the SAT-based planning 
+    ///        (`SAT`). The planning bounded by the horizon is encoded into a 
+    ///        CNF formula and solved by the embedded CDCL solver. The first 
+    ///        horizon is the first level of the planning graph with the goal, 
+    ///        and the horizon grows until a plan is found. The solver keeps 
+    ///        the learned clauses between the horizons. The goal is 
+    ///        `UNREACHABLE` only if the planning graph levels off without it.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_SAT(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the beam search (`BEAM`). 
+    ///        Every depth keeps only the `settings.beamWidth` successors with 
+    ///        the lowest `h()`, so the memory grows with the depth of the plan 
+    ///        only. The duplicates are dropped within the depth and against the 
+    ///        kept states. The goal is `UNREACHABLE` only if no successor was 
+    ///        ever dropped by the width.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_Beam(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the iterated width search 
+    ///        (`IW`). IW(1) and then IW(2) are breadth-first searches that 
+    ///        prune the states with the novelty greater than the width (see 
+    ///        `NoveltyTable`). If both fail, the best-first width search 
+    ///        (`BFWS`) starts over from the given state, with the same limits.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_IW(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the best-first width search 
+    ///        (`BFWS`). The states are explored in the order of their novelty,
+    ///        and then of the number of the goal statements they miss. The 
+    ///        novelty is computed separately for every number of the missed 
+    ///        goal statements. No state is pruned, so the search is complete.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_BFWS(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal by racing several heuristic and 
+    ///        strategy configurations on `settings.threads` threads. The 
+    ///        configurations are ordered by priority, starting with the 
+    ///        quest's own heuristic. The winner is the first configuration, 
+    ///        in this order, that proves the goal reachable or unreachable; 
+    ///        the configurations after it are cancelled as soon as it 
+    ///        decides. So the result doesn't depend on the thread timing.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_Portfolio(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the incremental A* search 
+    ///        (`INCREMENTAL`). The search runs on the state graph of the goal,
+    ///        kept by the quest manager between the planning calls (see 
+    ///        `SearchGraph`). The successors and the `h()` values of the 
+    ///        known states are reused, and after a plan is found, the `h()` 
+    ///        values of the expanded states are raised to `g(goal) - g(s)` 
+    ///        (Adaptive A*), so a search from a later state of the plan 
+    ///        expands few states off the plan.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_Incremental(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the regression search 
+    ///        (`BACKWARD`): A* over the partial states, from the goal towards 
+    ///        the given state (see `RegressionExpander`). 
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_Backward(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the bidirectional search 
+    ///        (`BIDIRECTIONAL`). The forward A* and the regression search 
+    ///        are alternated, and the search ends when a forward state 
+    ///        contains a partial state of the backward search. The plan is 
+    ///        not guaranteed to be optimal.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_Bidirectional(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the anytime repairing A* 
+    ///        (ARA*, `ANYTIME`). The first plan is found by the weighted A* 
+    ///        with the weight `settings.anytimeWeight`. If the plan may be 
+    ///        suboptimal, the search is kept by the quest manager (see 
+    ///        `AnytimeSearch`), and the next planning calls lower the weight 
+    ///        and publish the improved plans, reusing the explored states.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_Anytime(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the iterative deepening A* 
+    ///        (`IDA`). Every iteration is a depth-first search bounded by 
+    ///        `f = g + h`, and only the current path and the successors of 
+    ///        its nodes are kept in memory. The states of the path are never 
+    ///        revisited, and the optional transposition table (up to 
+    ///        `settings.idaTableSize` states) skips the states already 
+    ///        reached by a path that isn't longer in the same iteration.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_IDA(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Finds a plan for a given goal using the hash-distributed A* 
+    ///        (HDA*) with `settings.threads` threads.
+    /// @param goalIndx Goal index.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param cancelFlag Optional cancellation flag (see `findGoalPlan`).
+    /// @return Returns a plan for a given goal.
+    QuestPlanPtr findGoalPlan_HDAStar(
+        const ID goalIndx, 
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept;
+
+    /// @brief Searches all the remaining goals concurrently, on at most 
+    ///        `settings.threads` threads (`settings.concurrentGoals`). The 
+    ///        result is the same as the one of the sequential search: the 
+    ///        first goal (in the quest order) that isn't `UNREACHABLE` wins. 
+    ///        Searches of the goals that can't win anymore are cancelled.
+    /// @param worldName Quest's world name.
+    /// @param messageProcessor A message processor.
+    /// @param settings Planner settings.
+    /// @return Returns a quest plan.
+    QuestPlanPtr findQuestPlan_Concurrent(
         const Str& worldName,
         MessageProcessor& messageProcessor,
         const QuestSettings& settings
-        ) noexcept;
+        ) const noexcept;
 
 public:
     /// @brief Creates a quest planner.
     /// @param givenSubstateId Quest's substate ID of a given state. 
     /// @param givenState The state from which the it will attempt to find a plan.
     /// @param quest Quest manager of the quest.
+    /// @param deadline The deadline of the searches. When it passes, the 
+    ///        search reports `onTimeLimitReached` and returns an `UNKNOWN` plan.
     QuestPlanner(
         const ID givenSubstateId, 
         const StatePtr& givenState, 
-        const QuestManagerPtr& quest
+        const QuestManagerPtr& quest,
+        const PlanningDeadline& deadline
         ) noexcept;
 
     ID getGivenSubstateId() const noexcept;
     const QuestManagerPtr& getQuest() const noexcept;
 
+    /// @brief Tries to reuse the last plan of the quest (see 
+    ///        `QuestManager::getLastPlan()`) for the given state.
+    ///        First, the suffixes of the old plan are simulated from the 
+    ///        given state, and the shortest suffix that still achieves the 
+    ///        goal is reused. Otherwise, a short A* search (limited by 
+    ///        `settings.repairLimit`) looks for a path from the given state 
+    ///        to the goal or to any state of the old plan, and the rest of 
+    ///        the old plan is spliced in after it.
+    /// @param settings Planner settings.
+    /// @param isReused Receives `true` if a suffix of the old plan was reused 
+    ///        without a search.
+    /// @return Returns the repaired plan, or `nullptr` if the last plan can't 
+    ///         be repaired, or if the quest is already done.
+    QuestPlanPtr repairLastPlan(
+        const QuestSettings& settings,
+        bool& isReused
+        ) const noexcept;
+
     /// @brief Performs planning.
     /// @param worldName Quest's world name.
     /// @param messageProcessor A message processor.
@@ -0,0 +1,526 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/regression_search.hpp>
+#include <libmozok/quest_planner.hpp>
+#include <libmozok/heuristic_calculator.hpp>
+#include <libmozok/forward_search.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+namespace mozok {
+
+namespace {
+
+/// @brief The maximum number of statements for which the static mutexes are 
+///        computed (see `MutexTable`). The table takes `n^2 / 8` bytes.
+const SIZE_T MUTEX_STATEMENT_LIMIT = 4096;
+
+/// @brief Builds the plan of the regression search. The nodes are followed 
+///        from the given node towards the goal, so the actions are already 
+///        in the execution order.
+/// @param arena The arena of the regression search.
+/// @param nodeIndx The node whose partial state holds in the initial state 
+///        of the plan.
+/// @return Returns the indices of the possible actions of the plan.
+Vector<int> buildRegressionPlan(
+        const SearchArena& arena,
+        const SIZE_T nodeIndx
+        ) noexcept {
+    Vector<int> plan;
+    for(NodeRef ref = makeNodeRef(0, nodeIndx); ref != NO_NODE; ) {
+        const SearchNode& node = arena[SIZE_T(std::uint32_t(ref))];
+        if(node.actionIndx >= 0)
+            plan.push_back(node.actionIndx);
+        ref = node.preceding;
+    }
+    return plan;
+}
+
+/// @brief Returns the lowest statement of the partial state that isn't 
+///        present in the given state, or `-1` if the partial state holds in 
+///        the given state.
+int findMissingStatement(
+        const BitState& partialState, 
+        const BitState& givenState
+        ) noexcept {
+    const BitState::Word* words = partialState.getWords();
+    const BitState::Word* given = givenState.getWords();
+    for(SIZE_T w = 0; w < partialState.getWordCount(); ++w) {
+        const BitState::Word missing = words[w] & ~given[w];
+        if(missing != 0)
+            return int(w * BitState::WORD_BITS) 
+                    + BitState::countTrailingZeros(missing);
+    }
+    return -1;
+}
+
+} // namespace
+
+RegressionHeuristic::RegressionHeuristic(
+        const Quest& quest,
+        const BitState& givenState,
+        const QuestSettings& settings
+        ) noexcept :
+    _costs(quest.getStatementCount(), int(HeuristicCalculator::INF)),
+    _isMax(settings.heuristic == QuestHeuristic::HMAX) {
+    const SIZE_T actionCount = quest.getPossibleActions().size();
+    Vector<ActionCounter> counters;
+    counters.reserve(actionCount);
+    for(SIZE_T i = 0; i < actionCount; ++i)
+        counters.push_back({0, int(quest.getActionPreList(i).size())});
+
+    // Min-heap of the reached statements, as `cost << 32 | indx`.
+    Vector<std::uint64_t> queue;
+    const auto reach = [&](const int indx, const int cost) {
+        if(_costs[indx] <= cost)
+            return;
+        _costs[indx] = cost;
+        queue.push_back((std::uint64_t(cost) << 32) | std::uint64_t(indx));
+        std::push_heap(queue.begin(), queue.end(),
+                std::greater<std::uint64_t>());
+    };
+    BitState::forEachBit(givenState.getWords(), givenState.getWordCount(),
+            [&](const SIZE_T indx) { reach(int(indx), 0); });
+    for(SIZE_T i = 0; i < actionCount; ++i)
+        if(counters[i].unsatisfied == 0)
+            for(const int indx : quest.getActionAddList(i))
+                reach(indx, 1);
+
+    while(queue.empty() == false) {
+        std::pop_heap(queue.begin(), queue.end(),
+                std::greater<std::uint64_t>());
+        const int cost = int(queue.back() >> 32);
+        const int indx = int(queue.back() & 0xffffffffu);
+        queue.pop_back();
+        if(cost > _costs[indx])
+            continue; // outdated entry
+        for(const int actionIndx : 
+                quest.getStatementPreActions(SIZE_T(indx))) {
+            ActionCounter& counter = counters[actionIndx];
+            counter.cost = _isMax ? std::max(counter.cost, cost)
+                    : counter.cost + cost;
+            if(--counter.unsatisfied == 0)
+                for(const int addIndx : 
+                        quest.getActionAddList(SIZE_T(actionIndx)))
+                    reach(addIndx, counter.cost + 1);
+        }
+    }
+}
+
+int RegressionHeuristic::calculate(
+        const BitState& partialState) const noexcept {
+    int h = 0;
+    BitState::forEachBit(
+            partialState.getWords(), partialState.getWordCount(),
+            [&](const SIZE_T indx) {
+        const int cost = _costs[indx];
+        if(h == HeuristicCalculator::INF || cost == HeuristicCalculator::INF)
+            h = HeuristicCalculator::INF;
+        else
+            h = _isMax ? std::max(h, cost) : h + cost;
+    });
+    return h;
+}
+
+MutexTable::MutexTable(
+        const Quest& quest, const BitState& givenState) noexcept :
+    _wordCount(givenState.getWordCount()) {
+    const SIZE_T statementCount = quest.getStatementCount();
+    if(statementCount > MUTEX_STATEMENT_LIMIT) {
+        _wordCount = 0;
+        return;
+    }
+    _pairs.assign(statementCount * _wordCount, 0);
+    const BitState::Word* given = givenState.getWords();
+    BitState::forEachBit(given, _wordCount, [&](const SIZE_T indx) {
+        for(SIZE_T w = 0; w < _wordCount; ++w)
+            row(indx)[w] = given[w];
+    });
+
+    // The mask of the reachable statements.
+    Vector<BitState::Word> reachable(given, given + _wordCount);
+    Vector<BitState::Word> candidates(_wordCount);
+    const SIZE_T actionCount = quest.getPossibleActions().size();
+    bool isChanged = true;
+    while(isChanged) {
+        isChanged = false;
+        for(SIZE_T actionIndx = 0; actionIndx < actionCount; ++actionIndx) {
+            const BitState::Word* preMask = 
+                    quest.getActionPreMask(actionIndx);
+            const BitState::Word* remMask = 
+                    quest.getActionRemMask(actionIndx);
+            const BitState::Word* addMask = 
+                    quest.getActionAddMask(actionIndx);
+            // The statements reachable together with all the 
+            // preconditions. The preconditions must be pairwise 
+            // reachable.
+            candidates = reachable;
+            for(const int preIndx : quest.getActionPreList(actionIndx)) {
+                const BitState::Word* preRow = row(SIZE_T(preIndx));
+                for(SIZE_T w = 0; w < _wordCount; ++w)
+                    candidates[w] &= preRow[w];
+            }
+            if(BitState::isSubset(
+                    preMask, candidates.data(), _wordCount) == false)
+                continue;
+            for(SIZE_T w = 0; w < _wordCount; ++w)
+                candidates[w] = (candidates[w] & ~remMask[w]) | addMask[w];
+            for(const int addIndx : quest.getActionAddList(actionIndx)) {
+                BitState::Word* addRow = row(SIZE_T(addIndx));
+                for(SIZE_T w = 0; w < _wordCount; ++w) {
+                    const BitState::Word added = candidates[w] & ~addRow[w];
+                    if(added == 0)
+                        continue;
+                    isChanged = true;
+                    addRow[w] |= added;
+                    // Keep the table symmetric.
+                    for(BitState::Word bits = added; bits != 0; 
+                            bits &= bits - 1)
+                        row(w * BitState::WORD_BITS 
+                                + SIZE_T(BitState::countTrailingZeros(
+                                    bits)))
+                            [SIZE_T(addIndx) / BitState::WORD_BITS] |= 
+                                BitState::Word(1) 
+                                << (SIZE_T(addIndx) % BitState::WORD_BITS);
+                }
+                reachable[SIZE_T(addIndx) / BitState::WORD_BITS] |= 
+                        BitState::Word(1) 
+                        << (SIZE_T(addIndx) % BitState::WORD_BITS);
+            }
+        }
+    }
+}
+
+bool MutexTable::hasMutex(const BitState& partialState) const noexcept {
+    if(_wordCount == 0)
+        return false;
+    const BitState::Word* words = partialState.getWords();
+    bool hasMutex = false;
+    BitState::forEachBit(words, _wordCount, [&](const SIZE_T indx) {
+        if(hasMutex == false)
+            hasMutex = BitState::isSubset(
+                    words, row(indx), _wordCount) == false;
+    });
+    return hasMutex;
+}
+
+RegressionExpander::RegressionExpander(
+        const Quest& quest,
+        const QuestSettings& settings,
+        const RegressionHeuristic& heuristic,
+        const MutexTable& mutexes
+        ) noexcept :
+    _quest(quest),
+    _settings(settings),
+    _heuristic(heuristic),
+    _mutexes(mutexes),
+    _actionMarks(quest.getPossibleActions().size(), 0),
+    _mark(0)
+{ /* empty */ }
+
+void RegressionExpander::expand(
+        SearchArena& arena,
+        const SIZE_T nodeIndx,
+        KnownStates& knownStates,
+        OpenNodeQueue& openSet,
+        Vector<SIZE_T>* newNodes
+        ) noexcept {
+    if(++_mark == 0) {
+        // Overflow, reset all the marks.
+        _actionMarks.assign(_actionMarks.size(), 0);
+        _mark = 1;
+    }
+    // Copied, because new nodes can grow the arena.
+    const BitStatePtr state = arena[nodeIndx].state;
+    const int gScore = arena[nodeIndx].gScore + 1;
+    const SIZE_T wordCount = state->getWordCount();
+    const BitState::Word* words = state->getWords();
+    BitState::forEachBit(words, wordCount, [&](const SIZE_T indx) {
+        for(const int actionIndx : _quest.getStatementAddActions(indx)) {
+            if(_actionMarks[actionIndx] == _mark)
+                continue;
+            _actionMarks[actionIndx] = _mark;
+            if(int(openSet.size()) > _settings.spaceLimit)
+                return;
+
+            const BitState::Word* preMask = 
+                    _quest.getActionPreMask(SIZE_T(actionIndx));
+            const BitState::Word* remMask = 
+                    _quest.getActionRemMask(SIZE_T(actionIndx));
+            const BitState::Word* addMask = 
+                    _quest.getActionAddMask(SIZE_T(actionIndx));
+            bool isConsistent = true;
+            for(SIZE_T w = 0; w < wordCount && isConsistent; ++w)
+                isConsistent = (words[w] & remMask[w] & ~addMask[w]) == 0;
+            if(isConsistent == false)
+                continue;
+
+            const Fingerprint fingerprint = state->getAppliedFingerprint(
+                    addMask, preMask, _quest.getStatementKeys());
+            if(knownStates.findApplied(
+                    *state, addMask, preMask, fingerprint) != nullptr)
+                continue;
+            BitStatePtr newState = makeShared<BitState>(*state);
+            newState->apply(addMask, preMask, _quest.getStatementKeys());
+            knownStates.insert(newState, true);
+            if(_mutexes.hasMutex(*newState))
+                continue;
+            const int h_value = _heuristic.calculate(*newState);
+            if(h_value == HeuristicCalculator::INF)
+                continue;
+            const SIZE_T newIndx = arena.add({
+                    newState, makeNodeRef(0, nodeIndx), actionIndx, 
+                    gScore, gScore + h_value, -1});
+            openSet.push({gScore + h_value, gScore, newIndx});
+            if(newNodes != nullptr)
+                newNodes->push_back(newIndx);
+        }
+    });
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_Backward(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const RegressionHeuristic heuristic(quest, *_givenBitState, settings);
+
+    // The search starts from the goal, as a partial state.
+    const BitStatePtr goalState = 
+            makeShared<BitState>(quest.getGoalMask(SIZE_T(goalIndx)));
+    const MutexTable mutexes(quest, *_givenBitState);
+    const int goalHScore = heuristic.calculate(*goalState);
+    if(goalHScore == HeuristicCalculator::INF || mutexes.hasMutex(*goalState))
+        // Some goal statements are unreachable, or can't be true together, 
+        // even in the relaxed problem.
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+
+    SearchArena arena;
+    const SIZE_T goalNodeIndx = 
+            arena.add({goalState, NO_NODE, -1, 0, goalHScore, -1});
+    KnownStates knownStates(settings.fingerprintOnly);
+    knownStates.insert(goalState, true);
+    OpenNodeCmp cmpObj(&openNodeCmp_AStar);
+    OpenNodeQueue openSet(cmpObj);
+    openSet.push({goalHScore, 0, goalNodeIndx});
+    RegressionExpander expander(quest, settings, heuristic, mutexes);
+    int searchStep = 0;
+
+    while(openSet.size() > 0) {
+        if(cancelFlag != nullptr && cancelFlag->isCancelled())
+            // The result of this search is no longer needed.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+
+        ++searchStep;
+        const bool isSearchLimitReached = 
+                searchStep > settings.searchLimit;
+        const bool isSpaceLimitReached = 
+                int(openSet.size()) > settings.spaceLimit;
+        const bool isTimeLimitReached = _deadline.isReached(searchStep);
+        if(isSearchLimitReached || isSpaceLimitReached 
+                || isTimeLimitReached) {
+            if(isSearchLimitReached)
+                messageProcessor.onSearchLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.searchLimit);
+            if(isSpaceLimitReached)
+                messageProcessor.onSpaceLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.spaceLimit);
+            if(isTimeLimitReached)
+                messageProcessor.onTimeLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.timeLimitUs);
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+        }
+
+        const SIZE_T nodeIndx = openSet.top().nodeIndx;
+        openSet.pop();
+        if(_givenBitState->hasSubstate(*arena[nodeIndx].state)) {
+            const Vector<int> actionIndices = 
+                    buildRegressionPlan(arena, nodeIndx);
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_REACHABLE, 
+                    makePlanActions(quest, actionIndices), actionIndices);
+        }
+        expander.expand(arena, nodeIndx, knownStates, openSet, nullptr);
+    }
+
+    // The regression is complete: no partial state from which the goal can 
+    // be achieved holds in the given state.
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_Bidirectional(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const RegressionHeuristic backwardHeuristic(
+            quest, *_givenBitState, settings);
+    const BitStatePtr goalState = 
+            makeShared<BitState>(quest.getGoalMask(SIZE_T(goalIndx)));
+    const MutexTable mutexes(quest, *_givenBitState);
+    const int goalHScore = backwardHeuristic.calculate(*goalState);
+    if(goalHScore == HeuristicCalculator::INF || mutexes.hasMutex(*goalState))
+        // Some goal statements are unreachable, or can't be true together, 
+        // even in the relaxed problem.
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+
+    // The forward search (from the given state).
+    SearchArena forwardArena;
+    const SIZE_T initialNodeIndx = 
+            forwardArena.add({_givenBitState, NO_NODE, -1, 0, 0, -1});
+    KnownStates forwardStates(settings.fingerprintOnly);
+    forwardStates.insert(_givenBitState, true);
+    OpenNodeCmp cmpObj(&openNodeCmp_AStar);
+    OpenNodeQueue forwardSet(cmpObj);
+    forwardSet.push({0, 0, initialNodeIndx});
+    HeuristicCalculator forwardHeuristic(
+            _quest->getQuest(), goalIndx, settings, 
+            _quest->getLandmarks(goalIndx), 
+            _quest->getPatternDatabase(goalIndx),
+            _quest->getHeuristicCache(goalIndx));
+    forwardHeuristic.calculate(
+            _givenBitState, -1, forwardArena[initialNodeIndx].landmarks);
+
+    // The backward search (from the goal).
+    SearchArena backwardArena;
+    const SIZE_T goalNodeIndx = 
+            backwardArena.add({goalState, NO_NODE, -1, 0, goalHScore, -1});
+    KnownStates backwardStates(settings.fingerprintOnly);
+    backwardStates.insert(goalState, true);
+    OpenNodeQueue backwardSet(cmpObj);
+    backwardSet.push({goalHScore, 0, goalNodeIndx});
+    RegressionExpander expander(quest, settings, backwardHeuristic, mutexes);
+
+    // The backward nodes, grouped by a statement of the partial state that 
+    // isn't present in the given state. A forward state can contain the 
+    // partial state only if it contains this statement, so only the groups 
+    // of the statements changed since the given state are checked.
+    Vector<Vector<SIZE_T>> meetingGroups(quest.getStatementCount());
+    meetingGroups[SIZE_T(findMissingStatement(*goalState, *_givenBitState))]
+            .push_back(goalNodeIndx);
+    Vector<SIZE_T> newNodes;
+
+    const auto makePlan = [&](
+            const Vector<int>& forwardPlan, const SIZE_T backwardNodeIndx) {
+        Vector<int> actionIndices = forwardPlan;
+        const Vector<int> backwardPlan = 
+                buildRegressionPlan(backwardArena, backwardNodeIndx);
+        actionIndices.insert(
+                actionIndices.end(), backwardPlan.begin(), backwardPlan.end());
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_REACHABLE, 
+                makePlanActions(quest, actionIndices), actionIndices);
+    };
+
+    int searchStep = 0;
+    // The search ends when any of the directions is exhausted, since each of 
+    // them is complete on its own.
+    while(forwardSet.size() > 0 && backwardSet.size() > 0) {
+        if(cancelFlag != nullptr && cancelFlag->isCancelled())
+            // The result of this search is no longer needed.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+
+        ++searchStep;
+        const bool isSearchLimitReached = 
+                searchStep > settings.searchLimit;
+        const bool isSpaceLimitReached = 
+                int(forwardSet.size() + backwardSet.size()) 
+                    > settings.spaceLimit;
+        const bool isTimeLimitReached = _deadline.isReached(searchStep);
+        if(isSearchLimitReached || isSpaceLimitReached 
+                || isTimeLimitReached) {
+            if(isSearchLimitReached)
+                messageProcessor.onSearchLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.searchLimit);
+            if(isSpaceLimitReached)
+                messageProcessor.onSpaceLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.spaceLimit);
+            if(isTimeLimitReached)
+                messageProcessor.onTimeLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.timeLimitUs);
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+        }
+
+        // The direction that generated fewer states is expanded, so both 
+        // directions get the same effort. The regression usually has a much 
+        // larger branching factor, so the cardinality of the open lists 
+        // would favour it too much.
+        if(forwardStates.size() <= backwardStates.size()) {
+            const SIZE_T nodeIndx = forwardSet.top().nodeIndx;
+            forwardSet.pop();
+            const BitStatePtr state = forwardArena[nodeIndx].state;
+            const BitState::Word* words = state->getWords();
+            const BitState::Word* given = _givenBitState->getWords();
+            const SIZE_T wordCount = state->getWordCount();
+            for(SIZE_T w = 0; w < wordCount; ++w) {
+                for(BitState::Word changed = words[w] & ~given[w]; 
+                        changed != 0; changed &= changed - 1) {
+                    const SIZE_T indx = w * BitState::WORD_BITS 
+                            + SIZE_T(BitState::countTrailingZeros(changed));
+                    for(const SIZE_T backwardIndx : meetingGroups[indx])
+                        if(state->hasSubstate(
+                                *backwardArena[backwardIndx].state))
+                            return makePlan(
+                                    buildPlan({&forwardArena}, 
+                                            makeNodeRef(0, nodeIndx)), 
+                                    backwardIndx);
+                }
+            }
+            QuestPlannerActionsIterator it(
+                    quest, forwardArena, nodeIndx, forwardStates, forwardSet, 
+                    settings, forwardHeuristic);
+            quest.iterateOverApplicableActions(*state, it);
+        } else {
+            const SIZE_T nodeIndx = backwardSet.top().nodeIndx;
+            backwardSet.pop();
+            newNodes.clear();
+            expander.expand(
+                    backwardArena, nodeIndx, backwardStates, backwardSet, 
+                    &newNodes);
+            for(const SIZE_T newIndx : newNodes) {
+                const int indx = findMissingStatement(
+                        *backwardArena[newIndx].state, *_givenBitState);
+                if(indx < 0)
+                    // The partial state holds in the given state.
+                    return makePlan(Vector<int>(), newIndx);
+                meetingGroups[SIZE_T(indx)].push_back(newIndx);
+            }
+        }
+    }
+
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+}
+
+}
@@ -0,0 +1,108 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+#include <libmozok/quest_manager.hpp>
+#include <libmozok/search_node.hpp>
+
+namespace mozok {
+
+/// @brief The heuristic of the regression search. The costs of all the 
+/// statements are computed once, by a relaxed reachability pass from the 
+/// given state (the same generalized Dijkstra as in `HeuristicCalculator`), 
+/// and the `h()` value of a partial state is the sum of the costs of its 
+/// statements (`HMAX`: the maximum), as in HSP-r.
+class RegressionHeuristic {
+    Vector<int> _costs;
+    const bool _isMax;
+
+public:
+    RegressionHeuristic(
+            const Quest& quest,
+            const BitState& givenState,
+            const QuestSettings& settings
+            ) noexcept;
+
+    /// @brief Calculates the `h()` value of a partial state.
+    /// @return Returns `INF` if some statement of the partial state can't be 
+    ///         reached from the given state, even in the relaxed problem.
+    int calculate(const BitState& partialState) const noexcept;
+};
+
+/// @brief The static mutexes of the statements: the pairs of statements that 
+/// can't be true at the same time in any state reachable from the given 
+/// state. The reachable pairs are computed by the h^2 fixpoint: a pair is 
+/// reachable if both statements are in the given state, or if an action with 
+/// pairwise reachable preconditions adds one of them and adds or doesn't 
+/// remove the other one, which is reachable together with the preconditions. 
+/// The regression search prunes the partial states that contain a mutex pair 
+/// (such states are spurious: they are never reached by the forward search).
+class MutexTable {
+    SIZE_T _wordCount;
+
+    /// @brief `_pairs[p * _wordCount ..]` is the mask of the statements that 
+    ///        are reachable together with the statement `p` (the bit `p` is 
+    ///        set if `p` itself is reachable).
+    Vector<BitState::Word> _pairs;
+
+    BitState::Word* row(const SIZE_T indx) noexcept {
+        return &_pairs[indx * _wordCount];
+    }
+
+    const BitState::Word* row(const SIZE_T indx) const noexcept {
+        return &_pairs[indx * _wordCount];
+    }
+
+public:
+    MutexTable(const Quest& quest, const BitState& givenState) noexcept;
+
+    /// @brief Checks if the partial state contains a mutex pair, or an 
+    ///        unreachable statement.
+    bool hasMutex(const BitState& partialState) const noexcept;
+};
+
+/// @brief Expands the nodes of the regression search. A node holds a partial 
+/// state: the statements that must be true. An action is relevant to a 
+/// partial state if it adds one of its statements, and consistent if it 
+/// doesn't remove any of its statements (without adding it back). The 
+/// regression of `G` through the action is `(G & ~add) | pre`, i.e. 
+/// `BitState::apply()` with the add mask as the remove mask and the 
+/// precondition mask as the add mask, so the known partial states are 
+/// detected by `KnownStates::findApplied()`, as in the forward search.
+class RegressionExpander {
+    const Quest& _quest;
+    const QuestSettings& _settings;
+    const RegressionHeuristic& _heuristic;
+    const MutexTable& _mutexes;
+
+    /// @brief Marks of the actions already tried for the expanded node.
+    Vector<unsigned> _actionMarks;
+    unsigned _mark;
+
+public:
+    RegressionExpander(
+            const Quest& quest,
+            const QuestSettings& settings,
+            const RegressionHeuristic& heuristic,
+            const MutexTable& mutexes
+            ) noexcept;
+
+    /// @brief Adds the regressions of the node into the arena and into the 
+    ///        open set.
+    /// @param newNodes If not `nullptr`, receives the indices of the new 
+    ///        nodes.
+    void expand(
+            SearchArena& arena,
+            const SIZE_T nodeIndx,
+            KnownStates& knownStates,
+            OpenNodeQueue& openSet,
+            Vector<SIZE_T>* newNodes
+            ) noexcept;
+};
+
+}
@@ -70,23 +70,41 @@ StatementVec RelationList::substitute(const ObjectVec& arguments) const noexcept
     return res;
 }
 
-void RelationList::substituteFast(
-        StatementVec& out, const ObjectVec& arguments) const noexcept {
-    for(StatementVec::size_type i=0; i<_statements.size(); ++i) {
-        if(_statements[i]->isConstant() == false) {
-            // Instead of calling the `Statement::substitute(...)` method:
-            //  out[i] = _statements[i]->substitute(arguments);
-            // we perform in-place substitution for optimization purposes.
-            const ObjectVec& stArgs = _statements[i]->getArguments();
-            ObjectVec& outArgs = out[i]->getArguments();
-            for(ObjectVec::size_type indx = 0; indx < stArgs.size(); ++indx) {
-                const ObjectPtr& arg = stArgs[indx];
-                if(arg->getId() < ID(0))
-                    outArgs[indx] = arguments[ID(-1) - arg->getId()];
-            }
-            out[i]->recalculateHash();
-        }
+void RelationList::substituteIds(
+        StatementTable& table,
+        const ObjectVec& arguments,
+        StatementIdVec& out
+        ) const noexcept {
+    for(const StatementPtr& statement : _statements)
+        out.push_back(table.intern(statement, arguments));
+}
+
+bool RelationList::isSubstateOf(
+        const State& state, const ObjectVec& arguments) const noexcept {
+    const StatementTable& table = *state.getTable();
+    for(const StatementPtr& statement : _statements) {
+        const StatementId id = table.find(statement, arguments);
+        if(id == INVALID_STATEMENT_ID || state.hasStatement(id) == false)
+            return false;
+    }
+    return true;
+}
+
+void RelationList::removeFrom(
+        State& state, const ObjectVec& arguments) const noexcept {
+    const StatementTable& table = *state.getTable();
+    for(const StatementPtr& statement : _statements) {
+        const StatementId id = table.find(statement, arguments);
+        if(id != INVALID_STATEMENT_ID)
+            state.removeStatement(id);
     }
 }
 
+void RelationList::addTo(
+        State& state, const ObjectVec& arguments) const noexcept {
+    StatementTable& table = *state.getTable();
+    for(const StatementPtr& statement : _statements)
+        state.addStatement(table.intern(statement, arguments));
+}
+
 }
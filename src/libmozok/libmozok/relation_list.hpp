@@ -8,6 +8,8 @@
 
 #include <libmozok/object.hpp>
 #include <libmozok/statement.hpp>
+#include <libmozok/statement_table.hpp>
+#include <libmozok/state.hpp>
 
 namespace mozok {
 
@@ -57,12 +59,36 @@ public:
     /// @return Returns a newly constructed array of relations.
     StatementVec substitute(const ObjectVec& arguments) const noexcept;
 
-    /// @brief A faster version of `substitute(...)` method.
-    /// @param out An array of statements that is fully compatible with the 
-    ///         `_statements` array. This implies that it contains the same 
-    ///         relations in the same order, with identical constant arguments.
+    /// @brief Appends the IDs of the substituted statements to `out`. 
+    ///        Statements are interned into the table if needed.
+    /// @param table A statement table.
     /// @param arguments Relation list arguments for the substitution.
-    void substituteFast(StatementVec& out, const ObjectVec& arguments) const noexcept;
+    /// @param out Output array of statement IDs.
+    void substituteIds(
+            StatementTable& table,
+            const ObjectVec& arguments,
+            StatementIdVec& out
+            ) const noexcept;
+
+    /// @brief Checks if the state contains all the substituted statements.
+    /// Statements are looked up in the state's table without constructing 
+    /// them, so this method doesn't allocate.
+    /// @param state A state.
+    /// @param arguments Relation list arguments for the substitution.
+    bool isSubstateOf(
+            const State& state, const ObjectVec& arguments) const noexcept;
+
+    /// @brief Removes the substituted statements from the state.
+    /// @param state A state that will be modified.
+    /// @param arguments Relation list arguments for the substitution.
+    void removeFrom(State& state, const ObjectVec& arguments) const noexcept;
+
+    /// @brief Adds the substituted statements to the state. Allocates only 
+    ///        when a statement is added to the state's table for the first 
+    ///        time.
+    /// @param state A state that will be modified.
+    /// @param arguments Relation list arguments for the substitution.
+    void addTo(State& state, const ObjectVec& arguments) const noexcept;
 
 };
 
@@ -0,0 +1,245 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/sat_search.hpp>
+#include <libmozok/search_node.hpp>
+
+namespace mozok {
+
+SatPlanMonitor::SatPlanMonitor(
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag,
+        const PlanningDeadline& deadline
+        ) noexcept :
+    _settings(settings),
+    _cancelFlag(cancelFlag),
+    _deadline(deadline),
+    searchStep(0),
+    isCancelled(false),
+    isSearchLimitReached(false),
+    isSpaceLimitReached(false),
+    isTimeLimitReached(false)
+{ /* empty */ }
+
+bool SatPlanMonitor::onConflict(const SIZE_T clauseCount) noexcept {
+    if(_cancelFlag != nullptr && _cancelFlag->isCancelled()) {
+        isCancelled = true;
+        return false;
+    }
+    ++searchStep;
+    isSearchLimitReached = searchStep > _settings.searchLimit;
+    isSpaceLimitReached = int(clauseCount) > _settings.spaceLimit;
+    isTimeLimitReached = _deadline.isReached(searchStep);
+    return !(isSearchLimitReached || isSpaceLimitReached 
+            || isTimeLimitReached);
+}
+
+void SatPlanEncoding::addClause(std::initializer_list<int> literals) noexcept {
+    _clause.assign(literals);
+    _solver.addClause(_clause);
+}
+
+SatPlanEncoding::SatPlanEncoding(
+        const Quest& quest,
+        const PlanningGraph& graph,
+        SatSolver& solver,
+        const BitState& initialState
+        ) noexcept :
+    _quest(quest),
+    _graph(graph),
+    _solver(solver),
+    _deleters(quest.getStatementCount()),
+    _stepAdders(quest.getStatementCount()),
+    _stepDeleters(quest.getStatementCount()),
+    _stepUsers(quest.getStatementCount()) {
+    for(SIZE_T a = 0; a < _quest.getPossibleActions().size(); ++a) {
+        const BitState::Word* addMask = _quest.getActionAddMask(a);
+        for(const int p : _quest.getActionRemList(a))
+            if(((addMask[SIZE_T(p) / BitState::WORD_BITS] 
+                    >> (SIZE_T(p) % BitState::WORD_BITS)) & 1) == 0)
+                _deleters[SIZE_T(p)].push_back(int(a));
+    }
+    _isStatic.resize(_quest.getStatementCount());
+    _statementVars.emplace_back();
+    for(SIZE_T p = 0; p < _quest.getStatementCount(); ++p) {
+        _isStatic[p] = _deleters[p].empty() 
+                && _quest.getStatementAddActions(p).size() == 0;
+        const int var = _solver.addVariable();
+        _statementVars.back().push_back(var);
+        addClause({lit(var, !initialState.hasBit(p))});
+    }
+}
+
+void SatPlanEncoding::addStep() noexcept {
+    const SIZE_T t = _actionVars.size();
+    const SIZE_T statementCount = _quest.getStatementCount();
+    const SIZE_T actionCount = _quest.getPossibleActions().size();
+    _statementVars.emplace_back();
+    const Vector<int>& before = _statementVars[t];
+    Vector<int>& after = _statementVars[t + 1];
+    for(SIZE_T p = 0; p < statementCount; ++p) {
+        if(_isStatic[p]) {
+            after.push_back(before[p]);
+            continue;
+        }
+        const int var = _solver.addVariable();
+        after.push_back(var);
+        const int level = _graph.getFactLevel(p);
+        if(level < 0 || SIZE_T(level) > t + 1)
+            addClause({lit(var, true)});
+    }
+    // The mutexes of the planning graph aren't needed for the 
+    // correctness, but they prune the search a lot.
+    for(SIZE_T p = 0; p < statementCount; ++p) {
+        const BitState::Word* mutexes = 
+                _graph.getStatementMutexes(t + 1, p);
+        if(mutexes == nullptr)
+            break;
+        BitState::forEachBit(
+                mutexes, BitState::getWordCount(statementCount), 
+                [&](const SIZE_T q) {
+            if(q > p)
+                addClause({lit(after[p], true), lit(after[q], true)});
+        });
+    }
+    _actionVars.emplace_back(actionCount, -1);
+    Vector<int>& actions = _actionVars.back();
+    for(SIZE_T p = 0; p < statementCount; ++p) {
+        _stepAdders[p].clear();
+        _stepDeleters[p].clear();
+        _stepUsers[p].clear();
+    }
+    for(SIZE_T a = 0; a < actionCount; ++a) {
+        const int level = _graph.getActionLevel(a);
+        if(level < 0 || SIZE_T(level) > t)
+            continue;
+        const int var = _solver.addVariable();
+        actions[a] = var;
+        for(const int p : _quest.getActionPreList(a)) {
+            addClause({lit(var, true), lit(before[SIZE_T(p)])});
+            _stepUsers[SIZE_T(p)].push_back(var);
+        }
+        for(const int p : _quest.getActionAddList(a)) {
+            addClause({lit(var, true), lit(after[SIZE_T(p)])});
+            _stepAdders[SIZE_T(p)].push_back(var);
+        }
+    }
+    for(SIZE_T p = 0; p < statementCount; ++p)
+        for(const int a : _deleters[p])
+            if(actions[SIZE_T(a)] >= 0)
+                _stepDeleters[p].push_back(actions[SIZE_T(a)]);
+    for(SIZE_T p = 0; p < statementCount; ++p) {
+        if(_isStatic[p])
+            continue;
+        // A statement changes only by an action of the step.
+        _clause.assign({lit(before[p]), lit(after[p], true)});
+        for(const int var : _stepAdders[p])
+            _clause.push_back(lit(var));
+        _solver.addClause(_clause);
+        _clause.assign({lit(before[p], true), lit(after[p])});
+        for(const int var : _stepDeleters[p])
+            _clause.push_back(lit(var));
+        _solver.addClause(_clause);
+
+        for(const int varA : _stepDeleters[p]) {
+            addClause({lit(varA, true), lit(after[p], true)});
+            // The actions of the step don't remove the preconditions 
+            // of each other.
+            for(const int varB : _stepUsers[p])
+                if(varB != varA)
+                    addClause({lit(varA, true), lit(varB, true)});
+        }
+    }
+}
+
+Vector<int> SatPlanEncoding::getGoalLiterals(
+        const BitState& goalMask) const noexcept {
+    Vector<int> literals;
+    BitState::forEachBit(
+            goalMask.getWords(), goalMask.getWordCount(), 
+            [&](const SIZE_T p) {
+        literals.push_back(lit(_statementVars.back()[p]));
+    });
+    return literals;
+}
+
+Vector<int> SatPlanEncoding::getPlan() const noexcept {
+    Vector<int> actionIndices;
+    for(const Vector<int>& actions : _actionVars)
+        for(SIZE_T a = 0; a < actions.size(); ++a)
+            if(actions[a] >= 0 && _solver.getModelValue(actions[a]))
+                actionIndices.push_back(int(a));
+    return actionIndices;
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_SAT(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const BitState& goalMask = quest.getGoalMask(SIZE_T(goalIndx));
+
+    // The planning graph gives the first horizon, and the statements and 
+    // the actions that can be true at every step.
+    PlanningGraph graph(quest, *_givenBitState);
+    while(graph.hasGoal(goalMask) == false) {
+        if(graph.isLeveledOff())
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+        graph.expand();
+    }
+    SatSolver solver;
+    SatPlanEncoding encoding(quest, graph, solver, *_givenBitState);
+    SatPlanMonitor monitor(settings, cancelFlag, _deadline);
+    while(true) {
+        while(encoding.getHorizon() + 1 < graph.getLevelCount())
+            encoding.addStep();
+        if(int(solver.getClauseCount()) > settings.spaceLimit) {
+            messageProcessor.onSpaceLimitReached(
+                worldName, _quest->getQuest()->getName(), 
+                settings.spaceLimit);
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+        }
+        const SatSolver::Status status = 
+                solver.solve(encoding.getGoalLiterals(goalMask), monitor);
+        if(status == SatSolver::SAT_SATISFIABLE)
+            break;
+        if(status == SatSolver::SAT_STOPPED) {
+            if(monitor.isSearchLimitReached)
+                messageProcessor.onSearchLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.searchLimit);
+            if(monitor.isSpaceLimitReached)
+                messageProcessor.onSpaceLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.spaceLimit);
+            if(monitor.isTimeLimitReached)
+                messageProcessor.onTimeLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.timeLimitUs);
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+        }
+        // No plan within the horizon, try a longer one.
+        if(cancelFlag != nullptr && cancelFlag->isCancelled())
+            // The result of this search is no longer needed.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+        graph.expand();
+    }
+
+    const Vector<int> actionIndices = encoding.getPlan();
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_REACHABLE, 
+            makePlanActions(quest, actionIndices), actionIndices);
+}
+
+}
@@ -0,0 +1,108 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+#include <libmozok/quest_manager.hpp>
+#include <libmozok/quest_planner.hpp>
+#include <libmozok/planning_graph.hpp>
+#include <libmozok/sat_solver.hpp>
+
+#include <initializer_list>
+
+namespace mozok {
+
+/// @brief Checks the limits of the `SAT` strategy. Every conflict of the 
+/// solver is a search step, and the clauses are the stored states.
+class SatPlanMonitor : public SatSolverMonitor {
+    const QuestSettings& _settings;
+    const SearchCancelFlag* const _cancelFlag;
+    const PlanningDeadline& _deadline;
+
+public:
+    int searchStep;
+    bool isCancelled;
+    bool isSearchLimitReached;
+    bool isSpaceLimitReached;
+    bool isTimeLimitReached;
+
+    SatPlanMonitor(
+            const QuestSettings& settings,
+            const SearchCancelFlag* cancelFlag,
+            const PlanningDeadline& deadline
+            ) noexcept;
+
+    bool onConflict(const SIZE_T clauseCount) noexcept override;
+};
+
+/// @brief The CNF encoding of the quest planning bounded by the horizon 
+/// (`SAT` strategy). Every statement has a variable at every time point 
+/// `0..horizon`, and every possible action has a variable at every step 
+/// `0..horizon-1` from its first level in the planning graph. The actions 
+/// of the same step can't remove a precondition of each other, so they can 
+/// be applied in any order. The statements that are not in the planning 
+/// graph yet are false. The clauses of a step never change, so the solver 
+/// keeps the learned clauses when the horizon grows.
+class SatPlanEncoding {
+    const Quest& _quest;
+    const PlanningGraph& _graph;
+    SatSolver& _solver;
+
+    /// @brief The possible actions that remove and don't add the statement.
+    Vector<Vector<int>> _deleters;
+
+    /// @brief The statements that no action adds or removes. They keep the
+    ///        variable of the time `0`.
+    Vector<char> _isStatic;
+
+    /// @brief `_statementVars[t][p]` is the variable of the statement `p` 
+    ///        at the time `t`.
+    Vector<Vector<int>> _statementVars;
+
+    /// @brief `_actionVars[t][a]` is the variable of the possible action 
+    ///        `a` at the step `t`, or `-1`.
+    Vector<Vector<int>> _actionVars;
+
+    /// @brief The variables of the actions of the current step that add, 
+    ///        remove (see `_deleters`) and require every statement.
+    Vector<Vector<int>> _stepAdders;
+    Vector<Vector<int>> _stepDeleters;
+    Vector<Vector<int>> _stepUsers;
+
+    Vector<int> _clause;
+
+    int lit(const int var, const bool isNegative = false) const noexcept {
+        return SatSolver::makeLiteral(var, isNegative);
+    }
+
+    void addClause(std::initializer_list<int> literals) noexcept;
+
+public:
+    SatPlanEncoding(
+            const Quest& quest,
+            const PlanningGraph& graph,
+            SatSolver& solver,
+            const BitState& initialState
+            ) noexcept;
+
+    /// @brief Returns the number of the encoded steps.
+    SIZE_T getHorizon() const noexcept {
+        return _actionVars.size();
+    }
+
+    /// @brief Encodes the next step.
+    void addStep() noexcept;
+
+    /// @brief Returns the literals of the goal statements at the horizon.
+    Vector<int> getGoalLiterals(const BitState& goalMask) const noexcept;
+
+    /// @brief Returns the actions of the satisfying assignment, step by 
+    ///        step.
+    Vector<int> getPlan() const noexcept;
+};
+
+}
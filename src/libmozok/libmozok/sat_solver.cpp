@@ -0,0 +1,443 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/sat_solver.hpp>
+
+#include <algorithm>
+
+namespace mozok {
+
+namespace {
+
+const int VALUE_UNDEF = -1;
+const int VALUE_FALSE = 0;
+const int VALUE_TRUE = 1;
+
+/// @brief The activities of the variables are multiplied by this value
+///        after every conflict (VSIDS).
+const double ACTIVITY_DECAY = 0.95;
+
+/// @brief The activities are rescaled when one of them exceeds this value.
+const double ACTIVITY_LIMIT = 1e100;
+
+/// @brief The number of the conflicts before the first restart. The next
+///        restarts follow the Luby sequence.
+const int RESTART_BASE = 100;
+
+int getVar(const int literal) noexcept {
+    return literal >> 1;
+}
+
+bool isNegative(const int literal) noexcept {
+    return (literal & 1) != 0;
+}
+
+/// @brief Returns the `i`-th element (from `0`) of the Luby sequence
+///        `1, 1, 2, 1, 1, 2, 4, ...`.
+int luby(int i) noexcept {
+    int size = 1;
+    int seq = 0;
+    while(size < i + 1) {
+        ++seq;
+        size = 2 * size + 1;
+    }
+    while(size - 1 != i) {
+        size = (size - 1) >> 1;
+        --seq;
+        i = i % size;
+    }
+    return 1 << seq;
+}
+
+}
+
+SatSolverMonitor::~SatSolverMonitor() noexcept
+{ /* empty */ }
+
+SatSolver::SatSolver() noexcept :
+    _learnedCount(0),
+    _propagated(0),
+    _activityInc(1.0),
+    _isUnsat(false),
+    _conflictCount(0)
+{ /* empty */ }
+
+int SatSolver::addVariable() noexcept {
+    const int var = int(_values.size());
+    _watches.emplace_back();
+    _watches.emplace_back();
+    _values.push_back(VALUE_UNDEF);
+    _levels.push_back(0);
+    _reasons.push_back(-1);
+    _phases.push_back(VALUE_FALSE);
+    _activity.push_back(0.0);
+    _heapIndices.push_back(-1);
+    _seen.push_back(0);
+    heapInsert(var);
+    return var;
+}
+
+int SatSolver::getValue(const int literal) const noexcept {
+    const int value = _values[SIZE_T(getVar(literal))];
+    if(value == VALUE_UNDEF)
+        return VALUE_UNDEF;
+    return value ^ (isNegative(literal) ? 1 : 0);
+}
+
+int SatSolver::getDecisionLevel() const noexcept {
+    return int(_trailLimits.size());
+}
+
+void SatSolver::assign(const int literal, const int reason) noexcept {
+    const SIZE_T var = SIZE_T(getVar(literal));
+    _values[var] = static_cast<signed char>(
+            isNegative(literal) ? VALUE_FALSE : VALUE_TRUE);
+    _levels[var] = getDecisionLevel();
+    _reasons[var] = reason;
+    _trail.push_back(literal);
+}
+
+void SatSolver::cancelUntil(const int level) noexcept {
+    if(getDecisionLevel() <= level)
+        return;
+    const SIZE_T limit = _trailLimits[SIZE_T(level)];
+    for(SIZE_T i = _trail.size(); i > limit; --i) {
+        const int var = getVar(_trail[i - 1]);
+        _phases[SIZE_T(var)] = _values[SIZE_T(var)];
+        _values[SIZE_T(var)] = VALUE_UNDEF;
+        _reasons[SIZE_T(var)] = -1;
+        heapInsert(var);
+    }
+    _trail.resize(limit);
+    _trailLimits.resize(SIZE_T(level));
+    _propagated = limit;
+}
+
+void SatSolver::watchClause(const int clauseIndx) noexcept {
+    const Clause& clause = _clauses[SIZE_T(clauseIndx)];
+    const int* literals = _clauseLiterals.data() + clause.first;
+    _watches[SIZE_T(literals[0])].push_back({clauseIndx, literals[1]});
+    _watches[SIZE_T(literals[1])].push_back({clauseIndx, literals[0]});
+}
+
+void SatSolver::addClause(const Vector<int>& literals) noexcept {
+    if(_isUnsat)
+        return;
+    Vector<int>& clause = _addedClause;
+    clause.assign(literals.begin(), literals.end());
+    std::sort(clause.begin(), clause.end());
+    clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+    SIZE_T size = 0;
+    for(SIZE_T i = 0; i < clause.size(); ++i) {
+        const int literal = clause[i];
+        if(i + 1 < clause.size() && clause[i + 1] == negate(literal))
+            // A tautology.
+            return;
+        const int value = getValue(literal);
+        if(value == VALUE_TRUE)
+            return;
+        if(value == VALUE_UNDEF)
+            clause[size++] = literal;
+    }
+    clause.resize(size);
+
+    if(clause.empty()) {
+        _isUnsat = true;
+        return;
+    }
+    if(clause.size() == 1) {
+        assign(clause[0], -1);
+        if(propagate() >= 0)
+            _isUnsat = true;
+        return;
+    }
+    _clauses.push_back({_clauseLiterals.size(), int(clause.size())});
+    _clauseLiterals.insert(_clauseLiterals.end(), clause.begin(), clause.end());
+    watchClause(int(_clauses.size() - 1));
+}
+
+int SatSolver::propagate() noexcept {
+    while(_propagated < _trail.size()) {
+        const int falseLiteral = negate(_trail[_propagated++]);
+        Vector<Watch>& watches = _watches[SIZE_T(falseLiteral)];
+        SIZE_T kept = 0;
+        SIZE_T i = 0;
+        int conflict = -1;
+        while(i < watches.size()) {
+            const Watch watch = watches[i++];
+            if(getValue(watch.blocker) == VALUE_TRUE) {
+                watches[kept++] = watch;
+                continue;
+            }
+            const Clause& clause = _clauses[SIZE_T(watch.clauseIndx)];
+            int* literals = _clauseLiterals.data() + clause.first;
+            if(literals[0] == falseLiteral)
+                std::swap(literals[0], literals[1]);
+            const Watch newWatch = {watch.clauseIndx, literals[0]};
+            if(literals[0] != watch.blocker
+                    && getValue(literals[0]) == VALUE_TRUE) {
+                watches[kept++] = newWatch;
+                continue;
+            }
+
+            // Look for a new literal to watch.
+            bool isMoved = false;
+            for(int k = 2; k < clause.size; ++k)
+                if(getValue(literals[k]) != VALUE_FALSE) {
+                    std::swap(literals[1], literals[k]);
+                    _watches[SIZE_T(literals[1])].push_back(newWatch);
+                    isMoved = true;
+                    break;
+                }
+            if(isMoved)
+                continue;
+
+            // The clause is unit or conflicting.
+            watches[kept++] = newWatch;
+            if(getValue(literals[0]) == VALUE_FALSE) {
+                conflict = watch.clauseIndx;
+                while(i < watches.size())
+                    watches[kept++] = watches[i++];
+                break;
+            }
+            assign(literals[0], watch.clauseIndx);
+        }
+        watches.resize(kept);
+        if(conflict >= 0)
+            return conflict;
+    }
+    return -1;
+}
+
+int SatSolver::analyze(const int conflict, Vector<int>& learned) noexcept {
+    learned.clear();
+    learned.push_back(-1); // the asserting literal
+    int pathCount = 0;
+    int literal = -1;
+    int clauseIndx = conflict;
+    SIZE_T trailIndx = _trail.size();
+    do {
+        const Clause& clause = _clauses[SIZE_T(clauseIndx)];
+        const int* literals = _clauseLiterals.data() + clause.first;
+        for(int j = literal < 0 ? 0 : 1; j < clause.size; ++j) {
+            const int q = literals[j];
+            const SIZE_T var = SIZE_T(getVar(q));
+            if(_seen[var] || _levels[var] == 0)
+                continue;
+            bumpActivity(int(var));
+            _seen[var] = 1;
+            if(_levels[var] >= getDecisionLevel())
+                ++pathCount;
+            else
+                learned.push_back(q);
+        }
+        // The next literal of the current level on the trail.
+        do {
+            --trailIndx;
+        } while(!_seen[SIZE_T(getVar(_trail[trailIndx]))]);
+        literal = _trail[trailIndx];
+        clauseIndx = _reasons[SIZE_T(getVar(literal))];
+        _seen[SIZE_T(getVar(literal))] = 0;
+        --pathCount;
+    } while(pathCount > 0);
+    learned[0] = negate(literal);
+
+    // Remove the literals that are implied by the other literals of the
+    // learned clause.
+    _analyzed.assign(learned.begin() + 1, learned.end());
+    SIZE_T size = 1;
+    for(SIZE_T i = 1; i < learned.size(); ++i) {
+        const int reason = _reasons[SIZE_T(getVar(learned[i]))];
+        bool isRedundant = reason >= 0;
+        if(isRedundant) {
+            const Clause& clause = _clauses[SIZE_T(reason)];
+            const int* literals = _clauseLiterals.data() + clause.first;
+            for(int j = 1; j < clause.size; ++j) {
+                const SIZE_T var = SIZE_T(getVar(literals[j]));
+                if(!_seen[var] && _levels[var] > 0) {
+                    isRedundant = false;
+                    break;
+                }
+            }
+        }
+        if(!isRedundant)
+            learned[size++] = learned[i];
+    }
+    learned.resize(size);
+    for(const int q : _analyzed)
+        _seen[SIZE_T(getVar(q))] = 0;
+
+    // The literal of the highest level after the asserting one is watched.
+    int backjumpLevel = 0;
+    for(SIZE_T i = 1; i < learned.size(); ++i) {
+        const int level = _levels[SIZE_T(getVar(learned[i]))];
+        if(level > backjumpLevel) {
+            backjumpLevel = level;
+            std::swap(learned[1], learned[i]);
+        }
+    }
+    return backjumpLevel;
+}
+
+void SatSolver::bumpActivity(const int var) noexcept {
+    double& activity = _activity[SIZE_T(var)];
+    activity += _activityInc;
+    if(activity > ACTIVITY_LIMIT) {
+        for(double& a : _activity)
+            a *= 1.0 / ACTIVITY_LIMIT;
+        _activityInc *= 1.0 / ACTIVITY_LIMIT;
+    }
+    if(_heapIndices[SIZE_T(var)] >= 0)
+        heapUp(SIZE_T(_heapIndices[SIZE_T(var)]));
+}
+
+void SatSolver::heapUp(SIZE_T indx) noexcept {
+    const int var = _heap[indx];
+    while(indx > 0) {
+        const SIZE_T parent = (indx - 1) / 2;
+        if(_activity[SIZE_T(_heap[parent])] >= _activity[SIZE_T(var)])
+            break;
+        _heap[indx] = _heap[parent];
+        _heapIndices[SIZE_T(_heap[indx])] = int(indx);
+        indx = parent;
+    }
+    _heap[indx] = var;
+    _heapIndices[SIZE_T(var)] = int(indx);
+}
+
+void SatSolver::heapDown(SIZE_T indx) noexcept {
+    const int var = _heap[indx];
+    while(2 * indx + 1 < _heap.size()) {
+        SIZE_T child = 2 * indx + 1;
+        if(child + 1 < _heap.size()
+                && _activity[SIZE_T(_heap[child + 1])]
+                    > _activity[SIZE_T(_heap[child])])
+            ++child;
+        if(_activity[SIZE_T(_heap[child])] <= _activity[SIZE_T(var)])
+            break;
+        _heap[indx] = _heap[child];
+        _heapIndices[SIZE_T(_heap[indx])] = int(indx);
+        indx = child;
+    }
+    _heap[indx] = var;
+    _heapIndices[SIZE_T(var)] = int(indx);
+}
+
+void SatSolver::heapInsert(const int var) noexcept {
+    if(_heapIndices[SIZE_T(var)] >= 0)
+        return;
+    _heap.push_back(var);
+    heapUp(_heap.size() - 1);
+}
+
+int SatSolver::heapPop() noexcept {
+    const int var = _heap.front();
+    _heapIndices[SIZE_T(var)] = -1;
+    const int last = _heap.back();
+    _heap.pop_back();
+    if(_heap.empty() == false) {
+        _heap[0] = last;
+        heapDown(0);
+    }
+    return var;
+}
+
+SatSolver::Status SatSolver::solve(
+        const Vector<int>& assumptions,
+        SatSolverMonitor& monitor
+        ) noexcept {
+    if(_isUnsat)
+        return SAT_UNSATISFIABLE;
+
+    Vector<int> learned;
+    int restartCount = 0;
+    int restartConflicts = RESTART_BASE * luby(restartCount);
+    while(true) {
+        const int conflict = propagate();
+        if(conflict >= 0) {
+            ++_conflictCount;
+            if(getDecisionLevel() == 0) {
+                _isUnsat = true;
+                return SAT_UNSATISFIABLE;
+            }
+            if(!monitor.onConflict(getClauseCount())) {
+                cancelUntil(0);
+                return SAT_STOPPED;
+            }
+            const int backjumpLevel = analyze(conflict, learned);
+            cancelUntil(backjumpLevel);
+            if(learned.size() == 1)
+                assign(learned[0], -1);
+            else {
+                _clauses.push_back({
+                        _clauseLiterals.size(), int(learned.size())});
+                _clauseLiterals.insert(
+                        _clauseLiterals.end(), learned.begin(), learned.end());
+                ++_learnedCount;
+                const int clauseIndx = int(_clauses.size() - 1);
+                watchClause(clauseIndx);
+                assign(learned[0], clauseIndx);
+            }
+            _activityInc *= 1.0 / ACTIVITY_DECAY;
+            if(--restartConflicts <= 0) {
+                restartConflicts = RESTART_BASE * luby(++restartCount);
+                cancelUntil(0);
+            }
+            continue;
+        }
+
+        int decision = -1;
+        while(getDecisionLevel() < int(assumptions.size())) {
+            const int assumption = assumptions[SIZE_T(getDecisionLevel())];
+            const int value = getValue(assumption);
+            if(value == VALUE_FALSE) {
+                cancelUntil(0);
+                return SAT_UNSATISFIABLE;
+            }
+            if(value == VALUE_UNDEF) {
+                decision = assumption;
+                break;
+            }
+            // Already true, an empty decision level.
+            _trailLimits.push_back(_trail.size());
+        }
+        if(decision < 0) {
+            while(_heap.empty() == false) {
+                const int var = heapPop();
+                if(_values[SIZE_T(var)] == VALUE_UNDEF) {
+                    decision = makeLiteral(
+                            var, _phases[SIZE_T(var)] != VALUE_TRUE);
+                    break;
+                }
+            }
+            if(decision < 0) {
+                _model = _values;
+                cancelUntil(0);
+                return SAT_SATISFIABLE;
+            }
+        }
+        _trailLimits.push_back(_trail.size());
+        assign(decision, -1);
+    }
+}
+
+bool SatSolver::getModelValue(const int var) const noexcept {
+    return SIZE_T(var) < _model.size() && _model[SIZE_T(var)] == VALUE_TRUE;
+}
+
+SIZE_T SatSolver::getVariableCount() const noexcept {
+    return _values.size();
+}
+
+SIZE_T SatSolver::getClauseCount() const noexcept {
+    return _clauses.size();
+}
+
+SIZE_T SatSolver::getLearnedClauseCount() const noexcept {
+    return _learnedCount;
+}
+
+SIZE_T SatSolver::getConflictCount() const noexcept {
+    return _conflictCount;
+}
+
+}
@@ -0,0 +1,160 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+namespace mozok {
+
+/// @brief A callback class for the `SatSolver::solve(...)`.
+/// Checks the limits of the solver.
+class SatSolverMonitor {
+public:
+    virtual ~SatSolverMonitor() noexcept;
+
+    /// @brief This method will be invoked on every conflict.
+    /// @param clauseCount The number of the clauses, including the learned
+    ///        ones.
+    /// @return Returns `false` if the solver must be stopped.
+    virtual bool onConflict(const SIZE_T clauseCount) noexcept = 0;
+};
+
+/// @brief A small incremental CDCL SAT solver (`strategy SAT`).
+/// The clauses can be added between the `solve(...)` calls, and the learned
+/// clauses are kept, so the solver reuses them in the next calls. The goal
+/// of the next call is given as the assumptions, not as the clauses.
+/// The solver uses two watched literals, the first UIP conflict analysis
+/// with the clause minimization, VSIDS, phase saving and Luby restarts. The
+/// learned clauses are never deleted.
+/// A literal of the variable `v` is `2 * v` (positive) or `2 * v + 1`
+/// (negative), see `makeLiteral()`.
+class SatSolver {
+public:
+    /// @brief The results of the `solve(...)`.
+    enum Status {
+        SAT_SATISFIABLE,
+        SAT_UNSATISFIABLE,
+        SAT_STOPPED
+    };
+
+    /// @brief Returns the literal of the variable.
+    static int makeLiteral(const int var, const bool isNegative) noexcept {
+        return 2 * var + (isNegative ? 1 : 0);
+    }
+
+    /// @brief Returns the negation of the literal.
+    static int negate(const int literal) noexcept {
+        return literal ^ 1;
+    }
+
+private:
+    struct Clause {
+        /// @brief The index of the first literal in `_clauseLiterals`.
+        SIZE_T first;
+        int size;
+    };
+
+    struct Watch {
+        int clauseIndx;
+        /// @brief A literal of the clause. If it is true, the clause is
+        ///        satisfied and isn't visited.
+        int blocker;
+    };
+
+    Vector<Clause> _clauses;
+    Vector<int> _clauseLiterals;
+    SIZE_T _learnedCount;
+
+    /// @brief `_watches[l]` are the clauses that watch the literal `l`.
+    Vector<Vector<Watch>> _watches;
+
+    /// @brief `-1` for the unassigned variables, `1` for true, `0` for false.
+    Vector<signed char> _values;
+    Vector<int> _levels;
+    /// @brief The clause that implied the variable, or `-1`.
+    Vector<int> _reasons;
+    Vector<int> _trail;
+    Vector<SIZE_T> _trailLimits;
+    SIZE_T _propagated;
+
+    /// @brief The saved phases (`1` for true).
+    Vector<signed char> _phases;
+    Vector<signed char> _model;
+
+    /// @brief VSIDS: the heap of the unassigned variables, ordered by
+    ///        the activity.
+    Vector<double> _activity;
+    double _activityInc;
+    Vector<int> _heap;
+    Vector<int> _heapIndices;
+
+    /// @brief The marks of the conflict analysis.
+    Vector<char> _seen;
+    Vector<int> _analyzed;
+    /// @brief The buffer of the `addClause(...)`.
+    Vector<int> _addedClause;
+    bool _isUnsat;
+    SIZE_T _conflictCount;
+
+    int getValue(const int literal) const noexcept;
+    int getDecisionLevel() const noexcept;
+    void assign(const int literal, const int reason) noexcept;
+    void cancelUntil(const int level) noexcept;
+    void watchClause(const int clauseIndx) noexcept;
+
+    /// @brief Propagates the assigned literals.
+    /// @return Returns the conflicting clause, or `-1`.
+    int propagate() noexcept;
+
+    /// @brief Learns a clause from the conflict (the first UIP).
+    /// @param conflict The conflicting clause.
+    /// @param learned Receives the learned clause, with the asserting
+    ///        literal first.
+    /// @return Returns the backjump level.
+    int analyze(const int conflict, Vector<int>& learned) noexcept;
+
+    void bumpActivity(const int var) noexcept;
+    void heapUp(SIZE_T indx) noexcept;
+    void heapDown(SIZE_T indx) noexcept;
+    void heapInsert(const int var) noexcept;
+    int heapPop() noexcept;
+
+public:
+    SatSolver() noexcept;
+
+    /// @brief Adds a new variable.
+    /// @return Returns the index of the variable.
+    int addVariable() noexcept;
+
+    /// @brief Adds a clause. Must not be called during `solve(...)`.
+    /// @param literals The literals of the clause.
+    void addClause(const Vector<int>& literals) noexcept;
+
+    /// @brief Searches for an assignment that satisfies all the clauses and
+    ///        the assumptions.
+    /// @param assumptions The literals that must be true in this call only.
+    /// @param monitor The limits of the search.
+    Status solve(
+            const Vector<int>& assumptions,
+            SatSolverMonitor& monitor
+            ) noexcept;
+
+    /// @brief Returns the value of the variable in the last satisfying
+    ///        assignment.
+    bool getModelValue(const int var) const noexcept;
+
+    /// @brief Returns the number of the variables.
+    SIZE_T getVariableCount() const noexcept;
+
+    /// @brief Returns the number of the clauses, including the learned ones.
+    SIZE_T getClauseCount() const noexcept;
+
+    /// @brief Returns the number of the learned clauses.
+    SIZE_T getLearnedClauseCount() const noexcept;
+
+    /// @brief Returns the number of the conflicts of all the calls.
+    SIZE_T getConflictCount() const noexcept;
+};
+
+}
@@ -0,0 +1,91 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/search_graph.hpp>
+
+namespace mozok {
+
+SearchGraph::SearchGraph(const bool fingerprintOnly) noexcept :
+    _indices(fingerprintOnly),
+    _searchId(0)
+{ /* empty */ }
+
+SIZE_T SearchGraph::size() const noexcept {
+    return _nodes.size();
+}
+
+SearchGraph::Node& SearchGraph::operator[](const SIZE_T nodeIndx) noexcept {
+    return _nodes[nodeIndx];
+}
+
+const SearchGraph::Node& SearchGraph::operator[](
+        const SIZE_T nodeIndx) const noexcept {
+    return _nodes[nodeIndx];
+}
+
+int SearchGraph::find(const BitState& state) noexcept {
+    const int* nodeIndx = _indices.find(state);
+    return nodeIndx == nullptr ? -1 : *nodeIndx;
+}
+
+int SearchGraph::findApplied(
+        const BitState& parent,
+        const BitState::Word* remMask,
+        const BitState::Word* addMask,
+        const Fingerprint& fingerprint
+        ) noexcept {
+    const int* nodeIndx =
+            _indices.findApplied(parent, remMask, addMask, fingerprint);
+    return nodeIndx == nullptr ? -1 : *nodeIndx;
+}
+
+int SearchGraph::add(const BitStatePtr& state, const int h) noexcept {
+    const int nodeIndx = int(_nodes.size());
+    // `searchId` 0 is never current: the searches start from 1.
+    _nodes.push_back({state, h, -1, 0, 0, 0, -1, -1, false});
+    _indices.insert(state, nodeIndx);
+    return nodeIndx;
+}
+
+void SearchGraph::addEdge(const SIZE_T nodeIndx, const Edge& edge) noexcept {
+    Node& node = _nodes[nodeIndx];
+    if(node.firstEdge < 0)
+        node.firstEdge = int(_edges.size());
+    _edges.push_back(edge);
+    ++node.edgeCount;
+}
+
+void SearchGraph::setExpanded(const SIZE_T nodeIndx) noexcept {
+    Node& node = _nodes[nodeIndx];
+    if(node.firstEdge < 0)
+        node.firstEdge = int(_edges.size());
+}
+
+const Vector<SearchGraph::Edge>& SearchGraph::getEdges() const noexcept {
+    return _edges;
+}
+
+void SearchGraph::startSearch() noexcept {
+    ++_searchId;
+}
+
+bool SearchGraph::isReached(const SIZE_T nodeIndx) const noexcept {
+    return _nodes[nodeIndx].searchId == _searchId;
+}
+
+void SearchGraph::reach(
+        const SIZE_T nodeIndx,
+        const int g,
+        const int parent,
+        const int actionIndx
+        ) noexcept {
+    Node& node = _nodes[nodeIndx];
+    if(node.searchId != _searchId) {
+        node.searchId = _searchId;
+        node.isClosed = false;
+    }
+    node.g = g;
+    node.parent = parent;
+    node.actionIndx = actionIndx;
+}
+
+}
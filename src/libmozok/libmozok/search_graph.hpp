@@ -0,0 +1,121 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/bit_state.hpp>
+
+namespace mozok {
+
+class SearchGraph;
+using SearchGraphPtr = SharedPtr<SearchGraph>;
+
+/// @brief The state graph of a quest goal, kept between the planning calls
+/// by the incremental search (`strategy INCREMENTAL`). The graph stores the
+/// visited states, their `h()` values and the outgoing edges of the expanded
+/// states, so a search never generates the successors of a state or
+/// evaluates the heuristic twice. The search values (`g`, the parent and
+/// the closed flag) belong to the search that reached the node last, and are
+/// reset lazily: a node whose `searchId` differs from the current one is
+/// considered unreached.
+class SearchGraph {
+public:
+    struct Edge {
+        /// @brief Index of the possible action (see
+        ///        `Quest::getPossibleActions()`).
+        int actionIndx;
+
+        /// @brief The node of the resulting state.
+        int node;
+    };
+
+    struct Node {
+        BitStatePtr state;
+
+        /// @brief The goal distance estimate. The searches can raise it
+        ///        (see `QuestPlanner::findGoalPlan_Incremental()`).
+        int h;
+
+        /// @brief The edges of the node are
+        ///        `getEdges()[firstEdge .. firstEdge + edgeCount)`.
+        ///        `firstEdge` is `-1` if the node is not expanded yet.
+        int firstEdge;
+        int edgeCount;
+
+        /// @brief The search that reached the node last.
+        unsigned searchId;
+
+        /// @brief Cheapest known length from the start of the search.
+        int g;
+
+        /// @brief The preceding node and the action on the cheapest known
+        ///        path (`-1` for the start node).
+        int parent;
+        int actionIndx;
+
+        /// @brief `true` if the node was expanded by the search.
+        bool isClosed;
+    };
+
+private:
+    Vector<Node> _nodes;
+    Vector<Edge> _edges;
+    BitStateMap<int> _indices;
+    unsigned _searchId;
+
+public:
+    /// @param fingerprintOnly If `true`, states with equal fingerprints are
+    ///        considered equal (see `BitStateMap`).
+    SearchGraph(const bool fingerprintOnly) noexcept;
+
+    /// @brief Returns the number of nodes.
+    SIZE_T size() const noexcept;
+
+    Node& operator[](const SIZE_T nodeIndx) noexcept;
+    const Node& operator[](const SIZE_T nodeIndx) const noexcept;
+
+    /// @brief Returns the node of the state, or `-1`.
+    int find(const BitState& state) noexcept;
+
+    /// @brief Returns the node of the state that `parent.apply(...)` would
+    ///        produce, or `-1` (see `BitStateMap::findApplied()`).
+    int findApplied(
+            const BitState& parent,
+            const BitState::Word* remMask,
+            const BitState::Word* addMask,
+            const Fingerprint& fingerprint
+            ) noexcept;
+
+    /// @brief Adds a new unexpanded node (the state must not be present).
+    /// @return Returns the index of the node.
+    int add(const BitStatePtr& state, const int h) noexcept;
+
+    /// @brief Adds an edge of the node that is being expanded. The edges of
+    ///        a node must be added one after another, without adding the
+    ///        edges of other nodes in between.
+    void addEdge(const SIZE_T nodeIndx, const Edge& edge) noexcept;
+
+    /// @brief Marks the node as expanded, even if it has no edges.
+    void setExpanded(const SIZE_T nodeIndx) noexcept;
+
+    const Vector<Edge>& getEdges() const noexcept;
+
+    /// @brief Starts a new search. All the nodes become unreached.
+    void startSearch() noexcept;
+
+    /// @brief Checks if the node was reached by the current search.
+    bool isReached(const SIZE_T nodeIndx) const noexcept;
+
+    /// @brief Sets the search values of the node and marks it as reached
+    ///        by the current search.
+    void reach(
+            const SIZE_T nodeIndx,
+            const int g,
+            const int parent,
+            const int actionIndx
+            ) noexcept;
+};
+
+}
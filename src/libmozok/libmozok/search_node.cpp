@@ -0,0 +1,112 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/search_node.hpp>
+
+namespace mozok {
+
+bool OpenNodeCmp_AStar::operator() (
+        const OpenNode& a, const OpenNode& b) const noexcept {
+    return a.fScore > b.fScore;
+}
+
+bool OpenNodeCmp_DFS::operator() (
+        const OpenNode& a, const OpenNode& b) const noexcept {
+    if(a.gScore != b.gScore)
+        return a.gScore < b.gScore;
+    return a.fScore > b.fScore;
+}
+
+bool OpenNodeCmp_GBFS::operator() (
+        const OpenNode& a, const OpenNode& b) const noexcept {
+    // h(n) = f(n) - g(n)
+    const int aHScore = a.fScore - a.gScore;
+    const int bHScore = b.fScore - b.gScore;
+    if(aHScore != bHScore)
+        return aHScore > bHScore;
+    return a.gScore > b.gScore;
+}
+
+bool OpenNodeCmp_BFS::operator() (
+        const OpenNode& a, const OpenNode& b) const noexcept {
+    if(a.gScore != b.gScore)
+        return a.gScore > b.gScore;
+    return a.fScore > b.fScore;
+}
+
+const OpenNodeCmp_AStar openNodeCmp_AStar;
+const OpenNodeCmp_DFS openNodeCmp_DFS;
+const OpenNodeCmp_GBFS openNodeCmp_GBFS;
+const OpenNodeCmp_BFS openNodeCmp_BFS;
+
+bool isAdmissibleHeuristic(const QuestSettings& settings) noexcept {
+    return settings.heuristic == QuestHeuristic::HMAX
+            || settings.heuristic == QuestHeuristic::PDB;
+}
+
+bool isOptimalSearch(const QuestSettings& settings) noexcept {
+    return isAdmissibleHeuristic(settings)
+            && settings.strategy == QuestSearchStrategy::IDA;
+}
+
+ActionPtr makePlanAction(
+        const ActionPtr& action,
+        const ObjectVec& arguments
+        ) noexcept {
+    StatementVec emptySVec;
+    return makeShared<Action>(
+            action->getName(), action->getId(), action->isNotApplicable(),
+            arguments, emptySVec, emptySVec, emptySVec);
+}
+
+ActionVec makePlanActions(
+        const Quest& quest,
+        const Vector<int>& actionIndices
+        ) noexcept {
+    ActionVec plan;
+    plan.reserve(actionIndices.size());
+    for(const int actionIndx : actionIndices) {
+        const Quest::ActionWithArgs& aa =
+                quest.getPossibleActions()[SIZE_T(actionIndx)];
+        plan.push_back(makePlanAction(aa.action, aa.arguments));
+    }
+    return plan;
+}
+
+Vector<int> buildPlan(
+        const Vector<const SearchArena*>& arenas,
+        NodeRef finalNode
+        ) noexcept {
+    const SearchNode& last =
+            (*arenas[finalNode >> 32])[SIZE_T(std::uint32_t(finalNode))];
+    Vector<int> plan(SIZE_T(last.gScore), -1);
+    while(finalNode != NO_NODE) {
+        const SearchNode& node =
+                (*arenas[finalNode >> 32])[SIZE_T(std::uint32_t(finalNode))];
+        if(node.actionIndx >= 0)
+            plan[SIZE_T(node.gScore - 1)] = node.actionIndx;
+        finalNode = node.preceding;
+    }
+    return plan;
+}
+
+bool checkPlanSuffix(
+        const Quest& quest,
+        const BitState& state,
+        const Vector<int>& plan,
+        const SIZE_T first,
+        const BitState& goalMask
+        ) noexcept {
+    BitState current(state);
+    for(SIZE_T i = first; i < plan.size(); ++i) {
+        const SIZE_T actionIndx = SIZE_T(plan[i]);
+        if(current.hasSubstate(quest.getActionPreMask(actionIndx)) == false)
+            return false;
+        current.apply(
+                quest.getActionRemMask(actionIndx),
+                quest.getActionAddMask(actionIndx),
+                quest.getStatementKeys());
+    }
+    return current.hasSubstate(goalMask);
+}
+
+}
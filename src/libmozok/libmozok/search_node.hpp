@@ -0,0 +1,193 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/action.hpp>
+#include <libmozok/quest.hpp>
+#include <libmozok/bit_state.hpp>
+#include <libmozok/quest_manager.hpp>
+
+#include <cstdint>
+
+namespace mozok {
+
+/// @brief A reference to a search node: the arena index in the upper 32 bits
+///        and the node index inside the arena in the lower 32 bits.
+using NodeRef = std::uint64_t;
+const NodeRef NO_NODE = ~NodeRef(0);
+
+inline NodeRef makeNodeRef(
+        const SIZE_T arenaIndx, const SIZE_T nodeIndx) noexcept {
+    return (NodeRef(arenaIndx) << 32) | NodeRef(std::uint32_t(nodeIndx));
+}
+
+/// @brief The closed list of a search.
+using KnownStates = BitStateMap<bool>;
+
+/// @brief A node in the state graph.
+struct SearchNode {
+    /// @brief Node state.
+    BitStatePtr state;
+
+    /// @brief Preceding node on the cheapest path from the initial state
+    ///     to this node (`NO_NODE` for the initial node).
+    NodeRef preceding;
+
+    /// @brief Index of the possible action (see `Quest::getPossibleActions()`)
+    ///     that changes state from the preceding to current state
+    ///     (`-1` for the initial node).
+    int actionIndx;
+
+    /// @brief Cheapest known length from the initial state.
+    int gScore;
+
+	/// @brief Best guess of shortest length from the initial state
+    ///     (f(n) = g(n) + h(n)).
+	int fScore;
+
+    /// @brief The set of the landmarks accepted on the path to this node
+    ///     (see `HeuristicCalculator::calculate()`), `-1` if not used.
+    int landmarks;
+};
+
+/// @brief Node storage of a single search. Nodes are appended to a flat array
+/// and refer to each other by `NodeRef`, so they are neither allocated nor
+/// reference counted individually. All the nodes are freed at once, when the
+/// arena is destroyed at the end of the search.
+class SearchArena {
+    Vector<SearchNode> _nodes;
+
+public:
+    /// @brief Appends a node and returns its index.
+    SIZE_T add(const SearchNode& node) noexcept {
+        _nodes.push_back(node);
+        return _nodes.size() - 1;
+    }
+
+    SearchNode& operator[](const SIZE_T nodeIndx) noexcept {
+        return _nodes[nodeIndx];
+    }
+
+    const SearchNode& operator[](const SIZE_T nodeIndx) const noexcept {
+        return _nodes[nodeIndx];
+    }
+
+    SIZE_T size() const noexcept {
+        return _nodes.size();
+    }
+};
+
+/// @brief An open list entry. Scores are copied from the node, so the
+///        comparison doesn't need to access the arena.
+struct OpenNode {
+    int fScore;
+    int gScore;
+    SIZE_T nodeIndx;
+};
+
+// Open node comparison classes.
+
+struct OpenNodeCmp_Base {
+    virtual bool operator() (
+        const OpenNode& a, const OpenNode& b) const noexcept = 0;
+};
+
+/// @brief Lowest `f()` first.
+struct OpenNodeCmp_AStar : public OpenNodeCmp_Base {
+    bool operator() (
+        const OpenNode& a, const OpenNode& b) const noexcept override;
+};
+
+/// @brief Deepest first, then lowest `f()`.
+struct OpenNodeCmp_DFS : public OpenNodeCmp_Base {
+    bool operator() (
+        const OpenNode& a, const OpenNode& b) const noexcept override;
+};
+
+/// @brief Lowest `h()` first, then shallowest.
+struct OpenNodeCmp_GBFS : public OpenNodeCmp_Base {
+    bool operator() (
+        const OpenNode& a, const OpenNode& b) const noexcept override;
+};
+
+/// @brief Shallowest first, then lowest `f()`.
+struct OpenNodeCmp_BFS : public OpenNodeCmp_Base {
+    bool operator() (
+        const OpenNode& a, const OpenNode& b) const noexcept override;
+};
+
+extern const OpenNodeCmp_AStar openNodeCmp_AStar;
+extern const OpenNodeCmp_DFS openNodeCmp_DFS;
+extern const OpenNodeCmp_GBFS openNodeCmp_GBFS;
+extern const OpenNodeCmp_BFS openNodeCmp_BFS;
+
+class OpenNodeCmp {
+    const OpenNodeCmp_Base* const _cmpObj;
+public:
+    OpenNodeCmp(const OpenNodeCmp_Base* const cmpObj) noexcept
+    : _cmpObj(cmpObj) { /*empty*/ }
+    bool operator() (const OpenNode& a, const OpenNode& b) noexcept {
+        return _cmpObj->operator()(a,b);
+    }
+};
+
+using OpenNodeQueue = PriorityQueue<OpenNode, OpenNodeCmp>;
+
+/// @brief Checks if the heuristic of the settings never overestimates the
+///        length of the plan (`HMAX` and `PDB`). The `SIMPLE` heuristic
+///        weights the goal statements by their arity plus `omega`, and the
+///        other relaxed heuristics count the shared actions several times.
+bool isAdmissibleHeuristic(const QuestSettings& settings) noexcept;
+
+/// @brief Checks if the plans found with the settings are proven to be
+///        optimal: `IDA` with an admissible heuristic. Only the lengths of
+///        such plans are the exact goal distances. `ASTAR` doesn't reopen
+///        the states reached again by a shorter path, so its plans are not
+///        proven to be optimal.
+bool isOptimalSearch(const QuestSettings& settings) noexcept;
+
+/// @brief Creates an action for the `QuestPlan::plan` list. Plan actions don't
+///        contain action's pre, add and rem statements.
+ActionPtr makePlanAction(
+        const ActionPtr& action,
+        const ObjectVec& arguments
+        ) noexcept;
+
+/// @brief Creates the plan actions of the possible actions. Plan actions are
+///        created only here, for the final plan.
+/// @param quest The quest.
+/// @param actionIndices Indices of the possible actions of the plan.
+/// @return Returns the list of plan actions.
+ActionVec makePlanActions(
+        const Quest& quest,
+        const Vector<int>& actionIndices
+        ) noexcept;
+
+/// @brief Builds the plan by following the preceding nodes.
+/// @param arenas Node arenas of the search.
+/// @param finalNode The node containing the goal state.
+/// @return Returns the indices of the possible actions of the plan.
+Vector<int> buildPlan(
+        const Vector<const SearchArena*>& arenas,
+        NodeRef finalNode
+        ) noexcept;
+
+/// @brief Checks if the actions `plan[first..]` can be applied one after
+///        another to the state, and if they achieve the goal.
+/// @param quest The quest.
+/// @param state The state.
+/// @param plan Indices of the possible actions of the plan.
+/// @param first The first action of the suffix.
+/// @param goalMask The goal.
+bool checkPlanSuffix(
+        const Quest& quest,
+        const BitState& state,
+        const Vector<int>& plan,
+        const SIZE_T first,
+        const BitState& goalMask
+        ) noexcept;
+
+}
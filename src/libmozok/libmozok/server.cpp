@@ -35,6 +35,9 @@ class ServerImpl : public mozok::Server {
     Atomic<bool> _stopWorkerThread;
     Atomic<bool> _isWorkerJoined;
 
+    /// @brief The default time limit of a quest planning (microseconds).
+    Atomic<int> _planningTimeLimitUs;
+
 
     explicit ServerImpl(Str serverName) noexcept : 
         _serverName(std::move(serverName)),
@@ -43,7 +46,8 @@ class ServerImpl : public mozok::Server {
         _actionQueue(),
         _isWorkerRunning(false),
         _stopWorkerThread(false),
-        _isWorkerJoined(true)
+        _isWorkerJoined(true),
+        _planningTimeLimitUs(0)
     { /* empty */ }
 
 
@@ -111,7 +115,8 @@ class ServerImpl : public mozok::Server {
 
     void performPlanningUnsafe() noexcept {
         for(auto& worlds : _worlds)
-            worlds.second->performPlanning(_messageQueue);
+            worlds.second->performPlanning(
+                    _messageQueue, _planningTimeLimitUs.load());
     }
 
 public:
@@ -246,6 +251,20 @@ public:
         return _worlds[worldName]->hasMainQuest(mainQuestName);
     }
 
+    Result setQuestOption(
+            const Str& worldName,
+            const Str& questName,
+            const Str& optionName,
+            const Str& optionValue
+            ) noexcept override {
+        if(_isWorkerJoined.load() == false)
+            return errorServerWorkerIsRunning(_serverName);
+        if(hasWorld(worldName) == false)
+            return errorWorldDoesntExist(_serverName, worldName);
+        return _worlds[worldName]->setQuestOption(
+                questName, optionName, optionValue);
+    }
+
     
     // ============================== ACTIONS =============================== //
 
@@ -336,6 +355,10 @@ public:
         return Result::OK();
     }
 
+    void setPlanningTimeLimit(const int timeLimitUs) noexcept override {
+        _planningTimeLimitUs.store(timeLimitUs);
+    }
+
     // =============================== WORKER =============================== //
 
     Result startWorkerThread() noexcept override {
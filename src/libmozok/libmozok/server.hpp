@@ -168,6 +168,22 @@ public:
             const mozok::Str& subQuestName
             ) noexcept = 0;
 
+    /// @brief Changes an option of a quest, as if it was given in the 
+    ///        `options:` section of the quest definition (see the .quest 
+    ///        format reference). The `use_atree` option can't be changed.
+    /// @param worldName The name of the world.
+    /// @param questName The name of the main quest or subquest.
+    /// @param optionName The name of the option (for example `strategy`).
+    /// @param optionValue The value of the option (for example `BEAM`). 
+    ///        Empty for the options without a value (`fingerprint_only`).
+    /// @return Returns the status of the operation.
+    virtual mozok::Result setQuestOption(
+            const mozok::Str& worldName,
+            const mozok::Str& questName,
+            const mozok::Str& optionName,
+            const mozok::Str& optionValue
+            ) noexcept = 0;
+
     /// @}
 
 
@@ -278,6 +294,13 @@ public:
     /// @brief Performs one planning step for all active quests.
     virtual mozok::Result performPlanning() noexcept = 0;
 
+    /// @brief Sets the wall-clock time limit of a quest planning, used by the 
+    ///        quests without the `timeLimitUs` option. When the limit is 
+    ///        reached, the `onTimeLimitReached` message is sent. Can be 
+    ///        called while the worker thread is running.
+    /// @param timeLimitUs The time limit in microseconds (`0` means no limit).
+    virtual void setPlanningTimeLimit(const int timeLimitUs) noexcept = 0;
+
     /// @}
 
 
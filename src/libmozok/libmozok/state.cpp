@@ -3,6 +3,8 @@
 #include <libmozok/state.hpp>
 #include <libmozok/quest.hpp>
 
+#include <algorithm>
+
 namespace mozok {
 
 std::size_t StateHash::operator()(const StatePtr& state) const noexcept {
@@ -16,99 +18,124 @@ bool StateEqual::operator()(const StatePtr& a, const StatePtr& b) const noexcept
 
     if(a->getHash() != b->getHash())
         return false;
-    const StatementSet& aSet = a->getStatementSet();
-    const StatementSet& bSet = b->getStatementSet();
-    if(aSet.size() != bSet.size()) {
+    if(a->getSize() != b->getSize()) {
         #ifdef MOZOK_OUTPUT_HASH_COLLISIONS_INFO
         ccounter++;
         printf("StatePtr: collision Type1 %d!\n", ccounter);
         #endif
         return false;
     }
-    for(const StatementPtr& statement : aSet)
-        if(bSet.find(statement) == bSet.end()) {
-            #ifdef MOZOK_OUTPUT_HASH_COLLISIONS_INFO
-            ccounter++;
-            printf("StatePtr: collision Ttype2 %d!\n\n", ccounter);
-
-            printf("%lld == %lld\n\n", a->getHash(), b->getHash());
-            printf("A set:\n");
-            for(const StatementPtr& statement : aSet)
-                printf("%s(%s, %s) : %lld\n", 
-                    statement->getRelation()->getName().c_str(),
-                    statement->getArguments()[0]->getName().c_str(),
-                    statement->getArguments()[1]->getName().c_str(),
-                    statement->getHash());
-            printf("\n\n");
-            printf("B set:\n");
-            for(const StatementPtr& statement : bSet)
-                printf("%s(%s, %s) : %lld\n", 
-                    statement->getRelation()->getName().c_str(),
-                    statement->getArguments()[0]->getName().c_str(),
-                    statement->getArguments()[1]->getName().c_str(),
-                    statement->getHash());
-            printf("\n\n");
-            #endif
-
-            return false;
-        }
+    if(a->isEqual(*b) == false) {
+        #ifdef MOZOK_OUTPUT_HASH_COLLISIONS_INFO
+        ccounter++;
+        printf("StatePtr: collision Type2 %d!\n", ccounter);
+        #endif
+        return false;
+    }
     return true;
 }
 
 
-State::State(const StatementVec& statements) noexcept :
-    _hash(computeHash()) {
+State::State(
+        const StatementTablePtr& table, 
+        const StatementVec& statements
+        ) noexcept :
+    _table(table),
+    _size(0),
+    _hash(0) {
     addStatements(statements);
 }
 
-const StatementSet& State::getStatementSet() const noexcept {
-    return _state;
+const StatementTablePtr& State::getTable() const noexcept {
+    return _table;
+}
+
+std::size_t State::getHash() const noexcept {
+    return _hash;
+}
+
+SIZE_T State::getSize() const noexcept {
+    return _size;
+}
+
+bool State::hasStatement(const StatementId id) const noexcept {
+    const SIZE_T w = SIZE_T(id) / BitState::WORD_BITS;
+    if(w >= _words.size())
+        return false;
+    return (_words[w] >> (SIZE_T(id) % BitState::WORD_BITS)) & BitState::Word(1);
 }
 
 bool State::hasSubstate(const StatementVec& substate) const noexcept {
-    for(const StatementPtr& statement : substate)
-        if(_state.find(statement) == _state.end())
+    for(const StatementPtr& statement : substate) {
+        const StatementId id = _table->find(statement);
+        if(id == INVALID_STATEMENT_ID || hasStatement(id) == false)
             return false;
+    }
     return true;
 }
 
-void State::addStatements(const StatementVec& statements) noexcept {
-    for(const StatementPtr& statement : statements)
-        if(_state.find(statement) == _state.end()) {
-            _state.insert(statement);
-            _hash ^= statement->getHash();
-        }
+void State::addStatement(const StatementId id) noexcept {
+    if(hasStatement(id))
+        return;
+    const SIZE_T w = SIZE_T(id) / BitState::WORD_BITS;
+    if(w >= _words.size())
+        _words.resize(BitState::getWordCount(_table->size()), BitState::Word(0));
+    _words[w] |= BitState::Word(1) << (SIZE_T(id) % BitState::WORD_BITS);
+    _hash ^= std::size_t(_table->getKey(id).lo);
+    ++_size;
 }
 
-void State::removeStatements(const StatementVec& statements) noexcept {
+void State::removeStatement(const StatementId id) noexcept {
+    if(hasStatement(id) == false)
+        return;
+    const SIZE_T w = SIZE_T(id) / BitState::WORD_BITS;
+    _words[w] &= ~(BitState::Word(1) << (SIZE_T(id) % BitState::WORD_BITS));
+    _hash ^= std::size_t(_table->getKey(id).lo);
+    --_size;
+}
+
+void State::addStatements(const StatementVec& statements) noexcept {
     for(const StatementPtr& statement : statements)
-        if(_state.find(statement) != _state.end()) {
-            _state.erase(statement);
-            _hash ^= statement->getHash();
-        }
+        addStatement(_table->intern(statement));
 }
 
-std::size_t State::computeHash() const noexcept {
-    std::size_t result = 0;
-    for(const StatementPtr& statement : _state)
-        result ^= statement->getHash();
-    return result;
+void State::removeStatements(const StatementVec& statements) noexcept {
+    for(const StatementPtr& statement : statements) {
+        const StatementId id = _table->find(statement);
+        if(id != INVALID_STATEMENT_ID)
+            removeStatement(id);
+    }
 }
 
-std::size_t State::getHash() const noexcept {
-    return _hash;
+bool State::isEqual(const State& other) const noexcept {
+    const Vector<BitState::Word>& a = _words;
+    const Vector<BitState::Word>& b = other._words;
+    const SIZE_T common = std::min(a.size(), b.size());
+    for(SIZE_T w = 0; w < common; ++w)
+        if(a[w] != b[w])
+            return false;
+    // Missing words are considered to be zero.
+    for(SIZE_T w = common; w < a.size(); ++w)
+        if(a[w] != 0)
+            return false;
+    for(SIZE_T w = common; w < b.size(); ++w)
+        if(b[w] != 0)
+            return false;
+    return true;
 }
 
 StatePtr State::duplicate() const noexcept {
-    StatePtr res = makeShared<State>(StatementVec());
+    StatePtr res = makeShared<State>(_table, StatementVec());
+    res->_words = _words;
+    res->_size = _size;
     res->_hash = _hash;
-    res->_state = _state;
     return res;
 }
 
 StatePtr State::duplicate(const Quest& quest) const noexcept {
-    StatePtr res = makeShared<State>(StatementVec());
-    for(const StatementPtr& statement : _state) {
+    StatePtr res = makeShared<State>(_table, StatementVec());
+    forEachStatementId([&](const StatementId id) {
+        const StatementPtr& statement = _table->getStatement(id);
         bool relevant = quest.isRelationRelevant(
                 statement->getRelation()->getId());
         if(relevant)
@@ -118,9 +145,8 @@ StatePtr State::duplicate(const Quest& quest) const noexcept {
                     break;
                 }
         if(relevant)
-            res->_state.insert(statement);
-    }
-    res->_hash = res->computeHash();
+            res->addStatement(id);
+    });
     return res;
 }
 
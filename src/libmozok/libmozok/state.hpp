@@ -8,6 +8,8 @@
 #include <libmozok/object.hpp>
 #include <libmozok/relation.hpp>
 #include <libmozok/statement.hpp>
+#include <libmozok/statement_table.hpp>
+#include <libmozok/bit_state.hpp>
 
 namespace mozok {
 
@@ -32,25 +34,45 @@ using StateSet = HashSet<StatePtr, StateHash, StateEqual>;
 /// Every fact is a statement, where each argument is a real object (with 
 /// non-negative ID) from the quest world. The quest state is essentially a set 
 /// of relations between these objects.
+/// Statements are stored as interned IDs (see `StatementTable`) in a bitset, 
+/// so the membership tests and the action applications don't allocate.
 class State {
-    /// @brief The set of all state statements.
-    StatementSet _state;
+    /// @brief The statement table of the world this state belongs to.
+    const StatementTablePtr _table;
 
-    /// @brief State's hash value.
+    /// @brief The i-th bit is set if the statement with ID `i` is present.
+    Vector<BitState::Word> _words;
+
+    /// @brief The number of statements in the state.
+    SIZE_T _size;
+
+    /// @brief State's hash value: XOR of the Zobrist keys of the statements 
+    ///        (see `Fingerprint`).
     /// The state hash function is "XOR-linear," making it easy and
     /// straightforward to compute a new hash value by knowing which states were 
     /// added and removed from the state.
     std::size_t _hash;
 
-    /// @brief Computes a hash value of the current state. 
-    /// @return Returns a recalculated hash value.
-    std::size_t computeHash() const noexcept;
-
 public:
-    State(const StatementVec& statements) noexcept;
+    State(
+            const StatementTablePtr& table, 
+            const StatementVec& statements
+            ) noexcept;
 
-    const StatementSet& getStatementSet() const noexcept;
+    const StatementTablePtr& getTable() const noexcept;
     std::size_t getHash() const noexcept;
+    SIZE_T getSize() const noexcept;
+
+    /// @brief Calls `f(id)` for every statement ID of the state, in the
+    ///        increasing order.
+    template<typename F>
+    void forEachStatementId(F f) const noexcept {
+        BitState::forEachBit(_words.data(), _words.size(), 
+            [&](const SIZE_T bitIndx) { f(StatementId(bitIndx)); });
+    }
+
+    /// @brief Checks if this state contains a statement with the given ID.
+    bool hasStatement(const StatementId id) const noexcept;
 
     /// @brief Checks if this state contains a given list of statements.
     /// @param substate A list of statements.
@@ -58,6 +80,14 @@ public:
     ///         given list.
     bool hasSubstate(const StatementVec& substate) const noexcept;
 
+    /// @brief Adds the statement with the given ID (if not present).
+    /// Automatically calculates the new hash value.
+    void addStatement(const StatementId id) noexcept;
+
+    /// @brief Removes the statement with the given ID (if present).
+    /// Automatically calculates the new hash value.
+    void removeStatement(const StatementId id) noexcept;
+
     /// @brief Modifies the state by adding the provided list of statements. 
     /// Automatically calculates the new hash value.
     /// @param substate A list of statements to be added.
@@ -68,6 +98,9 @@ public:
     /// @param substate A list of statements to be removed.
     void removeStatements(const StatementVec& substate) noexcept;
 
+    /// @brief Checks if both states contain the same statements.
+    bool isEqual(const State& other) const noexcept;
+
     /// @brief Creates a full duplicate state.
     StatePtr duplicate() const noexcept;
 
@@ -25,8 +25,8 @@ bool StatementEqual::operator()(
         #endif
         return false;
     }
-    const ObjectVec argA = a->getArguments();
-    const ObjectVec argB = b->getArguments();
+    const ObjectVec& argA = a->getArguments();
+    const ObjectVec& argB = b->getArguments();
     if(argA.size() != argB.size()) {
         #ifdef MOZOK_OUTPUT_HASH_COLLISIONS_INFO
         ccounter++;
@@ -103,24 +103,32 @@ const RelationPtr& Statement::getRelation() const noexcept {
     return _relation;
 }
 
-ObjectVec& Statement::getArguments() noexcept {
+const ObjectVec& Statement::getArguments() const noexcept {
     return _arguments;
 }
 
-const ObjectVec& Statement::getArguments() const noexcept {
-    return _arguments;
+std::size_t Statement::hashRelation(const ID relationId) noexcept {
+    return std::hash<ID>{}(relationId);
+}
+
+std::size_t Statement::hashArgument(
+        const ID relationId,
+        const SIZE_T argIndx,
+        const ID objectId
+        ) noexcept {
+    return std::hash<ID>{}(
+            // 10007 and 100003 are both prime numbers.
+            relationId 
+            + static_cast<ID>(argIndx) * static_cast<ID>(10007) 
+            + objectId * static_cast<ID>(100003));
 }
 
 std::size_t Statement::computeHash() const noexcept {
-    std::size_t result = std::hash<ID>{}(_relation->getId());
+    const ID relationId = _relation->getId();
+    std::size_t result = hashRelation(relationId);
     const ObjectVec& args = getArguments();
-    for(ObjectVec::size_type i = 0; i < args.size(); ++i) {
-        result += std::hash<ID>{}(
-                // 10007 and 100003 are both prime numbers.
-                _relation->getId() 
-                + static_cast<ID>(i) * static_cast<ID>(10007) 
-                + args[i]->getId() * static_cast<ID>(100003));
-    }
+    for(ObjectVec::size_type i = 0; i < args.size(); ++i)
+        result += hashArgument(relationId, SIZE_T(i), args[i]->getId());
     return result;
 }
 
@@ -128,8 +136,4 @@ std::size_t Statement::getHash() const noexcept {
     return _hash;
 }
 
-void Statement::recalculateHash() noexcept {
-    _hash = computeHash();
-}
-
 }
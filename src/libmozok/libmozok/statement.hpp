@@ -33,7 +33,7 @@ class Statement {
     const RelationPtr _relation;
 
     /// @brief Statement's arguments.
-    ObjectVec _arguments;
+    const ObjectVec _arguments;
 
     /// @brief A statement is considered constant if it contains only global 
     ///        objects and no variables.
@@ -46,13 +46,27 @@ class Statement {
     /// @brief Statement hash value.
     /// The statement hash function should be chosen so that the XOR combination 
     /// of such hash values remains relatively good as a hash value by itself.
-    std::size_t _hash;
+    const std::size_t _hash;
 
     bool isConstant(const ObjectVec& arguments) const noexcept;
     bool isGlobal(const ObjectVec& arguments) const noexcept;
     std::size_t computeHash() const noexcept;
 
 public:
+    /// @brief The relation part of the statement hash value.
+    static std::size_t hashRelation(const ID relationId) noexcept;
+
+    /// @brief The hash value contribution of a single argument. The statement 
+    ///        hash value is `hashRelation(...)` plus the sum of contributions 
+    ///        of all the arguments.
+    /// @param relationId Statement's relation ID.
+    /// @param argIndx Argument's index.
+    /// @param objectId Argument's object ID.
+    static std::size_t hashArgument(
+            const ID relationId,
+            const SIZE_T argIndx,
+            const ID objectId) noexcept;
+
     Statement(const RelationPtr& relation, const ObjectVec& arguments) noexcept;
     
     /// @brief A statement is considered constant if it contains only global 
@@ -80,15 +94,6 @@ public:
     const RelationPtr& getRelation() const noexcept;
     const ObjectVec& getArguments() const noexcept;
     std::size_t getHash() const noexcept;
-
-    /// @brief A non-constant version of the `getArguments`.
-    /// WARNING! You should call the `recalculateHash()` function after 
-    /// modifying the arguments.
-    /// @return Statement's arguments.
-    ObjectVec& getArguments() noexcept;
-
-    /// @brief Recalculates the hash value.
-    void recalculateHash() noexcept;
 };
 
 
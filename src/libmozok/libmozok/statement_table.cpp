@@ -0,0 +1,141 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/statement_table.hpp>
+
+namespace mozok {
+
+namespace {
+    /// @brief The initial number of slots (must be a power of two).
+    const SIZE_T INITIAL_SLOT_COUNT = 1024;
+}
+
+StatementTable::StatementTable() noexcept :
+    _slots(INITIAL_SLOT_COUNT, INVALID_STATEMENT_ID),
+    _keySeed(0x6d6f7a6f6b5f6b65ULL)
+{ /* empty */ }
+
+std::uint64_t StatementTable::nextKey() noexcept {
+    std::uint64_t z = (_keySeed += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+std::size_t StatementTable::computeHash(
+        const StatementPtr& pattern,
+        const ObjectVec& arguments
+        ) noexcept {
+    // Must be the same as `Statement::computeHash()` of the substituted
+    // statement.
+    const ID relationId = pattern->getRelation()->getId();
+    std::size_t result = Statement::hashRelation(relationId);
+    const ObjectVec& args = pattern->getArguments();
+    for(ObjectVec::size_type i = 0; i < args.size(); ++i) {
+        const ID argId = args[i]->getId();
+        const ID objectId = argId >= ID(0)
+                ? argId : arguments[ID(-1) - argId]->getId();
+        result += Statement::hashArgument(relationId, SIZE_T(i), objectId);
+    }
+    return result;
+}
+
+bool StatementTable::isEqual(
+        const StatementId id,
+        const StatementPtr& pattern,
+        const ObjectVec& arguments
+        ) const noexcept {
+    const StatementPtr& statement = _statements[id];
+    if(statement->getRelation() != pattern->getRelation())
+        return false;
+    const ObjectVec& stArgs = statement->getArguments();
+    const ObjectVec& patternArgs = pattern->getArguments();
+    if(stArgs.size() != patternArgs.size())
+        return false;
+    for(ObjectVec::size_type i = 0; i < patternArgs.size(); ++i) {
+        const ID argId = patternArgs[i]->getId();
+        const ID objectId = argId >= ID(0)
+                ? argId : arguments[ID(-1) - argId]->getId();
+        if(stArgs[i]->getId() != objectId)
+            return false;
+    }
+    return true;
+}
+
+void StatementTable::insertSlot(const StatementId id) noexcept {
+    const SIZE_T mask = _slots.size() - 1;
+    SIZE_T slot = _hashes[id] & mask;
+    while(_slots[slot] != INVALID_STATEMENT_ID)
+        slot = (slot + 1) & mask;
+    _slots[slot] = id;
+}
+
+void StatementTable::grow() noexcept {
+    _slots.assign(_slots.size() * 2, INVALID_STATEMENT_ID);
+    for(StatementId id = 0; id < StatementId(_statements.size()); ++id)
+        insertSlot(id);
+}
+
+StatementId StatementTable::find(
+        const StatementPtr& statement) const noexcept {
+    return find(statement, ObjectVec());
+}
+
+StatementId StatementTable::find(
+        const StatementPtr& pattern,
+        const ObjectVec& arguments
+        ) const noexcept {
+    const std::size_t hash = computeHash(pattern, arguments);
+    const SIZE_T mask = _slots.size() - 1;
+    for(SIZE_T slot = hash & mask; ; slot = (slot + 1) & mask) {
+        const StatementId id = _slots[slot];
+        if(id == INVALID_STATEMENT_ID)
+            return INVALID_STATEMENT_ID;
+        if(_hashes[id] == hash && isEqual(id, pattern, arguments))
+            return id;
+    }
+}
+
+StatementId StatementTable::intern(const StatementPtr& statement) noexcept {
+    const StatementId id = find(statement);
+    if(id != INVALID_STATEMENT_ID)
+        return id;
+    const StatementId newId = StatementId(_statements.size());
+    _statements.push_back(statement);
+    _hashes.push_back(statement->getHash());
+    const std::uint64_t lo = nextKey();
+    const std::uint64_t hi = nextKey();
+    _keys.push_back({lo, hi});
+    // Keep the load factor below 1/2.
+    if(_statements.size() * 2 > _slots.size())
+        grow();
+    else
+        insertSlot(newId);
+    return newId;
+}
+
+StatementId StatementTable::intern(
+        const StatementPtr& pattern,
+        const ObjectVec& arguments
+        ) noexcept {
+    const StatementId id = find(pattern, arguments);
+    if(id != INVALID_STATEMENT_ID)
+        return id;
+    return intern(pattern->isConstant()
+            ? pattern : pattern->substitute(arguments));
+}
+
+const StatementPtr& StatementTable::getStatement(
+        const StatementId id) const noexcept {
+    return _statements[id];
+}
+
+const Fingerprint& StatementTable::getKey(
+        const StatementId id) const noexcept {
+    return _keys[id];
+}
+
+SIZE_T StatementTable::size() const noexcept {
+    return _statements.size();
+}
+
+}
@@ -0,0 +1,130 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/object.hpp>
+#include <libmozok/statement.hpp>
+
+#include <cstdint>
+
+namespace mozok {
+
+/// @brief A stable integer ID of an interned statement.
+using StatementId = std::uint32_t;
+using StatementIdVec = Vector<StatementId>;
+using StatementIdSet = HashSet<StatementId>;
+
+/// @brief The ID returned when the statement is not in the table.
+const StatementId INVALID_STATEMENT_ID = StatementId(~StatementId(0));
+
+/// @brief A 128-bit Zobrist fingerprint. Every interned statement has a random 
+///        key, and the fingerprint of a state is the XOR of the keys of all 
+///        its statements. The lower half is used as the state hash value.
+struct Fingerprint {
+    std::uint64_t lo;
+    std::uint64_t hi;
+
+    Fingerprint& operator^=(const Fingerprint& other) noexcept {
+        lo ^= other.lo;
+        hi ^= other.hi;
+        return *this;
+    }
+
+    bool operator==(const Fingerprint& other) const noexcept {
+        return lo == other.lo && hi == other.hi;
+    }
+};
+
+class StatementTable;
+using StatementTablePtr = SharedPtr<StatementTable>;
+
+/// @brief Statement interning (hash-consing) table. Every World has its own.
+/// Maps a (relation ID, argument IDs) tuple into a stable `StatementId` and
+/// keeps the canonical `Statement` object of every ID. A statement can be
+/// looked up directly from a pattern and the substitution arguments, without
+/// constructing the substituted statement, so the lookups never allocate.
+/// Interning allocates only when a statement is seen for the first time.
+/// Concurrent lookups are safe as long as nothing is being interned.
+class StatementTable {
+    /// @brief `_statements[id]` is the canonical statement with the given ID.
+    StatementVec _statements;
+
+    /// @brief `_hashes[id]` is the hash value of the statement `id`.
+    Vector<std::size_t> _hashes;
+
+    /// @brief Open-addressing hash table of the statement IDs. The number of
+    ///        slots is always a power of two. Empty slots contain
+    ///        `INVALID_STATEMENT_ID`.
+    StatementIdVec _slots;
+
+    /// @brief `_keys[id]` is the Zobrist key of the statement `id`.
+    Vector<Fingerprint> _keys;
+
+    /// @brief The state of the key generator (SplitMix64). The generator 
+    ///        has a fixed seed, so the keys are the same in every run.
+    std::uint64_t _keySeed;
+
+    /// @brief Returns the next pseudo-random 64-bit key.
+    std::uint64_t nextKey() noexcept;
+
+    /// @brief Doubles the number of slots and reinserts all the IDs.
+    void grow() noexcept;
+
+    /// @brief Inserts an existing ID into the slots.
+    void insertSlot(const StatementId id) noexcept;
+
+    /// @brief Computes the hash of the substituted pattern (see `find`).
+    static std::size_t computeHash(
+            const StatementPtr& pattern,
+            const ObjectVec& arguments) noexcept;
+
+    /// @brief Checks if statement `id` is the substituted pattern.
+    bool isEqual(
+            const StatementId id,
+            const StatementPtr& pattern,
+            const ObjectVec& arguments) const noexcept;
+
+public:
+    StatementTable() noexcept;
+
+    /// @brief Returns the ID of a statement, or `INVALID_STATEMENT_ID` if the
+    ///        statement was never interned.
+    /// @param statement A statement with real objects as arguments.
+    StatementId find(const StatementPtr& statement) const noexcept;
+
+    /// @brief Returns the ID of the statement obtained from the pattern by the
+    ///        substitution (see `Statement::substitute()`), or
+    ///        `INVALID_STATEMENT_ID` if it was never interned.
+    /// @param pattern A statement with variables (negative IDs).
+    /// @param arguments Arguments for the substitution.
+    StatementId find(
+            const StatementPtr& pattern,
+            const ObjectVec& arguments) const noexcept;
+
+    /// @brief Returns the ID of a statement. Adds it into the table if needed.
+    /// @param statement A statement with real objects as arguments.
+    StatementId intern(const StatementPtr& statement) noexcept;
+
+    /// @brief Returns the ID of the substituted pattern (see `find`). Adds
+    ///        the substituted statement into the table if needed.
+    /// @param pattern A statement with variables (negative IDs).
+    /// @param arguments Arguments for the substitution.
+    StatementId intern(
+            const StatementPtr& pattern,
+            const ObjectVec& arguments) noexcept;
+
+    /// @brief Returns the canonical statement with the given ID.
+    const StatementPtr& getStatement(const StatementId id) const noexcept;
+
+    /// @brief Returns the random Zobrist key of the statement with the 
+    ///        given ID (see `Fingerprint`).
+    const Fingerprint& getKey(const StatementId id) const noexcept;
+
+    /// @brief Returns the number of interned statements.
+    SIZE_T size() const noexcept;
+};
+
+}
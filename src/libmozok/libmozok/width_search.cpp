@@ -0,0 +1,320 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#include <libmozok/width_search.hpp>
+#include <libmozok/quest_planner.hpp>
+#include <libmozok/search_node.hpp>
+#include <libmozok/novelty_table.hpp>
+
+namespace mozok {
+
+namespace {
+
+/// @brief Collects the statements that the possible action adds to the 
+///        state, and that are not in the state yet.
+void collectNewStatements(
+        const Quest& quest,
+        const BitState& state,
+        const SIZE_T actionIndx,
+        Vector<int>& newStatements
+        ) noexcept {
+    newStatements.clear();
+    for(const int p : quest.getActionAddList(actionIndx))
+        if(state.hasBit(SIZE_T(p)) == false)
+            newStatements.push_back(p);
+}
+
+/// @brief Returns the number of the goal statements that are not in the 
+///        state.
+int countMissedGoals(
+        const BitState& state, 
+        const BitState& goalMask
+        ) noexcept {
+    int missedGoals = 0;
+    BitState::forEachBit(
+            goalMask.getWords(), goalMask.getWordCount(), 
+            [&](const SIZE_T p) {
+        if(state.hasBit(p) == false)
+            ++missedGoals;
+    });
+    return missedGoals;
+}
+
+} // namespace
+
+ApplicableActionsCollector::ApplicableActionsCollector(
+        Vector<int>& actions) noexcept :
+    _actions(actions)
+{ /* empty */ }
+
+bool ApplicableActionsCollector::possibleActionCallback(
+        const SIZE_T possibleActionIndx) noexcept {
+    _actions.push_back(int(possibleActionIndx));
+    return true;
+}
+
+bool WidthOpenNodeCmp::operator() (
+        const WidthOpenNode& a, const WidthOpenNode& b) const noexcept {
+    if(a.novelty != b.novelty)
+        return a.novelty > b.novelty;
+    if(a.missedGoals != b.missedGoals)
+        return a.missedGoals > b.missedGoals;
+    return a.nodeIndx > b.nodeIndx;
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_IW(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const BitState& goalMask = quest.getGoalMask(SIZE_T(goalIndx));
+
+    Vector<int> actions;
+    Vector<int> newStatements;
+    int searchStep = 0;
+
+    // IW(1), and then IW(2).
+    for(int width = 1; width <= 2; ++width) {
+        NoveltyTable novelty(quest.getStatementCount(), width);
+        if(novelty.getWidth() < width)
+            // Too many statements for the table of the pairs.
+            break;
+        newStatements.clear();
+        BitState::forEachBit(
+                _givenBitState->getWords(), _givenBitState->getWordCount(), 
+                [&](const SIZE_T p) {
+            newStatements.push_back(int(p));
+        });
+        novelty.update(*_givenBitState, newStatements);
+
+        // The nodes are expanded in the order of their indices, so the 
+        // search is breadth-first. Only the novel states are kept.
+        SearchArena arena;
+        arena.add({_givenBitState, NO_NODE, -1, 0, 0, -1});
+        KnownStates knownStates(settings.fingerprintOnly);
+        knownStates.insert(_givenBitState, true);
+        NodeRef finalNode = NO_NODE;
+        bool isPruned = false;
+
+        for(SIZE_T nodeIndx = 0; 
+                finalNode == NO_NODE && nodeIndx < arena.size(); 
+                ++nodeIndx) {
+            if(cancelFlag != nullptr && cancelFlag->isCancelled())
+                // The result of this search is no longer needed.
+                return makeShared<QuestPlan>(
+                        _givenSubstateId, _givenState, _quest->getQuest(), 
+                        goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+
+            ++searchStep;
+            const bool isSearchLimitReached = 
+                    searchStep > settings.searchLimit;
+            const bool isSpaceLimitReached = 
+                    int(arena.size() - nodeIndx) > settings.spaceLimit;
+            const bool isTimeLimitReached = _deadline.isReached(searchStep);
+            if(isSearchLimitReached || isSpaceLimitReached 
+                    || isTimeLimitReached) {
+                if(isSearchLimitReached)
+                    messageProcessor.onSearchLimitReached(
+                        worldName, _quest->getQuest()->getName(), 
+                        settings.searchLimit);
+                if(isSpaceLimitReached)
+                    messageProcessor.onSpaceLimitReached(
+                        worldName, _quest->getQuest()->getName(), 
+                        settings.spaceLimit);
+                if(isTimeLimitReached)
+                    messageProcessor.onTimeLimitReached(
+                        worldName, _quest->getQuest()->getName(), 
+                        settings.timeLimitUs);
+                return makeShared<QuestPlan>(
+                        _givenSubstateId, _givenState, _quest->getQuest(), 
+                        goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+            }
+
+            // New nodes can grow the arena, so the state is copied.
+            const BitStatePtr state = arena[nodeIndx].state;
+            const int gScore = arena[nodeIndx].gScore + 1;
+            actions.clear();
+            ApplicableActionsCollector it(actions);
+            quest.iterateOverApplicableActions(*state, it);
+            for(const int actionIndx : actions) {
+                const BitState::Word* remMask = 
+                        quest.getActionRemMask(SIZE_T(actionIndx));
+                const BitState::Word* addMask = 
+                        quest.getActionAddMask(SIZE_T(actionIndx));
+                const Fingerprint fingerprint = state->getAppliedFingerprint(
+                        remMask, addMask, quest.getStatementKeys());
+                if(knownStates.findApplied(
+                        *state, remMask, addMask, fingerprint) != nullptr)
+                    continue;
+                BitStatePtr newState = makeShared<BitState>(*state);
+                newState->apply(remMask, addMask, quest.getStatementKeys());
+                collectNewStatements(
+                        quest, *state, SIZE_T(actionIndx), newStatements);
+                const bool isGoal = newState->hasSubstate(goalMask);
+                if(novelty.update(*newState, newStatements) > width 
+                        && isGoal == false) {
+                    isPruned = true;
+                    continue;
+                }
+                knownStates.insert(newState, true);
+                const SIZE_T newNodeIndx = arena.add({
+                        newState, makeNodeRef(0, nodeIndx), actionIndx, 
+                        gScore, gScore, -1});
+                if(isGoal) {
+                    finalNode = makeNodeRef(0, newNodeIndx);
+                    break;
+                }
+            }
+        }
+
+        if(finalNode != NO_NODE) {
+            const Vector<int> actionIndices = buildPlan({&arena}, finalNode);
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_REACHABLE, 
+                    makePlanActions(quest, actionIndices), actionIndices);
+        }
+        if(isPruned == false)
+            // No state was pruned, so all the reachable states were visited.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+    }
+
+    // The goal needs a larger width. The best-first width search doesn't 
+    // prune the states, and starts over from the given state, with the same 
+    // limits.
+    QuestSettings bfwsSettings = settings;
+    bfwsSettings.strategy = QuestSearchStrategy::BFWS;
+    return findGoalPlan_BFWS(
+            goalIndx, worldName, messageProcessor, bfwsSettings, cancelFlag);
+}
+
+QuestPlanPtr QuestPlanner::findGoalPlan_BFWS(
+        const ID goalIndx,
+        const Str& worldName,
+        MessageProcessor& messageProcessor,
+        const QuestSettings& settings,
+        const SearchCancelFlag* cancelFlag
+        ) const noexcept {
+    const Quest& quest = *_quest->getQuest();
+    const BitState& goalMask = quest.getGoalMask(SIZE_T(goalIndx));
+
+    // `novelties[g]` is the novelty table of the states that miss `g` goal 
+    // statements. The tables are created when they are needed.
+    const int goalCount = 
+            countMissedGoals(BitState(quest.getStatementCount()), goalMask);
+    const int initialMissedGoals = countMissedGoals(*_givenBitState, goalMask);
+    Vector<UniquePtr<NoveltyTable>> novelties(SIZE_T(goalCount + 1));
+    Vector<int> newStatements;
+    const auto updateNovelty = [&](
+            const BitState& state, const int missedGoals) {
+        UniquePtr<NoveltyTable>& table = novelties[SIZE_T(missedGoals)];
+        if(table == nullptr)
+            table = makeUnique<NoveltyTable>(quest.getStatementCount(), 2);
+        return table->update(state, newStatements);
+    };
+
+    SearchArena arena;
+    arena.add({_givenBitState, NO_NODE, -1, 0, 0, -1});
+    KnownStates knownStates(settings.fingerprintOnly);
+    knownStates.insert(_givenBitState, true);
+    BitState::forEachBit(
+            _givenBitState->getWords(), _givenBitState->getWordCount(), 
+            [&](const SIZE_T p) {
+        newStatements.push_back(int(p));
+    });
+    PriorityQueue<WidthOpenNode, WidthOpenNodeCmp> openSet;
+    openSet.push({
+            updateNovelty(*_givenBitState, initialMissedGoals), 
+            initialMissedGoals, 0});
+
+    Vector<int> actions;
+    NodeRef finalNode = NO_NODE;
+    int searchStep = 0;
+
+    while(finalNode == NO_NODE && openSet.empty() == false) {
+        if(cancelFlag != nullptr && cancelFlag->isCancelled())
+            // The result of this search is no longer needed.
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                    MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+
+        ++searchStep;
+        const bool isSearchLimitReached = 
+                searchStep > settings.searchLimit;
+        const bool isSpaceLimitReached = 
+                int(openSet.size()) > settings.spaceLimit;
+        const bool isTimeLimitReached = _deadline.isReached(searchStep);
+        if(isSearchLimitReached || isSpaceLimitReached 
+                || isTimeLimitReached) {
+            if(isSearchLimitReached)
+                messageProcessor.onSearchLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.searchLimit);
+            if(isSpaceLimitReached)
+                messageProcessor.onSpaceLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.spaceLimit);
+            if(isTimeLimitReached)
+                messageProcessor.onTimeLimitReached(
+                    worldName, _quest->getQuest()->getName(), 
+                    settings.timeLimitUs);
+            return makeShared<QuestPlan>(
+                    _givenSubstateId, _givenState, _quest->getQuest(), 
+                    goalIndx, MOZOK_QUEST_STATUS_UNKNOWN, ActionVec());
+        }
+
+        const SIZE_T nodeIndx = openSet.top().nodeIndx;
+        openSet.pop();
+        // New nodes can grow the arena, so the state is copied.
+        const BitStatePtr state = arena[nodeIndx].state;
+        const int gScore = arena[nodeIndx].gScore + 1;
+        actions.clear();
+        ApplicableActionsCollector it(actions);
+        quest.iterateOverApplicableActions(*state, it);
+        for(const int actionIndx : actions) {
+            const BitState::Word* remMask = 
+                    quest.getActionRemMask(SIZE_T(actionIndx));
+            const BitState::Word* addMask = 
+                    quest.getActionAddMask(SIZE_T(actionIndx));
+            const Fingerprint fingerprint = state->getAppliedFingerprint(
+                    remMask, addMask, quest.getStatementKeys());
+            if(knownStates.findApplied(
+                    *state, remMask, addMask, fingerprint) != nullptr)
+                continue;
+            BitStatePtr newState = makeShared<BitState>(*state);
+            newState->apply(remMask, addMask, quest.getStatementKeys());
+            knownStates.insert(newState, true);
+            const SIZE_T newNodeIndx = arena.add({
+                    newState, makeNodeRef(0, nodeIndx), actionIndx, 
+                    gScore, gScore, -1});
+            if(newState->hasSubstate(goalMask)) {
+                finalNode = makeNodeRef(0, newNodeIndx);
+                break;
+            }
+            collectNewStatements(
+                    quest, *state, SIZE_T(actionIndx), newStatements);
+            const int missedGoals = countMissedGoals(*newState, goalMask);
+            openSet.push({
+                    updateNovelty(*newState, missedGoals), missedGoals, 
+                    newNodeIndx});
+        }
+    }
+
+    if(finalNode == NO_NODE)
+        // All the reachable states were visited.
+        return makeShared<QuestPlan>(
+                _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+                MOZOK_QUEST_STATUS_UNREACHABLE, ActionVec());
+
+    const Vector<int> actionIndices = buildPlan({&arena}, finalNode);
+    return makeShared<QuestPlan>(
+            _givenSubstateId, _givenState, _quest->getQuest(), goalIndx, 
+            MOZOK_QUEST_STATUS_REACHABLE, 
+            makePlanActions(quest, actionIndices), actionIndices);
+}
+
+}
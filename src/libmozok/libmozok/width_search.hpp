@@ -0,0 +1,41 @@
+// Copyright 2025 Pavlo Savchuk. Subject to the MIT license.
+
+#pragma once
+
+#include <libmozok/public_types.hpp>
+#include <libmozok/private_types.hpp>
+
+#include <libmozok/quest.hpp>
+
+namespace mozok {
+
+/// @brief A callback class for the `Quest::iterateOverApplicableActions(...)`.
+/// Collects the indices of the applicable possible actions.
+class ApplicableActionsCollector : public QuestPossibleActionsIterator {
+    Vector<int>& _actions;
+
+public:
+    ApplicableActionsCollector(Vector<int>& actions) noexcept;
+
+    bool possibleActionCallback(const SIZE_T possibleActionIndx) noexcept;
+};
+
+/// @brief An open list entry of the `BFWS` search.
+struct WidthOpenNode {
+    /// @brief The novelty of the node (see `NoveltyTable`).
+    int novelty;
+
+    /// @brief The number of the goal statements that are not in the state.
+    int missedGoals;
+
+    SIZE_T nodeIndx;
+};
+
+/// @brief Orders the `BFWS` open list by the novelty, then by the number of 
+///        the missed goal statements, then by the order of the generation.
+struct WidthOpenNodeCmp {
+    bool operator() (
+            const WidthOpenNode& a, const WidthOpenNode& b) const noexcept;
+};
+
+}
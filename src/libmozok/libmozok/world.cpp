@@ -24,7 +24,8 @@ World::World(const Str& serverName, const Str& worldName) noexcept :
         _serverName(serverName), 
         _worldName(worldName), 
         _serverWorldName(_serverName + ":" + _worldName),
-        _state(makeShared<State>(StatementVec())),
+        _statementTable(makeShared<StatementTable>()),
+        _state(makeShared<State>(_statementTable, StatementVec())),
         _stateId(ID(0))
 { /* empty */ }
 
@@ -76,7 +77,8 @@ Str World::generateSaveFile() noexcept {
     res << "    add # Current State:" << std::endl;
     // Add the offset to lineup the statements for readability.
     res << "        ";
-    for(const StatementPtr& st : stateCopy->getStatementSet()) {
+    stateCopy->forEachStatementId([&](const StatementId id) {
+        const StatementPtr& st = _statementTable->getStatement(id);
         res << st->getRelation()->getName() << "(";
         for(ObjectVec::size_type i=0; i<st->getArguments().size(); ++i) {
             res << st->getArguments()[i]->getName();
@@ -86,7 +88,7 @@ Str World::generateSaveFile() noexcept {
         res << ")" << std::endl;
         // Add the offset to lineup the statements for readability.
         res << "        ";
-    }
+    });
     return res.str();
 }
 
@@ -870,7 +872,7 @@ Result World::addQuest(
     _questNameToId[questName] = newQuestId;
     QuestPtr newQuest = makeShared<Quest>(
             questName, newQuestId, pre, goalVec, 
-            actions, objects, subquests, useActionTree);
+            actions, objects, subquests, useActionTree, _statementTable);
     QuestManagerPtr newQuestManager = makeShared<QuestManager>(newQuest);
     _quests.push_back(newQuestManager);
 
@@ -919,11 +921,22 @@ Result World::setQuestOption(
     return Result::OK();
 }
 
+Result World::setQuestOption(
+        const Str& questName, 
+        const Str& optionName,
+        const Str& optionValue
+        ) noexcept {
+    if(hasMainQuest(questName) == false && hasSubquest(questName) == false)
+        return errorUndefinedQuest(_serverWorldName, questName);
+    return setQuestOptionFromSRC(this, questName, optionName, optionValue);
+}
+
 
 // ================================ PLANNING ================================ //
 
 void World::performPlanning(
-        MessageProcessor& messageProcessor
+        MessageProcessor& messageProcessor,
+        const int serverTimeLimitUs
         ) noexcept {
     for(QuestManagerVec* questSet : {&_mainQuests, &_subquests})
         for(QuestManagerPtr& questManager : (*questSet)) {
@@ -931,16 +944,21 @@ void World::performPlanning(
                 continue;
             if(questManager->getStatus() == MOZOK_QUEST_STATUS_DONE)
                 continue;
+            // The anytime search keeps improving the plan of the current 
+            // substate.
             if(questManager->getLastSubstateId() 
-                    == questManager->getCurrentSubstateId())
+                    == questManager->getCurrentSubstateId()
+                    && questManager->hasAnytimeSearch() == false)
                 continue;
-            performQuestPlanning(questManager, messageProcessor);
+            performQuestPlanning(
+                    questManager, messageProcessor, serverTimeLimitUs);
         }
 }
 
 void World::performQuestPlanning(
         QuestManagerPtr& questManager,
-        MessageProcessor& messageProcessor
+        MessageProcessor& messageProcessor,
+        const int serverTimeLimitUs
         ) noexcept {
     // Create a duplicate substate with relevant statements only.
     StatePtr planningState = _state->duplicate(*questManager->getQuest());
@@ -948,15 +966,16 @@ void World::performQuestPlanning(
 
     bool newPlan = QuestManager::performPlanning(
             _worldName, planningSubstateID, planningState, 
-            questManager, messageProcessor);
+            questManager, messageProcessor, serverTimeLimitUs);
 
     if(newPlan)
-        findNewSubquest(questManager, messageProcessor);
+        findNewSubquest(questManager, messageProcessor, serverTimeLimitUs);
 }
 
 void World::findNewSubquest(
         QuestManagerPtr& questManager,
-        MessageProcessor& messageProcessor
+        MessageProcessor& messageProcessor,
+        const int serverTimeLimitUs
         ) noexcept {
     const QuestPlanPtr& plan = questManager->getLastPlan();
     const QuestPtr& quest = questManager->getQuest();
@@ -993,7 +1012,8 @@ void World::findNewSubquest(
                     quest->getName(),
                     plan->goalIndx);
                 // Perform planning for the new subquest.
-                performQuestPlanning(subquestManager, messageProcessor);
+                performQuestPlanning(
+                        subquestManager, messageProcessor, serverTimeLimitUs);
                 break;
             }
             //++goalIndx;
@@ -15,6 +15,7 @@
 #include <libmozok/quest.hpp>
 
 #include <libmozok/state.hpp>
+#include <libmozok/statement_table.hpp>
 #include <libmozok/quest_manager.hpp>
 
 namespace mozok {
@@ -39,6 +40,10 @@ class World {
     /// @brief Combined `ServerName:WorldName` string.
     const Str _serverWorldName;
 
+    /// @brief Interned statements of the world (see `StatementTable`).
+    /// Shared by the world's state and quests.
+    const StatementTablePtr _statementTable;
+
     /// @brief The state of the world.
     StatePtr _state;
 
@@ -451,6 +456,16 @@ public:
             const int value
             ) noexcept;
 
+    /// @brief Sets a quest option given by its name. See 
+    ///        Server::setQuestOption() for more details.
+    /// @see Server::setQuestOption()
+    /// @return Returns the status of the operation.
+    Result setQuestOption(
+            const Str& questName, 
+            const Str& optionName, 
+            const Str& optionValue
+            ) noexcept;
+
 private:
 
     /// @brief Activates currently inactive main quest.
@@ -462,14 +477,18 @@ private:
     /// @param questManager A quest with a new plan.
     /// @param messageProcessor A message processor that will receive 
     ///         `onNewSubquest()` message.
+    /// @param serverTimeLimitUs The time limit of the server (see 
+    ///         `performPlanning()`).
     void findNewSubquest(
                 QuestManagerPtr& questManager,
-                MessageProcessor& messageProcessor
+                MessageProcessor& messageProcessor,
+                const int serverTimeLimitUs
                 ) noexcept;
 
     void performQuestPlanning(
                 QuestManagerPtr& questManager,
-                MessageProcessor& messageProcessor
+                MessageProcessor& messageProcessor,
+                const int serverTimeLimitUs
                 ) noexcept;
 public:
 
@@ -477,8 +496,11 @@ public:
 
     /// @brief Performs planning for all active quests.
     /// @param messageProcessor A message processor.
+    /// @param serverTimeLimitUs The time limit of the quests without the 
+    ///        `timeLimitUs` option (`0` means no limit).
     void performPlanning(
-            MessageProcessor& messageProcessor
+            MessageProcessor& messageProcessor,
+            const int serverTimeLimitUs
             ) noexcept;
 
 
@@ -4,6 +4,8 @@
 // file. The puzzle's .quest file must contain only one main quest without 
 // subquests. If the given .quest file contains no errors and the puzzle has 
 // been solved, the puzzle solver will output MOZOK_OK at the end.
+// Optionally, the options of the main quest can be changed before planning, 
+// so the same puzzle can be solved with different strategies and heuristics.
 
 #include <iostream>
 #include <chrono>
@@ -92,8 +94,8 @@ int main(int argc, char **argv) {
 
     // Read the arguments.
     if(argc < 3) {
-        cout << "Expecting: > puzzle_solver [puzzle_name] [init_action]" 
-             << endl;
+        cout << "Expecting: > puzzle_solver [puzzle_name] [init_action] "
+             << "[main_quest_name option=value ...]" << endl;
         return 0;
     }
     const Str puzzle_name = argv[1];
@@ -107,6 +109,15 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    // Change the main quest options.
+    for(int i = 4; i < argc; ++i)
+        status <<= setQuestOptionFromArg(server, puzzle_name, argv[3], argv[i]);
+
+    if(status.isError()) {
+        cout << status.getDescription() << endl;
+        return 0;
+    }
+
     // Initialize the puzzle.
     // Puzzle project must contain Init() action.
     ActionError actionError;
@@ -131,6 +142,7 @@ int main(int argc, char **argv) {
     // Solve the puzzle by applying the plan actions.
     const auto* puzzleActions = &(msgProcessor.getPuzzleActions());
     const auto* puzzleArgs = &(msgProcessor.getPuzzleActionArguments());
+    const auto planLength = puzzleActions->size();
     for(StrVec::size_type i = 0; i < puzzleActions->size(); ++i) {
         const Str& actionName = puzzleActions->at(i);
         const StrVec& arguments = puzzleArgs->at(i);
@@ -171,6 +183,8 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    // The plan length is printed to compare the strategies.
+    cout << "Plan length = " << planLength << endl;
     cout << "MOZOK_OK" << endl;
 
     return 0;
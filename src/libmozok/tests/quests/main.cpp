@@ -285,7 +285,8 @@ int main(int argc, char **argv) {
 
     // Read the arguments.
     if(argc < 3) {
-        cout << "Expecting: > quest_solver [quest_name] [init_action]" << endl;
+        cout << "Expecting: > quest_solver [quest_name] [init_action] "
+             << "[quest_name option=value ...]" << endl;
         return 0;
     }
     const Str quest_name = argv[1];
@@ -302,6 +303,15 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    // Change the quest options.
+    for(int i = 4; i < argc; ++i)
+        status <<= setQuestOptionFromArg(server, quest_name, argv[3], argv[i]);
+
+    if(status.isError()) {
+        cout << status.getDescription() << endl;
+        return 0;
+    }
+
     // Start the worker thread and push the `Init` action.
     ActionError actionError = MOZOK_AE_NO_ERROR;
     status <<= server->startWorkerThread();
@@ -90,6 +90,63 @@ void DebugMessageProcessor::onSearchLimitReached(
          << " reached for `" << questName << "`" << endl;
 }
 
+void DebugMessageProcessor::onPortfolioWinner(
+        const mozok::Str&,
+        const mozok::Str& questName,
+        const mozok::Str& heuristic,
+        const mozok::Str& strategy
+        ) noexcept {
+    cout << "> Portfolio winner for `" << questName << "`: " 
+         << heuristic << " " << strategy << endl;
+}
+
+void DebugMessageProcessor::onLandmarksFound(
+        const mozok::Str&,
+        const mozok::Str& questName,
+        const int goalIndx,
+        const int landmarkCount
+        ) noexcept {
+    cout << "> Landmarks found for `" << questName << "` goal " << goalIndx 
+         << ": " << landmarkCount << endl;
+}
+
+void DebugMessageProcessor::onPatternDatabaseBuilt(
+        const mozok::Str&,
+        const mozok::Str& questName,
+        const int goalIndx,
+        const int patternCount,
+        const int memory,
+        const int buildTimeUs,
+        const int lookupTimeNs
+        ) noexcept {
+    cout << "> Pattern database built for `" << questName << "` goal " 
+         << goalIndx << ": " << patternCount << " patterns, " 
+         << memory << " bytes, " << buildTimeUs << " us, " 
+         << lookupTimeNs << " ns per lookup" << endl;
+}
+
+void DebugMessageProcessor::onHeuristicCacheStats(
+        const mozok::Str&,
+        const mozok::Str& questName,
+        const int hits,
+        const int misses
+        ) noexcept {
+    cout << "> Heuristic cache of `" << questName << "`: " << hits 
+         << " hits, " << misses << " misses" << endl;
+}
+
+void DebugMessageProcessor::onPlanRepairStats(
+        const mozok::Str&,
+        const mozok::Str& questName,
+        const int reused,
+        const int repaired,
+        const int searched
+        ) noexcept {
+    cout << "> Plan repair of `" << questName << "`: " << reused 
+         << " reused, " << repaired << " repaired, " << searched 
+         << " searched" << endl;
+}
+
 void DebugMessageProcessor::onSpaceLimitReached(
         const mozok::Str&,
         const mozok::Str& questName,
@@ -99,6 +156,15 @@ void DebugMessageProcessor::onSpaceLimitReached(
          << " reached for `" << questName << "`" << endl;
 }
 
+void DebugMessageProcessor::onTimeLimitReached(
+        const mozok::Str&,
+        const mozok::Str& questName,
+        const int timeLimitValue
+        ) noexcept {
+    cout << "> Time limit " << timeLimitValue 
+         << " us reached for `" << questName << "`" << endl;
+}
+
 
 unique_ptr<Server> createServerFromFile(
         const Str& serverName,
@@ -129,3 +195,18 @@ unique_ptr<Server> createServerFromFile(
     out <<= server->addProject(worldName, fileName, project_sstream.str());
     return server;
 }
+
+Result setQuestOptionFromArg(
+        unique_ptr<Server>& server,
+        const Str& worldName,
+        const Str& questName,
+        const Str& arg) {
+    const Str::size_type separator = arg.find('=');
+    const Str optionName = arg.substr(0, separator);
+    const Str optionValue = 
+            separator == Str::npos ? "" : arg.substr(separator + 1);
+    cout << "Option of " << questName << ": " << optionName << " " 
+         << optionValue << endl;
+    return server->setQuestOption(
+            worldName, questName, optionName, optionValue);
+}
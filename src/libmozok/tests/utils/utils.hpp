@@ -53,6 +53,45 @@ public:
             const mozok::Str& questName,
             const int spaceLimitValue
             ) noexcept override;
+    void onTimeLimitReached(
+            const mozok::Str&,
+            const mozok::Str& questName,
+            const int timeLimitValue
+            ) noexcept override;
+    void onPortfolioWinner(
+            const mozok::Str&,
+            const mozok::Str& questName,
+            const mozok::Str& heuristic,
+            const mozok::Str& strategy
+            ) noexcept override;
+    void onLandmarksFound(
+            const mozok::Str&,
+            const mozok::Str& questName,
+            const int goalIndx,
+            const int landmarkCount
+            ) noexcept override;
+    void onPatternDatabaseBuilt(
+            const mozok::Str&,
+            const mozok::Str& questName,
+            const int goalIndx,
+            const int patternCount,
+            const int memory,
+            const int buildTimeUs,
+            const int lookupTimeNs
+            ) noexcept override;
+    void onHeuristicCacheStats(
+            const mozok::Str&,
+            const mozok::Str& questName,
+            const int hits,
+            const int misses
+            ) noexcept override;
+    void onPlanRepairStats(
+            const mozok::Str&,
+            const mozok::Str& questName,
+            const int reused,
+            const int repaired,
+            const int searched
+            ) noexcept override;
 };
 }
 
@@ -68,3 +107,16 @@ std::unique_ptr<mozok::Server> createServerFromFile(
         const mozok::Str& worldName,
         const mozok::Str& fileName,
         mozok::Result& out);
+
+/// @brief Sets a quest option given as a command line argument.
+/// @param server The quest server.
+/// @param worldName World name.
+/// @param questName The name of the quest.
+/// @param arg The option as `name=value` (for example `strategy=BEAM`), or 
+///        as `name` for the options without a value.
+/// @return Returns the status of the operation.
+mozok::Result setQuestOptionFromArg(
+        std::unique_ptr<mozok::Server>& server,
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const mozok::Str& arg);
@@ -537,6 +537,100 @@ void App::onSpaceLimitReached(
             _onSpaceLimitReached, worldName, questName);
 }
 
+void App::onTimeLimitReached(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int limitValue
+        ) noexcept {
+    infoMsg("EVENT: onTimeLimitReached [" + worldName + "] " + questName);
+    recordEvent(
+            "onTimeLimitReached", worldName, 
+            {questName, std::to_string(limitValue)});
+    _status <<= onEvent(
+            _onTimeLimitReached, worldName, questName);
+}
+
+void App::onPortfolioWinner(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const mozok::Str& heuristic,
+        const mozok::Str& strategy
+        ) noexcept {
+    infoMsg("EVENT: onPortfolioWinner [" + worldName + "] " + questName 
+            + " " + heuristic + " " + strategy);
+    recordEvent(
+            "onPortfolioWinner", worldName, 
+            {questName, heuristic, strategy});
+}
+
+void App::onLandmarksFound(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int goalIndx,
+        const int landmarkCount
+        ) noexcept {
+    infoMsg("EVENT: onLandmarksFound [" + worldName + "] " + questName 
+            + " " + std::to_string(goalIndx) 
+            + " " + std::to_string(landmarkCount));
+    recordEvent(
+            "onLandmarksFound", worldName, 
+            {questName, std::to_string(goalIndx), 
+            std::to_string(landmarkCount)});
+}
+
+void App::onPatternDatabaseBuilt(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int goalIndx,
+        const int patternCount,
+        const int memory,
+        const int buildTimeUs,
+        const int lookupTimeNs
+        ) noexcept {
+    infoMsg("EVENT: onPatternDatabaseBuilt [" + worldName + "] " + questName 
+            + " " + std::to_string(goalIndx) 
+            + " " + std::to_string(patternCount) 
+            + " " + std::to_string(memory) 
+            + " " + std::to_string(buildTimeUs) 
+            + " " + std::to_string(lookupTimeNs));
+    recordEvent(
+            "onPatternDatabaseBuilt", worldName, 
+            {questName, std::to_string(goalIndx), 
+            std::to_string(patternCount), std::to_string(memory), 
+            std::to_string(buildTimeUs), std::to_string(lookupTimeNs)});
+}
+
+void App::onHeuristicCacheStats(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int hits,
+        const int misses
+        ) noexcept {
+    infoMsg("EVENT: onHeuristicCacheStats [" + worldName + "] " + questName 
+            + " " + std::to_string(hits) 
+            + " " + std::to_string(misses));
+    recordEvent(
+            "onHeuristicCacheStats", worldName, 
+            {questName, std::to_string(hits), std::to_string(misses)});
+}
+
+void App::onPlanRepairStats(
+        const mozok::Str& worldName,
+        const mozok::Str& questName,
+        const int reused,
+        const int repaired,
+        const int searched
+        ) noexcept {
+    infoMsg("EVENT: onPlanRepairStats [" + worldName + "] " + questName 
+            + " " + std::to_string(reused) 
+            + " " + std::to_string(repaired) 
+            + " " + std::to_string(searched));
+    recordEvent(
+            "onPlanRepairStats", worldName, 
+            {questName, std::to_string(reused), std::to_string(repaired), 
+            std::to_string(searched)});
+}
+
 // ----------------------------- GRAPH ------------------------------------- //
 
 namespace {
@@ -1040,6 +1134,7 @@ void App::simulateNext() noexcept {
     // Reset handler sets.
     std::map<EventHandler::Event, HandlerSet*> hmap;
     hmap[EventHandler::ON_SEARCH_LIMIT_REACHED] = &_onSearchLimitReached;
+    hmap[EventHandler::ON_TIME_LIMIT_REACHED] = &_onTimeLimitReached;
     hmap[EventHandler::ON_NEW_MAIN_QUEST] = &_onNewMainQuest;
     hmap[EventHandler::ON_NEW_MAIN_QUEST] = &_onNewMainQuest;
     hmap[EventHandler::ON_NEW_SUBQUEST] = &_onNewSubQuest;
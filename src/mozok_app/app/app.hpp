@@ -186,6 +186,7 @@ class App : public MessageProcessor {
     EventHandlers _eventHandlers;
     HandlerSet _onSearchLimitReached;
     HandlerSet _onSpaceLimitReached;
+    HandlerSet _onTimeLimitReached;
     HandlerSet _onNewMainQuest;
     HandlerSet _onNewSubQuest;
     HandlerSet _onNewQuestStatus;
@@ -473,6 +474,51 @@ public:
             const mozok::Str& questName,
             const int searchLimitValue
             ) noexcept override;
+
+    void onTimeLimitReached(
+            const mozok::Str& worldName,
+            const mozok::Str& questName,
+            const int timeLimitValue
+            ) noexcept override;
+
+    void onPortfolioWinner(
+            const mozok::Str& worldName,
+            const mozok::Str& questName,
+            const mozok::Str& heuristic,
+            const mozok::Str& strategy
+            ) noexcept override;
+
+    void onLandmarksFound(
+            const mozok::Str& worldName,
+            const mozok::Str& questName,
+            const int goalIndx,
+            const int landmarkCount
+            ) noexcept override;
+
+    void onPatternDatabaseBuilt(
+            const mozok::Str& worldName,
+            const mozok::Str& questName,
+            const int goalIndx,
+            const int patternCount,
+            const int memory,
+            const int buildTimeUs,
+            const int lookupTimeNs
+            ) noexcept override;
+
+    void onHeuristicCacheStats(
+            const mozok::Str& worldName,
+            const mozok::Str& questName,
+            const int hits,
+            const int misses
+            ) noexcept override;
+
+    void onPlanRepairStats(
+            const mozok::Str& worldName,
+            const mozok::Str& questName,
+            const int reused,
+            const int repaired,
+            const int searched
+            ) noexcept override;
     
     /// @}
 };
@@ -72,6 +72,16 @@ EventHandler EventHandler::onSpaceLimitReached(
             {worldName, questName}, block);
 }
 
+EventHandler EventHandler::onTimeLimitReached(
+        const Str& worldName,
+        const DebugArg& questName, // can be empty
+        const DebugBlock& block
+        ) noexcept {
+    return EventHandler(
+            ON_TIME_LIMIT_REACHED, 
+            {worldName, questName}, block);
+}
+
 EventHandler EventHandler::onPre(
         const Str& worldName,
         const Str& actionName,
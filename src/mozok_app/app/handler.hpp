@@ -28,6 +28,7 @@ class EventHandler {
         ON_NEW_QUEST_STATUS,
         ON_SEARCH_LIMIT_REACHED,
         ON_SPACE_LIMIT_REACHED,
+        ON_TIME_LIMIT_REACHED,
         ON_PRE,
         ON_ACTION,
         ON_INIT
@@ -78,6 +79,12 @@ public:
             const DebugArg& questName, // can be _
             const DebugBlock& block
             ) noexcept;
+    
+    static EventHandler onTimeLimitReached(
+            const Str& worldName,
+            const DebugArg& questName, // can be _
+            const DebugBlock& block
+            ) noexcept;
 
     static EventHandler onPre(
             const Str& worldName,
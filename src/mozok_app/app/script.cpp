@@ -30,6 +30,7 @@ const Str ON_NEW_SUBQUEST = "onNewSubQuest";
 const Str ON_NEW_QUEST_STATUS = "onNewQuestStatus";
 const Str ON_SEARCH_LIMIT_REACHED = "onSearchLimitReached";
 const Str ON_SPACE_LIMIT_REACHED = "onSpaceLimitReached";
+const Str ON_TIME_LIMIT_REACHED = "onTimeLimitReached";
 const Str ON_PRE = "onPre";
 const Str ON_ACTION = "onAction";
 const Str ON_INIT = "onInit";
@@ -418,7 +419,7 @@ protected:
         return res;
     }
 
-    Result onLimitReached(const Str& worldName, bool searchLimit) noexcept {
+    Result onLimitReached(const Str& worldName, const Str& event) noexcept {
         Result res;
         res <<= space(1);
         DebugArg questName = str_arg(res);
@@ -437,14 +438,18 @@ protected:
         if(res.isError())
             return res;
 
-        if(searchLimit) {
+        if(event == ON_SEARCH_LIMIT_REACHED) {
             EventHandler handler = EventHandler::onSearchLimitReached(
                     worldName, questName, eventBlock);
             res <<= _app->addEventHandler(handler);
-        } else {
+        } else if(event == ON_SPACE_LIMIT_REACHED) {
             EventHandler handler = EventHandler::onSpaceLimitReached(
                     worldName, questName, eventBlock);
             res <<= _app->addEventHandler(handler);
+        } else {
+            EventHandler handler = EventHandler::onTimeLimitReached(
+                    worldName, questName, eventBlock);
+            res <<= _app->addEventHandler(handler);
         }
         return res;
     }
@@ -541,10 +546,10 @@ protected:
                 res <<= onNewMainQuest(worldName);
             } else if(event == ON_NEW_QUEST_STATUS) {
                 res <<= onNewQuestStatus(worldName);
-            } else if(event == ON_SEARCH_LIMIT_REACHED) {
-                res <<= onLimitReached(worldName, true);
-            } else if(event == ON_SPACE_LIMIT_REACHED) {
-                res <<= onLimitReached(worldName, false);
+            } else if(event == ON_SEARCH_LIMIT_REACHED
+                    || event == ON_SPACE_LIMIT_REACHED
+                    || event == ON_TIME_LIMIT_REACHED) {
+                res <<= onLimitReached(worldName, event);
             } else if(event == ON_INIT) {
                 res <<= onInit();
             } else if(event == ON_PRE) {